@@ -17,8 +17,10 @@
 #define QC_REPOSITORY_CCDBDATABASE_H
 
 #include <CCDB/CcdbApi.h>
+#include <mutex>
 
 #include "QualityControl/DatabaseInterface.h"
+#include "QualityControl/WorkerPool.h"
 
 namespace o2::quality_control::repository
 {
@@ -72,6 +74,18 @@ class CcdbDatabase : public DatabaseInterface
   std::string retrieveJson(std::string path, long timestamp, const std::map<std::string, std::string>& metadata) override;
   TObject* retrieveTObject(std::string path, const std::map<std::string, std::string>& metadata, long timestamp = -1, std::map<std::string, std::string>* headers = nullptr) override;
 
+  // batch and asynchronous requests, executed by at most maxConcurrentRequests threads, each with its own CcdbApi
+  void storeMOs(const std::vector<std::shared_ptr<o2::quality_control::core::MonitorObject>>& mos) override;
+  void storeQOs(const std::vector<std::shared_ptr<o2::quality_control::core::QualityObject>>& qos) override;
+  std::future<void> storeMOAsync(std::shared_ptr<o2::quality_control::core::MonitorObject> mo) override;
+  std::future<void> storeQOAsync(std::shared_ptr<o2::quality_control::core::QualityObject> qo) override;
+  std::vector<std::shared_ptr<o2::quality_control::core::MonitorObject>> retrieveMOs(const std::vector<std::pair<std::string, std::string>>& taskAndObjectNames, long timestamp = -1) override;
+  std::vector<std::shared_ptr<o2::quality_control::core::QualityObject>> retrieveQOs(const std::vector<std::string>& qoPaths, long timestamp = -1) override;
+  std::vector<TObject*> retrieveTObjects(const std::vector<std::string>& paths, const std::map<std::string, std::string>& metadata, long timestamp = -1) override;
+  std::future<std::shared_ptr<o2::quality_control::core::MonitorObject>> retrieveMOAsync(std::string taskName, std::string objectName, long timestamp = -1) override;
+  std::future<std::shared_ptr<o2::quality_control::core::QualityObject>> retrieveQOAsync(std::string qoPath, long timestamp = -1) override;
+  std::future<TObject*> retrieveTObjectAsync(std::string path, const std::map<std::string, std::string>& metadata, long timestamp = -1) override;
+
   void disconnect() override;
   void prepareTaskDataContainer(std::string taskName) override;
   std::vector<std::string> getPublishedObjectNames(std::string taskName) override;
@@ -103,8 +117,27 @@ class CcdbDatabase : public DatabaseInterface
    * @return The listing of folder and/or objects in the format requested and as returned by the http server.
    */
   std::string getListingAsString(std::string subpath = "", std::string accept = "text/plain");
+
+  /// The CcdbApi to use in the current thread: the one of the request if it is executed by a request thread.
+  o2::ccdb::CcdbApi& api();
+  /// Gives a free CcdbApi to the current request thread, until the returned pointer is released.
+  std::shared_ptr<o2::ccdb::CcdbApi> acquireRequestApi();
+  /// Executes the request in a request thread, which are created the first time.
+  template <typename Request>
+  auto submitRequest(Request request) -> std::future<decltype(request())>;
+  /// Executes the function on each request concurrently and returns the results in the order of the requests.
+  template <typename Result, typename Request, typename Function>
+  std::vector<Result> runConcurrently(const std::vector<Request>& requests, Function function);
+
   o2::ccdb::CcdbApi ccdbApi;
   std::string mUrl = "";
+  size_t mMaxConcurrentRequests = 8; ///< maximum number of requests of a batch in flight at the same time
+
+  // CcdbApi is not thread-safe, each request thread uses its own
+  std::mutex mRequestMutex;
+  std::vector<std::unique_ptr<o2::ccdb::CcdbApi>> mRequestApis;
+  std::vector<o2::ccdb::CcdbApi*> mFreeRequestApis;
+  std::unique_ptr<core::WorkerPool> mRequestWorkers; // destroyed first, its queued requests use the CcdbApi above
 };
 
 } // namespace o2::quality_control::repository
@@ -17,6 +17,8 @@
 #include <vector>
 #include <memory>
 #include <unordered_map>
+// boost
+#include <boost/dynamic_bitset.hpp>
 // O2
 #include <Framework/DataProcessorSpec.h>
 // QC
@@ -26,6 +28,7 @@
 #include "QualityControl/CheckInterface.h"
 #include "QualityControl/QcInfoLogger.h"
 #include "QualityControl/CheckConfig.h"
+#include "QualityControl/ObjectRegistry.h"
 
 namespace o2::quality_control::checker
 {
@@ -58,6 +61,42 @@ class Check
 
   std::shared_ptr<o2::quality_control::core::QualityObject> check(std::map<std::string, std::shared_ptr<o2::quality_control::core::MonitorObject>>& moMap);
 
+  /**
+   * \brief Register the Monitor Objects of the check in the registry.
+   *
+   * Needed before using `isReady(registry)` and `check(registry)`, which then access the objects by ID.
+   */
+  void bind(ObjectRegistry& registry);
+
+  /**
+   * \brief Run the check on the objects of the registry.
+   *
+   * The check gets a map, which is kept between the calls and only updated, instead of a copy.
+   * It is the same as `prepare(registry)` followed by `run()`.
+   */
+  std::shared_ptr<o2::quality_control::core::QualityObject> check(ObjectRegistry& registry);
+
+  /**
+   * \brief Update the map of objects given to the check with the latest objects of the registry.
+   *
+   * After that, the check does not access the registry anymore, so that `run()` can be called in another thread while
+   * the registry receives new objects.
+   */
+  void prepare(ObjectRegistry& registry);
+  /**
+   * \brief Run the check and the beautification on the prepared objects.
+   */
+  std::shared_ptr<o2::quality_control::core::QualityObject> run();
+
+  /// IDs of the declared MOs, in the registry to which the check is bound
+  const std::vector<ObjectRegistry::Id>& getObjectIds() const { return mObjectIds; }
+  /// Objects given to the check by the latest `prepare(registry)`, by full name
+  const IndexedObjectMap::Map& getObjectMap() const { return mShadowMap.get(); }
+  /// True if the check runs on all the MOs of its sources
+  bool isOnAllObjects() const { return mCheckConfig.allMOs; }
+  /// Maximum duration of the check in ms, 0 if not limited, -1 if not set in the configuration
+  int getTimeoutMs() const { return mCheckConfig.timeoutMs; }
+
   // Policy
   /**
    * \brief Change the revision.
@@ -71,6 +110,10 @@ class Check
    * \brief Return true if the Monitor Objects were changed accordingly to the policy
    */
   bool isReady(std::map<std::string, unsigned int>& revisionMap);
+  /**
+   * \brief Same as above, with the revisions of the registry to which the check is bound
+   */
+  bool isReady(const ObjectRegistry& registry);
 
   const std::string getName() { return mCheckConfig.checkName; };
   std::shared_ptr<o2::quality_control::core::QualityObject> getQualityObject() { return mLatestQuality; };
@@ -87,6 +130,8 @@ class Check
   void initConfig(std::string checkName);
   void initPolicy(std::string policyType);
 
+  void runCheck(std::map<std::string, std::shared_ptr<MonitorObject>>& moMap);
+  void logQuality();
   void beautify(std::map<std::string, std::shared_ptr<MonitorObject>>& moMap);
 
   std::string mConfigurationSource;
@@ -104,10 +149,17 @@ class Check
 
   bool mBeautify = true;
 
-  // Policy
-  std::function<bool(std::map<std::string, unsigned int>&)> mPolicy;
+  // Policy, evaluated on the MOs declared in mCheckConfig.moNames:
+  // those updated since the last check and those ever received
+  std::function<bool(const boost::dynamic_bitset<>& updated, const boost::dynamic_bitset<>& available)> mPolicy;
+  boost::dynamic_bitset<> mUpdated;
+  boost::dynamic_bitset<> mAvailable;
   unsigned int mMORevision = 0;
   bool mPolicyHelper = false; // Depending on policy, the purpose might change
+
+  // Objects accessed by ID, once bound to a registry
+  std::vector<ObjectRegistry::Id> mObjectIds; // in the order of mCheckConfig.moNames
+  IndexedObjectMap mShadowMap;
 };
 
 } // namespace o2::quality_control::checker
@@ -32,6 +32,7 @@ struct CheckConfig {
   std::string policyType = "OnAny";
   std::vector<std::string> moNames;
   bool allMOs = false;
+  int timeoutMs = -1; // -1: the default of the CheckRunner
 };
 
 } // namespace o2::quality_control::checker
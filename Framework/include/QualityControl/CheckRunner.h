@@ -19,11 +19,13 @@
 
 // std & boost
 #include <chrono>
+#include <future>
 #include <memory>
 #include <string>
 #include <map>
 #include <vector>
 #include <unordered_set>
+#include <unordered_map>
 // O2
 #include <Common/Timer.h>
 #include <Framework/Task.h>
@@ -36,6 +38,10 @@
 #include "QualityControl/MonitorObject.h"
 #include "QualityControl/QcInfoLogger.h"
 #include "QualityControl/Check.h"
+#include "QualityControl/DeltaDecoder.h"
+#include "QualityControl/StorageQueue.h"
+#include "QualityControl/ObjectRegistry.h"
+#include "QualityControl/WorkerPool.h"
 
 namespace o2::framework
 {
@@ -126,7 +132,17 @@ class CheckRunner : public framework::Task
    * @param mo The MonitorObject to evaluate and whose quality will be set according
    *        to the worse quality encountered while running the Check's.
    */
-  std::vector<Check*> check(std::map<std::string, std::shared_ptr<MonitorObject>> moMap);
+  std::vector<Check*> check();
+
+  /**
+   * \brief Evaluate the checks in the worker pool.
+   *
+   * The groups of checks which share MOs run concurrently, the checks of a group sequentially. The checks are returned
+   * in the order of the configuration, whatever the order in which they finish. A group which does not finish within
+   * the timeout of its checks is not waited for. Its checks are returned once they finish, in a later call, and the MOs
+   * it uses are stored only then, since they might still be beautified.
+   */
+  std::vector<Check*> checkInParallel();
 
   /**
    * \brief Store the MonitorObject in the database.
@@ -156,12 +172,18 @@ class CheckRunner : public framework::Task
 
   inline void initDatabase();
   inline void initMonitoring();
+  inline void initDeltaDecoders();
+  inline void initStorageQueue(const std::string& implementation, const std::unordered_map<std::string, std::string>& databaseConfig);
+  inline void initCheckWorkers();
+  void sendStorageMetrics();
+  void sendCheckMetrics();
+  void addCheckDuration(size_t check, double durationMs);
 
   /**
    * \brief Increase the revision number for the Monitor Object.
    *
    * The revision number is an timeslot id for the monitor object.
-   * It is assigned to an MO on receiving and is stored in mMonitorObjectRevision.
+   * It is assigned to an MO on receiving and is stored in mObjectRegistry.
    * This function function should be called at the end of the receiving MOs.
    */
   void updateRevision();
@@ -179,17 +201,40 @@ class CheckRunner : public framework::Task
   std::string mConfigurationSource;
   o2::quality_control::core::QcInfoLogger& mLogger;
   std::shared_ptr<o2::quality_control::repository::DatabaseInterface> mDatabase;
-  std::map<std::string, unsigned int> mMonitorObjectRevision;
+  std::shared_ptr<o2::quality_control::repository::StorageQueue> mStorageQueue; // stores asynchronously if set
   unsigned int mGlobalRevision = 1;
   std::unordered_set<std::string> mInputStoreSet;
   std::vector<std::shared_ptr<MonitorObject>> mMonitorObjectStoreVector;
+  std::unordered_map<std::string, std::shared_ptr<DeltaDecoder>> mDeltaDecoders; // input binding -> decoder, for tasks publishing deltas
 
   // DPL
   o2::framework::Inputs mInputs;
   o2::framework::Outputs mOutputs;
 
-  // Checks cache
-  std::map<std::string, std::shared_ptr<MonitorObject>> mMonitorObjects;
+  // Checks cache: latest version and revision of each MO, by ID
+  ObjectRegistry mObjectRegistry;
+
+  // Parallel execution of the checks, only if mCheckWorkers is set
+  struct CheckGroup {
+    std::shared_future<void> running;                                  // valid while the last dispatched checks did not finish
+    std::shared_future<std::chrono::steady_clock::time_point> started; // when a worker started the dispatched checks
+    std::vector<size_t> runningChecks;                                 // the last dispatched checks
+    std::unordered_set<const MonitorObject*> objectsInUse;             // the MOs given to these checks
+    std::vector<std::shared_ptr<MonitorObject>> deferredObjects;       // MOs to store once they finish
+  };
+  struct CheckStatistics {
+    double totalDurationMs = 0;
+    double maxDurationMs = 0;
+    size_t runs = 0;
+    size_t timeouts = 0;
+  };
+  std::shared_ptr<WorkerPool> mCheckWorkers;
+  int mDefaultCheckTimeoutMs = 0;                // 0 means no timeout
+  std::vector<CheckGroup> mCheckGroups;          // checks sharing MOs
+  std::vector<size_t> mCheckGroupIndex;          // check index -> group index
+  std::vector<double> mCheckDurations;           // check index -> duration of the last run, written by the workers
+  std::vector<std::string> mCheckFailures;       // check index -> diagnostic if the last run threw, written by the workers
+  std::vector<CheckStatistics> mCheckStatistics; // check index -> statistics since the last metrics
 
   // monitoring
   std::shared_ptr<o2::monitoring::Monitoring> mCollector;
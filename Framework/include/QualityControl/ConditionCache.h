@@ -0,0 +1,104 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   ConditionCache.h
+///
+
+#ifndef QC_CORE_CONDITIONCACHE_H
+#define QC_CORE_CONDITIONCACHE_H
+
+#include <chrono>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class TObject;
+
+namespace o2::quality_control::core
+{
+
+/// \brief Cache of the condition objects retrieved by the tasks.
+///
+/// Each version of an object is kept in memory, and optionally in a local directory, together with its validity
+/// interval and ETag. A request is served from the cache if a version is valid at the requested timestamp. Since a
+/// newer version might be uploaded at any time, the requests for the latest version (timestamp -1) reuse a version
+/// only if it was fetched less than latestLifetime ago. The disk cache survives restarts and can be shared by the
+/// tasks running on the same machine. Concurrent requests of the same object are sent only once.
+///
+/// The callers get their own copy of the objects and own it.
+class ConditionCache
+{
+ public:
+  /// Retrieves an object from the condition database and fills the headers, which should contain
+  /// "Valid-From", "Valid-Until" and "ETag" for the object to be cached.
+  using Fetcher = std::function<TObject*(const std::string& path, const std::map<std::string, std::string>& metadata, long timestamp, std::map<std::string, std::string>& headers)>;
+
+  struct Statistics {
+    size_t hits = 0;         ///< requests served from memory
+    size_t diskHits = 0;     ///< requests served from the disk cache
+    size_t misses = 0;       ///< requests sent to the condition database
+    size_t deduplicated = 0; ///< requests which waited for an identical one in flight
+  };
+
+  /// \brief Cache in front of the CCDB at the given url.
+  /// \param url                CCDB url
+  /// \param cacheDirectory     Directory of the disk cache, empty for a memory-only cache
+  /// \param latestLifetime     How long a version may be returned for requests of the latest version
+  ConditionCache(const std::string& url, std::string cacheDirectory = "", std::chrono::seconds latestLifetime = std::chrono::seconds(300));
+  /// Cache in front of any source of objects.
+  ConditionCache(Fetcher fetcher, std::string cacheDirectory = "", std::chrono::seconds latestLifetime = std::chrono::seconds(300));
+  ~ConditionCache();
+
+  /// Returns a copy of the object valid at the timestamp (-1 meaning now), or nullptr if it does not exist.
+  TObject* retrieve(const std::string& path, const std::map<std::string, std::string>& metadata = {}, long timestamp = -1);
+
+  /// Drops the objects kept in memory. The disk cache is kept.
+  void clear();
+
+  /// Returns the statistics since the last call.
+  Statistics getStatistics();
+
+ private:
+  struct Version {
+    long validFrom;  ///< ms since epoch
+    long validUntil; ///< ms since epoch, excluded
+    std::string etag;
+    std::chrono::system_clock::time_point fetched;
+    std::shared_ptr<TObject> object;
+  };
+  using VersionPtr = std::shared_ptr<Version>;
+
+  /// Must be called with mMutex locked.
+  VersionPtr findInMemory(const std::string& key, long timestamp, bool latest) const;
+  VersionPtr findOnDisk(const std::string& path, const std::string& key, long timestamp, bool latest) const;
+  VersionPtr fetch(const std::string& path, const std::string& key, const std::map<std::string, std::string>& metadata, long timestamp);
+  void writeToDisk(const std::string& path, const std::string& key, const Version& version) const;
+  std::string diskDirectory(const std::string& path, const std::string& key) const;
+  bool isFresh(const Version& version) const;
+
+  Fetcher mFetcher;
+  std::string mCacheDirectory;
+  std::chrono::seconds mLatestLifetime;
+
+  std::mutex mMutex;
+  std::unordered_map<std::string, std::vector<VersionPtr>> mVersions;        // path and metadata -> versions
+  std::unordered_map<std::string, std::shared_future<VersionPtr>> mInFlight; // request -> its result
+  Statistics mStatistics;
+};
+
+} // namespace o2::quality_control::core
+
+#endif // QC_CORE_CONDITIONCACHE_H
@@ -30,7 +30,7 @@ class DatabaseFactory
   /// \brief Create a new instance of a DatabaseInterface.
   /// The DatabaseInterface actual class is decided based on the parameters passed.
   /// The ownership is returned as well.
-  /// \param name Possible values : "MySql", "CCDB"
+  /// \param name Possible values : "MySql", "CCDB", "Local", "Dummy"
   /// \author Barthelemy von Haller
   static std::unique_ptr<DatabaseInterface> create(std::string name);
 };
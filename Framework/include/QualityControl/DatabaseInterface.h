@@ -17,7 +17,9 @@
 #define QC_REPOSITORY_DATABASEINTERFACE_H
 
 #include <string>
+#include <future>
 #include <memory>
+#include <utility>
 #include <vector>
 #include <unordered_map>
 
@@ -121,6 +123,36 @@ class DatabaseInterface
     return retrieveJson(path, -1, metadata);
   }
 
+  /**
+   * \brief Batch and asynchronous variants of the store and retrieve methods.
+   * The default implementations call the single-object methods one after the other and the asynchronous ones are
+   * deferred: the request is executed in the thread calling std::future::get(). This is safe for any implementation.
+   * Implementations which can handle concurrent requests override them to let the round trips overlap.
+   */
+  virtual void storeMOs(const std::vector<std::shared_ptr<o2::quality_control::core::MonitorObject>>& mos);
+  virtual void storeQOs(const std::vector<std::shared_ptr<o2::quality_control::core::QualityObject>>& qos);
+  virtual std::future<void> storeMOAsync(std::shared_ptr<o2::quality_control::core::MonitorObject> mo);
+  virtual std::future<void> storeQOAsync(std::shared_ptr<o2::quality_control::core::QualityObject> qo);
+  /**
+   * \brief Look up monitor objects and return them.
+   * The result has the same size and order as the request, the objects not found are nullptr.
+   * \param taskAndObjectNames pairs of task name and object name, as in retrieveMO
+   */
+  virtual std::vector<std::shared_ptr<o2::quality_control::core::MonitorObject>> retrieveMOs(const std::vector<std::pair<std::string, std::string>>& taskAndObjectNames, long timestamp = -1);
+  /**
+   * \brief Look up quality objects and return them.
+   * The result has the same size and order as the request, the objects not found are nullptr.
+   */
+  virtual std::vector<std::shared_ptr<o2::quality_control::core::QualityObject>> retrieveQOs(const std::vector<std::string>& qoPaths, long timestamp = -1);
+  /**
+   * \brief Look up objects and return them.
+   * The result has the same size and order as the request, the objects not found are nullptr. The caller owns them.
+   */
+  virtual std::vector<TObject*> retrieveTObjects(const std::vector<std::string>& paths, const std::map<std::string, std::string>& metadata, long timestamp = -1);
+  virtual std::future<std::shared_ptr<o2::quality_control::core::MonitorObject>> retrieveMOAsync(std::string taskName, std::string objectName, long timestamp = -1);
+  virtual std::future<std::shared_ptr<o2::quality_control::core::QualityObject>> retrieveQOAsync(std::string qoPath, long timestamp = -1);
+  virtual std::future<TObject*> retrieveTObjectAsync(std::string path, const std::map<std::string, std::string>& metadata, long timestamp = -1);
+
   virtual void disconnect() = 0;
   /**
    * \brief Prepare the container, such as a table in a relational database, that will contain the MonitorObject's for
@@ -0,0 +1,55 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   DeltaDecoder.h
+///
+
+#ifndef QC_CORE_DELTADECODER_H
+#define QC_CORE_DELTADECODER_H
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "QualityControl/MonitorObject.h"
+
+class TH1;
+
+namespace o2::quality_control::core
+{
+
+/// \brief Rebuilds full MonitorObjects out of the publications of a DeltaEncoder.
+///
+/// One decoder should be used per producer. It keeps a private copy of the last full state of each histogram,
+/// which is the baseline for the next delta.
+class DeltaDecoder
+{
+ public:
+  DeltaDecoder();
+  ~DeltaDecoder();
+
+  /// \brief Returns the full MonitorObject corresponding to the received one.
+  ///
+  /// Full objects are returned as they are. Deltas are applied on a copy of their baseline. If a delta cannot be
+  /// decoded, e.g. because the previous publication was missed, nullptr is returned and the object is available
+  /// again with the next keyframe.
+  std::shared_ptr<MonitorObject> decode(std::shared_ptr<MonitorObject> mo);
+
+  /// \brief Tells if the MonitorObject contains a delta.
+  static bool isDelta(const MonitorObject* mo);
+
+ private:
+  std::unordered_map<std::string, std::unique_ptr<TH1>> mBaselines;
+};
+
+} // namespace o2::quality_control::core
+
+#endif // QC_CORE_DELTADECODER_H
@@ -0,0 +1,71 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   DeltaEncoder.h
+///
+
+#ifndef QC_CORE_DELTAENCODER_H
+#define QC_CORE_DELTAENCODER_H
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "QualityControl/MonitorObject.h"
+#include "QualityControl/MonitorObjectCollection.h"
+
+class TH1;
+
+namespace o2::quality_control::core
+{
+
+/// \brief Prepares the publication of MonitorObjects as deltas with respect to their previous publication.
+///
+/// The encoder keeps the state in which each histogram was last published (its baseline). Histograms are published
+/// in full (keyframes) the first time, every keyframeInterval publications and whenever their binning changes.
+/// In the other publications only the bins and the statistics which changed are sent, as a HistogramDelta.
+/// Objects which are not histograms are always published in full. Use DeltaDecoder to rebuild the full objects.
+class DeltaEncoder
+{
+ public:
+  /// \param keyframeInterval - a full publication is done every keyframeInterval publications (1 means always).
+  explicit DeltaEncoder(int keyframeInterval);
+  ~DeltaEncoder();
+
+  /// \brief Returns a non-owning collection with the objects to publish.
+  /// The deltas are owned by the encoder, they are valid until the next call.
+  std::unique_ptr<MonitorObjectCollection> encode(const MonitorObjectCollection& objects);
+
+  /// \brief Empties the baselines. To be called when the task resets its objects.
+  void resetBaselines();
+
+  /// \brief Forgets the baselines, so that the next publication is a keyframe.
+  void forceKeyframe();
+
+  /// \brief Number of objects which were published as deltas in the last publication.
+  size_t getNumberOfDeltas() const { return mDeltas.size(); }
+
+ private:
+  struct Baseline {
+    std::unique_ptr<TH1> histogram;
+    bool empty = false; // the task has reset the object since the last publication
+  };
+
+  int mKeyframeInterval;
+  int mPublicationNumber = 0;
+  std::unordered_map<std::string, Baseline> mBaselines;
+  std::vector<std::unique_ptr<MonitorObject>> mDeltas;
+};
+
+} // namespace o2::quality_control::core
+
+#endif // QC_CORE_DELTAENCODER_H
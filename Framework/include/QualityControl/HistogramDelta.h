@@ -0,0 +1,81 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   HistogramDelta.h
+///
+
+#ifndef QC_CORE_HISTOGRAMDELTA_H
+#define QC_CORE_HISTOGRAMDELTA_H
+
+#include <string>
+#include <vector>
+// ROOT
+#include <Rtypes.h>
+#include <TObject.h>
+
+class TH1;
+
+namespace o2::quality_control::core
+{
+
+/// \brief Bins and statistics of a histogram which changed since its previous publication.
+///
+/// A HistogramDelta is published instead of a full histogram by tasks which use the delta publication mode.
+/// It is additive: applying it on the state of the histogram at its previous publication (the baseline) gives the
+/// current state, while applying it on a merged histogram adds the new content of one producer.
+/// The number of entries of the baseline is kept, so that a receiver can detect that it missed a publication.
+/// Profiles are not supported, because their bin contents are not plain sums of weights.
+class HistogramDelta : public TObject
+{
+ public:
+  HistogramDelta() = default;
+  ~HistogramDelta() override = default;
+
+  /// \brief Creates the delta between the current state of a histogram and its baseline.
+  /// \param current - the histogram as it is now
+  /// \param baseline - the histogram as it was at its previous publication, nullptr for an empty baseline.
+  ///                   It has to have the same binning as current, see isEncodable().
+  /// \return the delta, owned by the caller
+  static HistogramDelta* create(const TH1* current, const TH1* baseline);
+
+  /// \brief Tells whether the object can be published as a delta.
+  /// \param object - the object to publish
+  /// \param baseline - if not null, the object must also have the same type and binning as the baseline.
+  static bool isEncodable(const TObject* object, const TObject* baseline = nullptr);
+
+  /// \brief Adds the changed bins and statistics to the target.
+  /// \return false if the target is null or does not have the expected number of bins.
+  bool apply(TH1* target) const;
+
+  /// \brief Returns true if the target is in the state against which the delta was computed.
+  bool matchesBaseline(const TH1* target) const;
+
+  const char* GetName() const override { return mName.c_str(); }
+  bool isEmptyBaseline() const { return mEmptyBaseline; }
+  size_t getNumberOfChangedBins() const { return mBins.size(); }
+
+ private:
+  std::string mName;
+  Int_t mNumberOfCells = 0;
+  bool mEmptyBaseline = true;
+  Double_t mBaselineEntries = 0;
+  std::vector<Int_t> mBins; // global bin numbers of the changed bins
+  std::vector<Double_t> mContents;
+  std::vector<Double_t> mSumw2; // empty if the histogram does not store the sum of squares of weights
+  std::vector<Double_t> mStats; // as in TH1::GetStats
+  Double_t mEntries = 0;
+
+  ClassDefOverride(HistogramDelta, 1);
+};
+
+} // namespace o2::quality_control::core
+
+#endif // QC_CORE_HISTOGRAMDELTA_H
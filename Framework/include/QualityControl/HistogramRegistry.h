@@ -0,0 +1,106 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   HistogramRegistry.h
+///
+
+#ifndef QC_CORE_HISTOGRAMREGISTRY_H
+#define QC_CORE_HISTOGRAMREGISTRY_H
+
+#include <cassert>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class TH1;
+class TNamed;
+
+namespace o2::quality_control::core
+{
+
+class SparseHistogram;
+
+/// \brief Histograms of a decoder, addressed by integer handles.
+///
+/// The histograms are registered once, at initialization, and then filled through their handle, which is an index in
+/// a dense array: no name is hashed or compared in the decoding loops. The fills can also be collected in a Buffer,
+/// owned by one thread, and applied to the histograms at once with Buffer::flush(), for example once per message.
+/// The histograms, TH1 or SparseHistogram, are not owned by the registry.
+class HistogramRegistry
+{
+ public:
+  using Handle = uint32_t;
+  static constexpr Handle InvalidHandle = UINT32_MAX;
+
+  /// Registers the histogram and returns its handle. A histogram with the same name is replaced.
+  Handle add(TH1* histogram);
+  Handle add(SparseHistogram* histogram);
+  /// Returns the handle of the histogram, InvalidHandle if there is none. Meant for the initialization.
+  Handle find(const std::string& name) const;
+  /// Returns the histogram if it is a TH1, nullptr otherwise.
+  TH1* get(Handle handle) const { return mHistograms[handle].histogram; }
+  /// Returns the histogram if it is a SparseHistogram, nullptr otherwise.
+  SparseHistogram* getSparse(Handle handle) const { return mHistograms[handle].sparse; }
+  size_t size() const { return mHistograms.size(); }
+
+  void fill(Handle handle, double x);
+  void fill(Handle handle, double x, double y);
+  /// Resets all the registered histograms, for example at the end of a cycle or at the start of an activity.
+  void reset();
+
+  /// \brief Fills collected by a thread, applied to the histograms of the registry by flush().
+  ///
+  /// A buffer must be created after the histograms are registered: the histograms registered later cannot be filled
+  /// through it. The values are kept in arrays which are reused from one flush to the next. Several buffers of the same
+  /// registry can be flushed from different threads.
+  class Buffer
+  {
+   public:
+    explicit Buffer(HistogramRegistry& registry);
+    ~Buffer();
+
+    void fill(Handle handle, double x)
+    {
+      assert(handle < mX.size());
+      mX[handle].push_back(x);
+    }
+    void fill(Handle handle, double x, double y)
+    {
+      assert(handle < mX.size());
+      mX[handle].push_back(x);
+      mY[handle].push_back(y);
+    }
+    /// Fills the histograms with the collected values and forgets them.
+    void flush();
+
+   private:
+    HistogramRegistry& mRegistry;
+    std::vector<std::vector<double>> mX; // [handle][fill]
+    std::vector<std::vector<double>> mY; // [handle][fill], for the 2D histograms
+  };
+
+ private:
+  struct Entry {
+    TNamed* object = nullptr;
+    TH1* histogram = nullptr;
+    SparseHistogram* sparse = nullptr;
+  };
+
+  Handle addEntry(const Entry& entry);
+
+  std::vector<Entry> mHistograms;
+  std::mutex mFlushMutex; // buffers flushed from different threads
+};
+
+} // namespace o2::quality_control::core
+
+#endif // QC_CORE_HISTOGRAMREGISTRY_H
@@ -25,12 +25,20 @@ class CompletionPolicy;
 }
 #include <Framework/WorkflowSpec.h>
 #include <Framework/DataProcessorSpec.h>
+#include <boost/property_tree/ptree_fwd.hpp>
 
 namespace o2::quality_control
 {
 namespace core
 {
 
+/// \brief Configuration of one layer of the Merger tree of a local task.
+struct MergerLayerConfig {
+  size_t fanIn = 0;                 ///< maximum number of inputs of each Merger, 0 for all the inputs of the layer
+  bool deltaInput = true;           ///< whether the inputs are differences since their previous publication or full objects
+  double cycleDurationSeconds = 10; ///< publication period of the Mergers of the layer
+};
+
 /// \brief A factory class which can generate QC topologies given a configuration file.
 ///
 /// A factory class which can generate QC topologies given a configuration file (example in Framework/basic.json and
@@ -142,7 +150,12 @@ class InfrastructureGenerator
   static void generateMergers(framework::WorkflowSpec& workflow,
                               std::string taskName,
                               size_t numberOfLocalMachines,
-                              double cycleDurationSeconds);
+                              const std::vector<MergerLayerConfig>& layers,
+                              size_t mergerThreads = 1);
+  static std::vector<MergerLayerConfig> readMergerLayers(const boost::property_tree::ptree& taskConfig,
+                                                         const std::string& taskName);
+  static header::DataOrigin createMergerLayerDataOrigin();
+  static header::DataHeader::SubSpecificationType createMergerLayerSubSpec(size_t layer, size_t id);
   static void generateCheckRunners(framework::WorkflowSpec& workflow, std::string configurationSource);
 };
 
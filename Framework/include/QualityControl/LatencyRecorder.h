@@ -0,0 +1,103 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   LatencyRecorder.h
+///
+
+#ifndef QC_CORE_LATENCYRECORDER_H
+#define QC_CORE_LATENCYRECORDER_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+class TH1F;
+
+namespace o2::monitoring
+{
+class Monitoring;
+}
+
+namespace o2::quality_control::core
+{
+
+/// \brief In-memory latency measurements of the steps of a task.
+///
+/// Recording a duration only writes it to a preallocated ring buffer, so that it can be done in the processing loop
+/// of a task. When the buffer of a step is full, its oldest samples are overwritten, but they are still counted in its
+/// statistics. exportSamples() is meant to be called once per cycle: it fills the histograms of the steps with the
+/// samples, sends their statistics to Monitoring, and starts a new series of measurements.
+class LatencyRecorder
+{
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  struct Statistics {
+    uint64_t count = 0; ///< durations recorded since the last export
+    double meanUs = 0.; ///< mean of these durations, in microseconds
+    double maxUs = 0.;  ///< maximum of these durations, in microseconds
+  };
+
+  /// \param name      prefix of the histogram names and name of the metric
+  /// \param steps     names of the measured steps, used in the histogram names and the metric field names
+  /// \param capacity  number of samples kept per step between two exports
+  /// \param maxUs     upper edge of the histograms, in microseconds
+  LatencyRecorder(std::string name, std::vector<std::string> steps, size_t capacity = 1000, double maxUs = 1e6);
+  ~LatencyRecorder();
+
+  LatencyRecorder(const LatencyRecorder&) = delete;
+  LatencyRecorder& operator=(const LatencyRecorder&) = delete;
+
+  /// Records the duration of a step, the step being the index of its name in the constructor.
+  void add(size_t step, Clock::duration duration)
+  {
+    auto& s = mSteps[step];
+    float us = std::chrono::duration<float, std::micro>(duration).count();
+    s.samples[s.next] = us;
+    s.next = s.next + 1 == s.samples.size() ? 0 : s.next + 1;
+    s.count++;
+    s.sumUs += us;
+    s.maxUs = std::max(s.maxUs, us);
+  }
+  /// Records the time elapsed since start.
+  void add(size_t step, Clock::time_point start) { add(step, Clock::now() - start); }
+
+  Statistics getStatistics(size_t step) const;
+  /// Histogram of the durations of the step at the last export, owned by the recorder.
+  TH1F* getHistogram(size_t step) const;
+  size_t getNumberOfSteps() const { return mSteps.size(); }
+
+  /// \brief Fills the histograms with the samples of the steps, sends their statistics and clears them.
+  /// The histograms are reset first, so that they show the durations recorded since the previous export.
+  /// \param monitoring  receives the metric, can be null
+  void exportSamples(o2::monitoring::Monitoring* monitoring = nullptr);
+
+ private:
+  struct Step {
+    std::string name;
+    std::vector<float> samples; // ring buffer, in microseconds
+    size_t next = 0;            // position of the next sample in the buffer
+    uint64_t count = 0;
+    double sumUs = 0.;
+    float maxUs = 0.;
+    std::unique_ptr<TH1F> histogram;
+  };
+
+  const std::string mName;
+  std::vector<Step> mSteps;
+};
+
+} // namespace o2::quality_control::core
+
+#endif // QC_CORE_LATENCYRECORDER_H
@@ -0,0 +1,114 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   LocalDatabase.h
+///
+
+#ifndef QC_REPOSITORY_LOCALDATABASE_H
+#define QC_REPOSITORY_LOCALDATABASE_H
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "QualityControl/DatabaseInterface.h"
+
+namespace o2::quality_control::repository
+{
+
+/// \brief Repository stored in local files, without any server.
+///
+/// It is meant for offline work and for benchmarking the QC at disk speed. The objects are serialized the same way
+/// as in the CCDB and appended to a data file. Each version gets a fixed-size entry in an index file, which is
+/// memory-mapped. The entries are indexed in memory by path and validity start to answer the queries. Nothing is ever
+/// overwritten: truncating an object appends an entry which hides its previous versions. Several instances, also in
+/// different processes, can use the same directory.
+///
+/// The "host" of the configuration is the directory, optionally prefixed with "file://".
+class LocalDatabase : public DatabaseInterface
+{
+ public:
+  LocalDatabase() = default;
+  ~LocalDatabase() override;
+
+  void connect(std::string host, std::string database, std::string username, std::string password) override;
+  void connect(const std::unordered_map<std::string, std::string>& config) override;
+
+  // storage
+  void storeMO(std::shared_ptr<o2::quality_control::core::MonitorObject> mo) override;
+  void storeQO(std::shared_ptr<o2::quality_control::core::QualityObject> qo) override;
+
+  // retrieval - MO
+  std::shared_ptr<o2::quality_control::core::MonitorObject> retrieveMO(std::string taskName, std::string objectName, long timestamp = -1) override;
+  std::string retrieveMOJson(std::string taskName, std::string objectName, long timestamp = -1) override;
+
+  // retrieval - QO
+  std::shared_ptr<o2::quality_control::core::QualityObject> retrieveQO(std::string qoPath, long timestamp = -1) override;
+  std::string retrieveQOJson(std::string qoPath, long timestamp = -1) override;
+
+  // retrieval - general
+  std::string retrieveJson(std::string path, long timestamp, const std::map<std::string, std::string>& metadata) override;
+  TObject* retrieveTObject(std::string path, const std::map<std::string, std::string>& metadata, long timestamp = -1, std::map<std::string, std::string>* headers = nullptr) override;
+
+  void disconnect() override;
+  void prepareTaskDataContainer(std::string taskName) override;
+  std::vector<std::string> getPublishedObjectNames(std::string taskName) override;
+  void truncate(std::string taskName, std::string objectName) override;
+
+  /// Returns the paths of the objects which are under the subpath and not truncated, sorted.
+  std::vector<std::string> getListing(std::string subpath = "");
+  /// Returns the validity start of all the versions of an object, the latest first.
+  std::vector<long> getVersions(std::string path);
+
+  /// \brief An entry of the index file. One per stored version or truncation.
+  struct IndexEntry {
+    static constexpr size_t maxPathLength = 255;
+    static constexpr uint32_t typeObject = 0;
+    static constexpr uint32_t typeTruncation = 1;
+
+    char path[maxPathLength + 1];
+    int64_t validFrom;  ///< ms since epoch
+    int64_t validUntil; ///< ms since epoch, excluded
+    int32_t run;        ///< -1 if unknown
+    uint32_t type;
+    uint64_t offset; ///< position of the record in the data file
+    uint64_t size;   ///< size of the record in the data file
+  };
+
+ private:
+  void store(const std::string& path, const TObject* object, const std::map<std::string, std::string>& metadata, long from, long to, uint32_t type = IndexEntry::typeObject);
+  /// Maps and indexes the part of the index file written since the last call. Must be called with mMutex locked.
+  void updateMapping();
+  /// Adds the entries of the mapped index from first to mNumberOfEntries to mVersions.
+  void indexEntries(size_t first);
+  /// Returns the latest entry matching the query, or nullptr. Must be called with mMutex locked.
+  const IndexEntry* find(const std::string& path, long timestamp, const std::map<std::string, std::string>& metadata);
+  std::map<std::string, std::string> readMetadata(const IndexEntry& entry);
+  TObject* readObject(const IndexEntry& entry);
+  void closeFiles();
+
+  std::string mDirectory;
+  int mDataFile = -1;
+  int mIndexFile = -1;
+  const IndexEntry* mIndex = nullptr; ///< memory-mapped index
+  size_t mMappedSize = 0;             ///< in bytes
+  size_t mNumberOfEntries = 0;
+  /// Positions in mIndex of the versions of each path, sorted by validity start then by position. The versions
+  /// before the last truncation of a path are removed, so a truncated path has an empty vector.
+  std::map<std::string, std::vector<size_t>> mVersions;
+  std::mutex mMutex;
+};
+
+} // namespace o2::quality_control::repository
+
+#endif // QC_REPOSITORY_LOCALDATABASE_H
@@ -0,0 +1,92 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   LocalSnapshot.h
+///
+
+#ifndef QC_CORE_LOCALSNAPSHOT_H
+#define QC_CORE_LOCALSNAPSHOT_H
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+class TObject;
+
+namespace o2::quality_control::core
+{
+
+class MonitorObjectCollection;
+
+/// \brief Writes copies of the objects of a task to a local ROOT file, from a background thread.
+///
+/// The objects are copied in the caller thread, so that the task can keep filling them, and the file is written
+/// under a temporary name before being renamed, so that its readers never see an incomplete snapshot. A snapshot
+/// which is still pending when a new one is taken is replaced by it.
+class LocalSnapshot
+{
+ public:
+  struct Statistics {
+    size_t written = 0;      ///< snapshots written to the file
+    size_t replaced = 0;     ///< snapshots replaced by a newer one before being written
+    size_t failed = 0;       ///< snapshots which could not be written
+    double lastWriteMs = 0.; ///< duration of the last write
+  };
+
+  /// \param filePath     ROOT file overwritten by each snapshot
+  /// \param period       minimum time between two snapshots, zero to write only the forced ones
+  /// \param objectNames  names of the objects to write, all of them if empty
+  LocalSnapshot(std::string filePath, std::chrono::milliseconds period, std::vector<std::string> objectNames = {});
+  /// Writes the pending snapshot and stops the thread.
+  ~LocalSnapshot();
+
+  LocalSnapshot(const LocalSnapshot&) = delete;
+  LocalSnapshot& operator=(const LocalSnapshot&) = delete;
+
+  /// \brief Takes a snapshot of the MonitorObjects if the period has elapsed since the previous one, or if forced.
+  /// Returns true if a snapshot was taken.
+  bool update(const MonitorObjectCollection& objects, bool force = false);
+  /// Waits until the pending snapshot is written.
+  void flush();
+
+  Statistics getStatistics() const;
+  const std::string& getFilePath() const { return mFilePath; }
+
+ private:
+  using Snapshot = std::vector<std::unique_ptr<TObject>>;
+
+  void run();
+  bool write(const Snapshot& snapshot);
+
+  const std::string mFilePath;
+  const std::chrono::milliseconds mPeriod;
+  const std::unordered_set<std::string> mObjectNames;
+  std::chrono::steady_clock::time_point mLastSnapshot;
+  bool mFirstSnapshot = true;
+
+  mutable std::mutex mMutex;
+  std::condition_variable mSnapshotAvailable;
+  std::condition_variable mIdle;
+  std::unique_ptr<Snapshot> mPending;
+  bool mWriting = false;
+  bool mStopping = false;
+  Statistics mStatistics;
+  std::thread mThread;
+};
+
+} // namespace o2::quality_control::core
+
+#endif // QC_CORE_LOCALSNAPSHOT_H
@@ -28,7 +28,16 @@ class MonitorObjectCollection : public TObjArray, public mergers::MergeInterface
   MonitorObjectCollection() = default;
   ~MonitorObjectCollection() = default;
 
+  /// \brief Merges the objects of the other collection into the objects with the same name.
+  ///
+  /// The objects are matched by name in linear time. When more than one merge thread is set, the objects
+  /// which have no merge target in common are merged in parallel.
   void merge(mergers::MergeInterface* const other) override;
+
+  /// Sets the number of threads used by merge() in this process, 1 (sequential merging) by default.
+  static void setNumberOfMergeThreads(size_t threads);
+  static size_t getNumberOfMergeThreads();
+
   ClassDefOverride(MonitorObjectCollection, 0);
 };
 
@@ -41,10 +41,12 @@ class MySqlDatabase : public DatabaseInterface
   void connect(const std::unordered_map<std::string, std::string>& config) override;
   // MonitorObject
   void storeMO(std::shared_ptr<o2::quality_control::core::MonitorObject> q) override;
+  void storeMOs(const std::vector<std::shared_ptr<o2::quality_control::core::MonitorObject>>& mos) override;
   std::shared_ptr<o2::quality_control::core::MonitorObject> retrieveMO(std::string taskName, std::string objectName, long timestamp = -1) override;
   std::string retrieveMOJson(std::string taskName, std::string objectName, long timestamp = -1) override;
   // QualityObject
   void storeQO(std::shared_ptr<o2::quality_control::core::QualityObject> q) override;
+  void storeQOs(const std::vector<std::shared_ptr<o2::quality_control::core::QualityObject>>& qos) override;
   std::shared_ptr<o2::quality_control::core::QualityObject> retrieveQO(std::string qoPath, long timestamp = -1) override;
   std::string retrieveQOJson(std::string qoPath, long timestamp = -1) override;
   // General
@@ -79,6 +81,8 @@ class MySqlDatabase : public DatabaseInterface
   void prepareTable(std::string table_name);
 
   void storeQueue();
+  /// Stores the queue if it holds too many objects or if it was stored too long ago.
+  void storeQueueIfNeeded();
   void storeForMonitorObject(std::string taskName);
   void storeForQualityObject(std::string checkName);
 
@@ -0,0 +1,85 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   ObjectRegistry.h
+///
+
+#ifndef QC_CHECKER_OBJECTREGISTRY_H
+#define QC_CHECKER_OBJECTREGISTRY_H
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "QualityControl/MonitorObject.h"
+
+namespace o2::quality_control::checker
+{
+
+/// \brief Map of MonitorObjects, as given to the checks, whose entries are set by position.
+///
+/// Setting an entry which was already set only replaces the pointer, without looking up the name.
+class IndexedObjectMap
+{
+ public:
+  using Map = std::map<std::string, std::shared_ptr<core::MonitorObject>>;
+
+  IndexedObjectMap() = default;
+  ~IndexedObjectMap() = default;
+  /// The copies point to their own entries.
+  IndexedObjectMap(const IndexedObjectMap& other);
+  IndexedObjectMap& operator=(const IndexedObjectMap& other);
+
+  /// Sets the entry at position, which is inserted under name the first time.
+  void set(size_t position, const std::string& name, std::shared_ptr<core::MonitorObject> mo);
+  Map& get() { return mMap; }
+  const Map& get() const { return mMap; }
+
+ private:
+  Map mMap;
+  std::vector<Map::iterator> mEntries; // position -> entry, mMap.end() if not set yet
+};
+
+/// \brief Registry of the MonitorObjects received by a CheckRunner.
+///
+/// Each object name is interned once to a dense ID, which is then used to access the latest version of the object and
+/// the revision at which it was received. The revisions are kept in a flat vector, 0 meaning that the object was not
+/// received yet.
+class ObjectRegistry
+{
+ public:
+  using Id = uint32_t;
+
+  /// Returns the ID of the object, which is registered if it was not yet.
+  Id intern(const std::string& taskName, const std::string& objectName);
+  /// Same as above, with the name as returned by MonitorObject::getFullName().
+  Id intern(const std::string& fullName);
+  /// Stores the object as the latest version received and returns its ID.
+  Id update(const std::shared_ptr<core::MonitorObject>& mo, unsigned int revision);
+
+  size_t size() const { return mNames.size(); }
+  const std::string& getName(Id id) const { return mNames[id]; }
+  unsigned int getRevision(Id id) const { return mRevisions[id]; }
+  const std::shared_ptr<core::MonitorObject>& getObject(Id id) const { return mObjects[id]; }
+
+ private:
+  std::unordered_map<std::string, std::unordered_map<std::string, Id>> mIds; // task name -> object name -> ID
+  std::vector<std::string> mNames;                                           // ID -> full name
+  std::vector<unsigned int> mRevisions;                                      // ID -> revision
+  std::vector<std::shared_ptr<core::MonitorObject>> mObjects;                // ID -> latest object
+};
+
+} // namespace o2::quality_control::checker
+
+#endif // QC_CHECKER_OBJECTREGISTRY_H
@@ -21,8 +21,11 @@
 #include "QualityControl/MonitorObjectCollection.h"
 #include "QualityControl/TaskConfig.h"
 // stl
+#include <cstdint>
 #include <string>
 #include <memory>
+#include <unordered_map>
+#include <vector>
 
 class TObject;
 class TObjArray;
@@ -36,11 +39,20 @@ class ServiceDiscovery;
 ///
 /// Keeps a list of the objects to publish, encapsulates them and does the actual publication.
 /// Tasks set/get properties of the MonitorObjects via this class.
+/// The objects are indexed by the name they have when they start being published. Tasks accessing them often can
+/// keep a Handle, which avoids the look-up by name.
 ///
 /// \author Barthelemy von Haller
 class ObjectsManager
 {
  public:
+  /// \brief Reference to a published object, which is invalidated when the object stops being published.
+  struct Handle {
+    static constexpr uint32_t invalidIndex = UINT32_MAX;
+    uint32_t index = invalidIndex;
+    uint32_t generation = 0;
+  };
+
   /**
    * Constructor
    * @param taskConfig The configuration of the task for which we are building this object manager
@@ -86,7 +98,28 @@ class ObjectsManager
    */
   MonitorObject* getMonitorObject(std::string objectName);
 
-  MonitorObjectCollection* getNonOwningArray() const;
+  /**
+   * Returns a handle to the published object specified by its name
+   * @param objectName The name of the object to find.
+   * @return A handle valid until the object stops being published.
+   * @throw ObjectNotFoundError if the object is not found.
+   */
+  Handle getHandle(const std::string& objectName);
+
+  /**
+   * Returns the published MonitorObject specified by a handle
+   * @param handle The handle returned by getHandle().
+   * @return A pointer to the MonitorObject.
+   * @throw ObjectNotFoundError if the object is not published anymore.
+   */
+  MonitorObject* getMonitorObject(Handle handle);
+
+  /**
+   * Returns the array of the objects to publish, which does not own them.
+   * The array belongs to the ObjectsManager. It is reused from one call to the next and rebuilt only if objects were
+   * added or removed in the meantime.
+   */
+  MonitorObjectCollection& getNonOwningArray();
 
   /**
    * \brief Add metadata to a MonitorObject.
@@ -118,7 +151,17 @@ class ObjectsManager
   void removeAllFromServiceDiscovery();
 
  private:
+  struct Entry {
+    MonitorObject* object = nullptr; // nullptr if the entry is free
+    uint32_t generation = 0;         // incremented when the entry is freed, to invalidate the handles
+  };
+
   std::unique_ptr<MonitorObjectCollection> mMonitorObjects;
+  std::vector<Entry> mEntries;                              // handle index -> object
+  std::vector<uint32_t> mFreeEntries;                       // indices of the free entries, to be reused
+  std::unordered_map<std::string, uint32_t> mIndex;         // object name -> handle index
+  std::unique_ptr<MonitorObjectCollection> mNonOwningArray; // reused for the publication
+  bool mNonOwningArrayOutdated = true;
   TaskConfig& mTaskConfig;
   std::unique_ptr<ServiceDiscovery> mServiceDiscovery;
   bool mUpdateServiceDiscovery;
@@ -0,0 +1,117 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   SparseHistogram.h
+///
+
+#ifndef QC_CORE_SPARSEHISTOGRAM_H
+#define QC_CORE_SPARSEHISTOGRAM_H
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+// ROOT
+#include <Rtypes.h>
+#include <TNamed.h>
+// O2
+#include <Mergers/MergeInterface.h>
+
+class TH1F;
+
+namespace o2::quality_control::core
+{
+
+/// \brief 1D histogram with a fixed binning, which stores only the chunks of bins which were filled.
+///
+/// It is meant for histograms with a very large number of bins, of which only a small part is filled, such as time
+/// spectra: it is serialized, published, merged and stored with the size of its filled chunks, instead of the size of
+/// its binning. It is merged by the Mergers as any MergeInterface. The equivalent TH1F, needed to draw it or to
+/// check it, is created only when asked with getHistogram().
+/// Only the bin contents and the number of entries are kept, the other statistics are computed from the bins.
+class SparseHistogram : public TNamed, public mergers::MergeInterface
+{
+ public:
+  static constexpr Int_t ChunkSize = 64;
+
+  SparseHistogram() = default;
+  SparseHistogram(const char* name, const char* title, Int_t nBins, Double_t xMin, Double_t xMax);
+  ~SparseHistogram() override;
+
+  void Fill(Double_t x, Double_t w = 1.)
+  {
+    mEntries++;
+    mModified = true;
+    if (x >= mXMin && x < mXMax) {
+      addToBin(std::min(static_cast<Int_t>((x - mXMin) * mBinsPerUnit), mNBins - 1), w);
+    } else if (x < mXMin) {
+      mUnderflow += w;
+    } else {
+      // including NaN, as in TH1
+      mOverflow += w;
+    }
+  }
+  void FillN(Int_t n, const Double_t* x);
+
+  /// Returns the content of the bin, numbered as in TH1: 0 for the underflow and nBins + 1 for the overflow.
+  Double_t GetBinContent(Int_t bin) const;
+  Double_t GetEntries() const { return mEntries; }
+  Int_t GetNbinsX() const { return mNBins; }
+  Double_t getXMin() const { return mXMin; }
+  Double_t getXMax() const { return mXMax; }
+  /// Number of chunks of ChunkSize bins which are stored.
+  size_t getNumberOfChunks() const { return mChunks.size(); }
+
+  void Reset(Option_t* option = "");
+  void Draw(Option_t* option = "") override;
+
+  /// Adds the other histogram, which must have the same binning.
+  void merge(mergers::MergeInterface* const other) override;
+
+  /// \brief Returns the equivalent TH1F, owned by this object.
+  /// It is created at the first call, and updated by the next calls if this histogram changed in the meantime.
+  TH1F* getHistogram();
+
+ private:
+  void addToBin(Int_t bin, Double_t w)
+  {
+    Int_t chunk = bin / ChunkSize;
+    if (mChunkPositions.empty()) {
+      buildChunkPositions();
+    }
+    Int_t position = mChunkPositions[chunk];
+    if (position < 0) {
+      position = addChunk(chunk);
+    }
+    mContents[position * ChunkSize + bin % ChunkSize] += w;
+  }
+  Int_t addChunk(Int_t chunk);
+  void buildChunkPositions() const;
+
+  Int_t mNBins = 0;
+  Double_t mXMin = 0.;
+  Double_t mXMax = 0.;
+  Double_t mBinsPerUnit = 0.;
+  Double_t mEntries = 0.;
+  Double_t mUnderflow = 0.;
+  Double_t mOverflow = 0.;
+  std::vector<Int_t> mChunks;     // indices of the stored chunks, in the order in which they were filled
+  std::vector<Float_t> mContents; // ChunkSize bins for each stored chunk
+
+  mutable std::vector<Int_t> mChunkPositions; //! position of each chunk in mChunks, -1 if not stored
+  std::unique_ptr<TH1F> mHistogram;           //!
+  bool mModified = true;                      //! since the last call to getHistogram()
+
+  ClassDefOverride(SparseHistogram, 1);
+};
+
+} // namespace o2::quality_control::core
+
+#endif // QC_CORE_SPARSEHISTOGRAM_H
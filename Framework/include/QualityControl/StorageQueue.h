@@ -0,0 +1,134 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   StorageQueue.h
+///
+
+#ifndef QC_REPOSITORY_STORAGEQUEUE_H
+#define QC_REPOSITORY_STORAGEQUEUE_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "QualityControl/DatabaseInterface.h"
+
+namespace o2::quality_control::repository
+{
+
+/// \brief Stores MonitorObjects and QualityObjects asynchronously with a pool of workers.
+///
+/// Objects are copied when they are pushed, so that the caller can keep modifying them. Pending objects with the same
+/// path are coalesced: only the latest revision is stored. Two revisions of the same path are never stored
+/// concurrently, so they reach the database in order. When the queue is full, the configured backpressure policy
+/// decides what to do with the new objects. Each worker uses its own DatabaseInterface, because the implementations
+/// are not thread-safe.
+class StorageQueue
+{
+ public:
+  /// What happens when an object is pushed to a full queue.
+  enum class BackpressurePolicy {
+    DropOldest, ///< the oldest pending object is discarded
+    Block,      ///< the caller waits until a worker takes an object
+    Spill       ///< the new object is written to a local file, it is stored once the queue is idle
+  };
+
+  struct Statistics {
+    size_t queueDepth = 0;             ///< objects waiting in memory or on disk
+    size_t stored = 0;                 ///< objects stored since the last call to getStatistics
+    size_t coalesced = 0;              ///< objects replaced by a newer revision before being stored
+    size_t dropped = 0;                ///< objects discarded because the queue was full or stopping
+    size_t spilled = 0;                ///< objects written to the spill directory
+    size_t failed = 0;                 ///< objects which could not be stored
+    double averageWriteLatencyMs = 0.; ///< average duration of a store
+    double maxWriteLatencyMs = 0.;     ///< longest duration of a store
+  };
+
+  using DatabaseCreator = std::function<std::unique_ptr<DatabaseInterface>()>;
+
+  /// \brief Starts the workers.
+  /// \param databaseCreator   Called once per worker to get a connected database.
+  /// \param workers           Number of worker threads, at least 1.
+  /// \param maxQueueSize      Maximum number of objects pending in memory, at least 1.
+  /// \param policy            Backpressure policy.
+  /// \param spillDirectory    Directory of the spilled objects, it is used only with BackpressurePolicy::Spill.
+  StorageQueue(DatabaseCreator databaseCreator, size_t workers, size_t maxQueueSize, BackpressurePolicy policy, std::string spillDirectory = "/tmp/qc_storage_spill");
+  /// Stores all the pending objects and stops the workers.
+  ~StorageQueue();
+
+  StorageQueue(const StorageQueue&) = delete;
+  StorageQueue& operator=(const StorageQueue&) = delete;
+
+  void push(std::shared_ptr<o2::quality_control::core::MonitorObject> mo);
+  void push(std::shared_ptr<o2::quality_control::core::QualityObject> qo);
+
+  /// Waits until all the pushed objects are stored (or failed to be).
+  void flush();
+
+  /// Returns the current statistics and resets the counters.
+  Statistics getStatistics();
+
+  /// \brief Converts "dropOldest", "block" or "spill" into a BackpressurePolicy.
+  /// Throws if the name is not known.
+  static BackpressurePolicy policyFromString(const std::string& name);
+
+ private:
+  struct Item {
+    std::shared_ptr<o2::quality_control::core::MonitorObject> mo;
+    std::shared_ptr<o2::quality_control::core::QualityObject> qo;
+  };
+
+  void push(const std::string& key, Item&& item);
+  /// Must be called with mMutex locked.
+  bool hasWork() const;
+  /// Must be called with mMutex locked.
+  bool isIdle() const;
+  void runWorker(DatabaseInterface* database);
+  bool store(DatabaseInterface* database, const Item& item);
+  std::string spillFilePath(const std::string& key, size_t number) const;
+  /// Must be called with mMutex locked, it is released while the file is written.
+  void spill(const std::string& key, const Item& item, std::unique_lock<std::mutex>& lock);
+  bool unspill(const std::string& file, Item& item);
+
+  const size_t mMaxQueueSize;
+  const BackpressurePolicy mPolicy;
+  const std::string mSpillDirectory;
+
+  std::mutex mMutex;
+  std::condition_variable mWorkAvailable;
+  std::condition_variable mSpaceAvailable;
+  std::condition_variable mIdle;
+  bool mStopping = false;
+  size_t mSpillCounter = 0;
+
+  std::deque<std::string> mOrder;                        // keys of mPending, oldest first
+  std::unordered_map<std::string, Item> mPending;        // object path -> latest revision
+  std::unordered_map<std::string, std::string> mSpilled; // object path -> spill file
+  std::unordered_map<std::string, size_t> mSpilling;     // object path -> number of the spill file being written
+  std::unordered_set<std::string> mInFlight;             // object paths being stored
+
+  Statistics mStatistics;
+  double mTotalWriteLatencyMs = 0.;
+
+  std::vector<std::unique_ptr<DatabaseInterface>> mDatabases;
+  std::vector<std::thread> mWorkers;
+};
+
+} // namespace o2::quality_control::repository
+
+#endif // QC_REPOSITORY_STORAGEQUEUE_H
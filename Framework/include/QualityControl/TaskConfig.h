@@ -18,6 +18,7 @@
 
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace o2::quality_control::core
 {
@@ -31,8 +32,15 @@ struct TaskConfig {
   int maxNumberCycles;
   std::string consulUrl;
   std::string conditionUrl = "";
+  std::string conditionCacheDirectory = ""; // empty for a memory-only cache
+  int conditionLatestLifetimeSeconds = 300;
   std::unordered_map<std::string, std::string> customParameters = {};
   std::string detectorName = "MISC"; // intended to be the 3 letters code
+  bool deltaPublication = false;
+  int keyframeInterval = 10;
+  std::string localSnapshotFile = "";                 // empty if the objects are not written locally
+  int localSnapshotPeriodSeconds = 0;                 // 0 to write only at the end of the run
+  std::vector<std::string> localSnapshotObjects = {}; // empty for all the objects
 };
 
 } // namespace o2::quality_control::core
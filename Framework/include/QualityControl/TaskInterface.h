@@ -17,10 +17,12 @@
 #ifndef QC_CORE_TASKINTERFACE_H
 #define QC_CORE_TASKINTERFACE_H
 
+#include <future>
 #include <map>
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 // O2
 #include <Framework/InitContext.h>
 #include <Framework/ProcessingContext.h>
@@ -28,16 +30,18 @@
 #include "QualityControl/Activity.h"
 #include "QualityControl/ObjectsManager.h"
 
-namespace o2::ccdb
+class TObject;
+
+namespace o2::monitoring
 {
-class CcdbApi;
+class Monitoring;
 }
 
-class TObject;
-
 namespace o2::quality_control::core
 {
 
+class ConditionCache;
+
 /// \brief  Skeleton of a QC task.
 ///
 /// Purely abstract class defining the skeleton and the common interface of a QC task.
@@ -71,6 +75,10 @@ class TaskInterface
   TaskInterface& operator=(TaskInterface&& other) /* noexcept */ = default; // error with gcc if noexcept
 
   virtual void loadCcdb(std::string url) final;
+  /// \brief Sets the cache used to retrieve the conditions, it can be shared with other tasks.
+  void setConditionCache(std::shared_ptr<ConditionCache> conditionCache);
+  /// \brief Sets the Monitoring used by the task runner, so that the task can send its own metrics.
+  void setMonitoring(std::shared_ptr<o2::monitoring::Monitoring> monitoring);
 
   // Definition of the methods for the template method pattern
   virtual void initialize(o2::framework::InitContext& ctx) = 0;
@@ -89,7 +97,13 @@ class TaskInterface
 
  protected:
   std::shared_ptr<ObjectsManager> getObjectsManager();
+  /// \brief Returns the Monitoring of the task runner, nullptr if there is none.
+  std::shared_ptr<o2::monitoring::Monitoring> getMonitoring();
   TObject* retrieveCondition(std::string path, std::map<std::string, std::string> metadata = {}, long timestamp = -1);
+  /// \brief Retrieves the condition in another thread, so that the task can do something else meanwhile.
+  std::future<TObject*> retrieveConditionAsync(std::string path, std::map<std::string, std::string> metadata = {}, long timestamp = -1);
+  /// \brief Retrieves several conditions concurrently. The result is in the order of the paths, with nullptr for the missing ones.
+  std::vector<TObject*> retrieveConditions(const std::vector<std::string>& paths, std::map<std::string, std::string> metadata = {}, long timestamp = -1);
 
   std::unordered_map<std::string, std::string> mCustomParameters;
 
@@ -97,7 +111,8 @@ class TaskInterface
   // TODO should we rather have a global/singleton for the objectsManager ?
   std::shared_ptr<ObjectsManager> mObjectsManager;
   std::string mName;
-  std::shared_ptr<o2::ccdb::CcdbApi> mCcdbApi;
+  std::shared_ptr<ConditionCache> mConditionCache;
+  std::shared_ptr<o2::monitoring::Monitoring> mMonitoring;
 };
 
 } // namespace o2::quality_control::core
@@ -27,6 +27,9 @@
 // QC
 #include "QualityControl/TaskConfig.h"
 #include "QualityControl/TaskInterface.h"
+#include "QualityControl/DeltaEncoder.h"
+#include "QualityControl/ConditionCache.h"
+#include "QualityControl/LocalSnapshot.h"
 
 //namespace ba = boost::accumulators;
 
@@ -116,6 +119,7 @@ class TaskRunner : public framework::Task
   void finishCycle(framework::DataAllocator& outputs);
   int publish(framework::DataAllocator& outputs);
   void publishCycleStats();
+  void takeLocalSnapshot(bool force);
 
  private:
   std::string mDeviceName;
@@ -125,6 +129,9 @@ class TaskRunner : public framework::Task
   std::shared_ptr<TaskInterface> mTask;
   bool mResetAfterPublish = false;
   std::shared_ptr<ObjectsManager> mObjectsManager;
+  std::shared_ptr<DeltaEncoder> mDeltaEncoder; // only in the delta publication mode
+  std::shared_ptr<ConditionCache> mConditionCache;
+  std::shared_ptr<LocalSnapshot> mLocalSnapshot; // only if a local snapshot file is configured
 
   std::string validateDetectorName(std::string name);
 
@@ -140,6 +147,7 @@ class TaskRunner : public framework::Task
   // stats
   int mNumberMessages = 0;
   int mNumberObjectsPublishedInCycle = 0;
+  int mNumberDeltasPublishedInCycle = 0;
   int mTotalNumberObjectsPublished = 0; // over a run
   double mLastPublicationDuration = 0;
   AliceO2::Common::Timer mTimerTotalDurationActivity;
@@ -0,0 +1,69 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   WorkerPool.h
+///
+
+#ifndef QC_CORE_WORKERPOOL_H
+#define QC_CORE_WORKERPOOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace o2::quality_control::core
+{
+
+/// \brief Fixed number of threads executing the submitted jobs in the order of submission.
+///
+/// The jobs which are queued when the pool is destroyed are executed before.
+class WorkerPool
+{
+ public:
+  explicit WorkerPool(size_t workers);
+  ~WorkerPool();
+  WorkerPool(const WorkerPool&) = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+
+  /// Queues the job and returns its result, or the exception it throws, as a future.
+  template <typename Job>
+  auto submit(Job&& job) -> std::future<decltype(job())>
+  {
+    auto task = std::make_shared<std::packaged_task<decltype(job())()>>(std::forward<Job>(job));
+    auto result = task->get_future();
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mJobs.emplace_back([task]() { (*task)(); });
+    }
+    mJobAvailable.notify_one();
+    return result;
+  }
+
+  size_t size() const { return mThreads.size(); }
+
+ private:
+  void work();
+
+  std::vector<std::thread> mThreads;
+  std::deque<std::function<void()>> mJobs;
+  std::mutex mMutex;
+  std::condition_variable mJobAvailable;
+  bool mStopping = false;
+};
+
+} // namespace o2::quality_control::core
+
+#endif // QC_CORE_WORKERPOOL_H
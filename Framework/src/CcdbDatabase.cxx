@@ -92,13 +92,155 @@ void CcdbDatabase::connect(std::string host, std::string /*database*/, std::stri
 void CcdbDatabase::connect(const std::unordered_map<std::string, std::string>& config)
 {
   mUrl = config.at("host");
+  if (config.count("maxConcurrentRequests") > 0) {
+    mMaxConcurrentRequests = std::max(std::stoul(config.at("maxConcurrentRequests")), 1ul);
+  }
   init();
 }
 
 void CcdbDatabase::init()
 {
   ccdbApi.init(mUrl);
+  // the request threads and their CcdbApi are created again for the new URL when they are needed
+  std::unique_ptr<WorkerPool> requestWorkers;
+  {
+    std::lock_guard<std::mutex> lock(mRequestMutex);
+    requestWorkers = std::move(mRequestWorkers);
+  }
+  // the pending requests give their CcdbApi back when they finish
+  requestWorkers.reset();
+  {
+    std::lock_guard<std::mutex> lock(mRequestMutex);
+    mFreeRequestApis.clear();
+    mRequestApis.clear();
+  }
   loadDeprecatedStreamerInfos();
+  // the batch and asynchronous requests (de)serialize objects in parallel
+  ROOT::EnableThreadSafety();
+}
+
+// the CcdbApi of the request executed by the current thread, nullptr outside of the requests
+static thread_local o2::ccdb::CcdbApi* requestApi = nullptr;
+
+o2::ccdb::CcdbApi& CcdbDatabase::api()
+{
+  return requestApi ? *requestApi : ccdbApi;
+}
+
+std::shared_ptr<o2::ccdb::CcdbApi> CcdbDatabase::acquireRequestApi()
+{
+  // there are as many CcdbApi as request threads, so one of them is always free
+  std::lock_guard<std::mutex> lock(mRequestMutex);
+  auto* api = mFreeRequestApis.back();
+  mFreeRequestApis.pop_back();
+  requestApi = api;
+  return std::shared_ptr<o2::ccdb::CcdbApi>(api, [this](o2::ccdb::CcdbApi* api) {
+    requestApi = nullptr;
+    std::lock_guard<std::mutex> lock(mRequestMutex);
+    mFreeRequestApis.push_back(api);
+  });
+}
+
+template <typename Request>
+auto CcdbDatabase::submitRequest(Request request) -> std::future<decltype(request())>
+{
+  {
+    std::lock_guard<std::mutex> lock(mRequestMutex);
+    if (!mRequestWorkers) {
+      for (size_t i = 0; i < mMaxConcurrentRequests; i++) {
+        mRequestApis.push_back(std::make_unique<o2::ccdb::CcdbApi>());
+        mRequestApis.back()->init(mUrl);
+        mFreeRequestApis.push_back(mRequestApis.back().get());
+      }
+      mRequestWorkers = std::make_unique<WorkerPool>(mMaxConcurrentRequests);
+    }
+  }
+  return mRequestWorkers->submit([this, request]() {
+    auto lease = acquireRequestApi();
+    return request();
+  });
+}
+
+template <typename Result, typename Request, typename Function>
+std::vector<Result> CcdbDatabase::runConcurrently(const std::vector<Request>& requests, Function function)
+{
+  std::vector<std::future<Result>> futures;
+  futures.reserve(requests.size());
+  for (const auto& request : requests) {
+    futures.push_back(submitRequest([&function, &request]() { return function(request); }));
+  }
+  // the requests refer to the arguments, they must all be finished before an exception is rethrown
+  for (auto& future : futures) {
+    future.wait();
+  }
+  std::vector<Result> results;
+  results.reserve(requests.size());
+  for (auto& future : futures) {
+    results.push_back(future.get());
+  }
+  return results;
+}
+
+void CcdbDatabase::storeMOs(const std::vector<std::shared_ptr<MonitorObject>>& mos)
+{
+  runConcurrently<bool>(mos, [this](const std::shared_ptr<MonitorObject>& mo) {
+    storeMO(mo);
+    return true;
+  });
+}
+
+void CcdbDatabase::storeQOs(const std::vector<std::shared_ptr<QualityObject>>& qos)
+{
+  runConcurrently<bool>(qos, [this](const std::shared_ptr<QualityObject>& qo) {
+    storeQO(qo);
+    return true;
+  });
+}
+
+std::future<void> CcdbDatabase::storeMOAsync(std::shared_ptr<MonitorObject> mo)
+{
+  return submitRequest([this, mo]() { storeMO(mo); });
+}
+
+std::future<void> CcdbDatabase::storeQOAsync(std::shared_ptr<QualityObject> qo)
+{
+  return submitRequest([this, qo]() { storeQO(qo); });
+}
+
+std::vector<std::shared_ptr<MonitorObject>> CcdbDatabase::retrieveMOs(const std::vector<std::pair<std::string, std::string>>& taskAndObjectNames, long timestamp)
+{
+  return runConcurrently<std::shared_ptr<MonitorObject>>(taskAndObjectNames, [this, timestamp](const std::pair<std::string, std::string>& names) {
+    return retrieveMO(names.first, names.second, timestamp);
+  });
+}
+
+std::vector<std::shared_ptr<QualityObject>> CcdbDatabase::retrieveQOs(const std::vector<std::string>& qoPaths, long timestamp)
+{
+  return runConcurrently<std::shared_ptr<QualityObject>>(qoPaths, [this, timestamp](const std::string& qoPath) {
+    return retrieveQO(qoPath, timestamp);
+  });
+}
+
+std::vector<TObject*> CcdbDatabase::retrieveTObjects(const std::vector<std::string>& paths, const std::map<std::string, std::string>& metadata, long timestamp)
+{
+  return runConcurrently<TObject*>(paths, [this, &metadata, timestamp](const std::string& path) {
+    return retrieveTObject(path, metadata, timestamp);
+  });
+}
+
+std::future<std::shared_ptr<MonitorObject>> CcdbDatabase::retrieveMOAsync(std::string taskName, std::string objectName, long timestamp)
+{
+  return submitRequest([=]() { return retrieveMO(taskName, objectName, timestamp); });
+}
+
+std::future<std::shared_ptr<QualityObject>> CcdbDatabase::retrieveQOAsync(std::string qoPath, long timestamp)
+{
+  return submitRequest([=]() { return retrieveQO(qoPath, timestamp); });
+}
+
+std::future<TObject*> CcdbDatabase::retrieveTObjectAsync(std::string path, const std::map<std::string, std::string>& metadata, long timestamp)
+{
+  return submitRequest([=]() { return retrieveTObject(path, metadata, timestamp); });
 }
 
 // Monitor object
@@ -135,7 +277,7 @@ void CcdbDatabase::storeMO(std::shared_ptr<o2::quality_control::core::MonitorObj
   metadata["qc_task_name"] = mo->getTaskName();
   metadata["ObjectType"] = mo->getObject()->IsA()->GetName(); // ObjectType says TObject and not MonitorObject due to a quirk in the API. Once fixed, remove this.
 
-  ccdbApi.storeAsTFileAny<TObject>(obj, path, metadata, from, to);
+  api().storeAsTFileAny<TObject>(obj, path, metadata, from, to);
 }
 
 void CcdbDatabase::storeQO(std::shared_ptr<QualityObject> qo)
@@ -158,16 +300,16 @@ void CcdbDatabase::storeQO(std::shared_ptr<QualityObject> qo)
   long from = getCurrentTimestamp();
   long to = getFutureTimestamp(60 * 60 * 24 * 365 * 10);
 
-  ccdbApi.storeAsTFileAny<QualityObject>(qo.get(), path, metadata, from, to);
+  api().storeAsTFileAny<QualityObject>(qo.get(), path, metadata, from, to);
 }
 
 TObject* CcdbDatabase::retrieveTObject(std::string path, std::map<std::string, std::string> const& metadata, long timestamp, std::map<std::string, std::string>* headers)
 {
   // we try first to load a TFile
-  auto* object = ccdbApi.retrieveFromTFileAny<TObject>(path, metadata, timestamp, headers);
+  auto* object = api().retrieveFromTFileAny<TObject>(path, metadata, timestamp, headers);
   if (object == nullptr) {
     // We could not open a TFile we should now try to open an object directly serialized
-    object = ccdbApi.retrieve(path, metadata, timestamp);
+    object = api().retrieve(path, metadata, timestamp);
     if (object == nullptr) {
       ILOG(Error) << "We could NOT retrieve the object " << path << "." << ENDM;
       return nullptr;
@@ -222,6 +364,7 @@ std::shared_ptr<QualityObject> CcdbDatabase::retrieveQO(std::string qoPath, long
   std::shared_ptr<QualityObject> qo(dynamic_cast<QualityObject*>(obj));
   if (qo == nullptr) {
     ILOG(Error) << "Could not cast the object " << qoPath << " to QualityObject" << ENDM;
+    return nullptr;
   }
   // TODO should we remove the headers we know are general such as ETag and qc_task_name ?
   qo->addMetadata(headers);
@@ -52,7 +52,7 @@ Check::Check(std::string checkName, std::string configurationSource)
     mOutputSpec{ "QC", Check::createCheckerDataDescription(checkName), 0 },
     mBeautify(true)
 {
-  mPolicy = [](std::map<std::string, unsigned int>) {
+  mPolicy = [](const boost::dynamic_bitset<>&, const boost::dynamic_bitset<>&) {
     // Prevent from using of uninitiated policy
     BOOST_THROW_EXCEPTION(FatalException() << errinfo_details("Policy not initiated: try to run Check::init() first"));
     return false;
@@ -122,48 +122,39 @@ void Check::initConfig(std::string checkName)
 
   // Detector name, if none use "DET"
   mCheckConfig.detectorName = checkConfig.get<std::string>("detectorName", "DET");
+
+  // Maximum duration of the check when the checks run in parallel
+  mCheckConfig.timeoutMs = checkConfig.get<int>("timeoutMs", -1);
   mLatestQuality->setDetectorName(mCheckConfig.detectorName);
 }
 
 void Check::initPolicy(std::string policyType)
 {
+  mUpdated.resize(mCheckConfig.moNames.size());
+  mAvailable.resize(mCheckConfig.moNames.size());
+
   if (policyType == "OnAll") {
     /** 
      * Run check if all MOs are updated 
      */
-
-    mPolicy = [&](std::map<std::string, unsigned int>& revisionMap) {
-      for (const auto& moname : mCheckConfig.moNames) {
-        if (revisionMap[moname] <= mMORevision) {
-          // Expect: revisionMap[notExistingKey] == 0
-          return false;
-        }
-      }
-      return true;
+    mPolicy = [](const boost::dynamic_bitset<>& updated, const boost::dynamic_bitset<>&) {
+      return updated.all();
     };
   } else if (policyType == "OnAnyNonZero") {
     /**
      * Return true if any declared MOs were updated
      * Guaranee that all declared MOs are available 
      */
-    mPolicy = [&](std::map<std::string, unsigned int>& revisionMap) {
+    mPolicy = [&](const boost::dynamic_bitset<>& updated, const boost::dynamic_bitset<>& available) {
       if (!mPolicyHelper) {
         // Check if all monitor objects are available
-        for (const auto& moname : mCheckConfig.moNames) {
-          if (!revisionMap.count(moname)) {
-            return false;
-          }
+        if (!available.all()) {
+          return false;
         }
         // From now on all MOs are available
         mPolicyHelper = true;
       }
-
-      for (const auto& moname : mCheckConfig.moNames) {
-        if (revisionMap[moname] > mMORevision) {
-          return true;
-        }
-      }
-      return false;
+      return updated.any();
     };
 
   } else if (policyType == "_OnGlobalAny") {
@@ -173,9 +164,8 @@ void Check::initPolicy(std::string policyType)
      * Might return true even if MO is not used in Check
      */
 
-    mPolicy = [](std::map<std::string, unsigned int>& revisionMap) {
+    mPolicy = [](const boost::dynamic_bitset<>&, const boost::dynamic_bitset<>&) {
       // Expecting check of this policy only if any change
-      (void)revisionMap; // Supprses Unused warning
       return true;
     };
 
@@ -186,13 +176,8 @@ void Check::initPolicy(std::string policyType)
      * Run check if any declared MOs are updated
      * Does not guarantee to contain all declared MOs 
      */
-    mPolicy = [&](std::map<std::string, unsigned int>& revisionMap) {
-      for (const auto& moname : mCheckConfig.moNames) {
-        if (revisionMap.count(moname) && revisionMap[moname] > mMORevision) {
-          return true;
-        }
-      }
-      return false;
+    mPolicy = [](const boost::dynamic_bitset<>& updated, const boost::dynamic_bitset<>&) {
+      return updated.any();
     };
   }
 }
@@ -236,7 +221,32 @@ void Check::init()
 
 bool Check::isReady(std::map<std::string, unsigned int>& revisionMap)
 {
-  return mPolicy(revisionMap);
+  for (size_t i = 0; i < mCheckConfig.moNames.size() && i < mUpdated.size(); i++) {
+    auto revision = revisionMap.find(mCheckConfig.moNames[i]);
+    mAvailable[i] = revision != revisionMap.end();
+    mUpdated[i] = mAvailable[i] && revision->second > mMORevision;
+  }
+  return mPolicy(mUpdated, mAvailable);
+}
+
+bool Check::isReady(const ObjectRegistry& registry)
+{
+  for (size_t i = 0; i < mObjectIds.size(); i++) {
+    // revision 0 means that the object was not received yet
+    auto revision = registry.getRevision(mObjectIds[i]);
+    mAvailable[i] = revision != 0;
+    mUpdated[i] = revision > mMORevision;
+  }
+  return mPolicy(mUpdated, mAvailable);
+}
+
+void Check::bind(ObjectRegistry& registry)
+{
+  mObjectIds.clear();
+  for (const auto& moName : mCheckConfig.moNames) {
+    mObjectIds.push_back(registry.intern(moName));
+  }
+  mShadowMap = IndexedObjectMap();
 }
 
 void Check::updateRevision(unsigned int revision)
@@ -246,44 +256,84 @@ void Check::updateRevision(unsigned int revision)
 
 std::shared_ptr<QualityObject> Check::check(std::map<std::string, std::shared_ptr<MonitorObject>>& moMap)
 {
-  // Check if the module with the function is loaded
-  if (mCheckInterface != nullptr) {
-    std::shared_ptr<Quality> quality;
-    if (mCheckConfig.allMOs) {
-      /* 
-       * User didn't specify the MOs.
-       * All MOs are passed, no shadowing needed.
-       */
-      mLatestQuality->updateQuality(mCheckInterface->check(&moMap));
-      // Trigger beautification
-      beautify(moMap);
-    } else {
-      /* 
-       * Shadow MOs.
-       * Don't pass MOs that weren't specified by user.
-       * The user might safely relay on getting only required MOs inside the map.
-       *
-       * Implementation: Copy to different map only required MOs.
-       */
-      std::map<std::string, std::shared_ptr<MonitorObject>> shadowMap;
-      for (auto& key : mCheckConfig.moNames) {
-        if (moMap.count(key)) {
-          // don't create empty shared_ptr
-          shadowMap.insert({ key, moMap[key] });
-        }
+  if (mCheckConfig.allMOs) {
+    /* 
+     * User didn't specify the MOs.
+     * All MOs are passed, no shadowing needed.
+     */
+    runCheck(moMap);
+  } else {
+    /* 
+     * Shadow MOs.
+     * Don't pass MOs that weren't specified by user.
+     * The user might safely relay on getting only required MOs inside the map.
+     *
+     * Implementation: Copy to different map only required MOs.
+     */
+    std::map<std::string, std::shared_ptr<MonitorObject>> shadowMap;
+    for (auto& key : mCheckConfig.moNames) {
+      if (moMap.count(key)) {
+        // don't create empty shared_ptr
+        shadowMap.insert({ key, moMap[key] });
       }
+    }
+    runCheck(shadowMap);
+  }
+  logQuality();
+  return mLatestQuality;
+}
+
+std::shared_ptr<QualityObject> Check::check(ObjectRegistry& registry)
+{
+  prepare(registry);
+  run();
+  logQuality();
+  return mLatestQuality;
+}
 
-      // Trigger loaded check and update quality of the Check.
-      mLatestQuality->updateQuality(mCheckInterface->check(&shadowMap));
-      // Trigger beautification
-      beautify(shadowMap);
+void Check::prepare(ObjectRegistry& registry)
+{
+  if (mCheckConfig.allMOs) {
+    // all MOs are passed, by ID
+    for (ObjectRegistry::Id id = 0; id < registry.size(); id++) {
+      const auto& mo = registry.getObject(id);
+      if (mo) {
+        mShadowMap.set(id, registry.getName(id), mo);
+      }
+    }
+  } else {
+    // Same shadowing as above, the entries of the map are only replaced when new versions arrive
+    for (size_t i = 0; i < mObjectIds.size(); i++) {
+      const auto& mo = registry.getObject(mObjectIds[i]);
+      if (mo) {
+        mShadowMap.set(i, mCheckConfig.moNames[i], mo);
+      }
     }
   }
-  mLogger << mCheckConfig.checkName << " Quality: " << mLatestQuality->getQuality() << AliceO2::InfoLogger::InfoLogger::endm;
+}
 
+std::shared_ptr<QualityObject> Check::run()
+{
+  runCheck(mShadowMap.get());
   return mLatestQuality;
 }
 
+void Check::runCheck(std::map<std::string, std::shared_ptr<MonitorObject>>& moMap)
+{
+  // Check if the module with the function is loaded
+  if (mCheckInterface != nullptr) {
+    // Trigger loaded check and update quality of the Check.
+    mLatestQuality->updateQuality(mCheckInterface->check(&moMap));
+    // Trigger beautification
+    beautify(moMap);
+  }
+}
+
+void Check::logQuality()
+{
+  mLogger << mCheckConfig.checkName << " Quality: " << mLatestQuality->getQuality() << AliceO2::InfoLogger::InfoLogger::endm;
+}
+
 void Check::beautify(std::map<std::string, std::shared_ptr<MonitorObject>>& moMap)
 {
   if (!mBeautify) {
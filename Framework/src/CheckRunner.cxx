@@ -23,9 +23,11 @@
 #include <memory>
 #include <functional>
 #include <algorithm>
+#include <numeric>
 #include <set>
 // ROOT
 #include <TClass.h>
+#include <TROOT.h>
 #include <TSystem.h>
 // O2
 #include <Common/Exceptions.h>
@@ -187,6 +189,9 @@ CheckRunner::CheckRunner(InputSpec input, std::string configurationSource)
 
 CheckRunner::~CheckRunner()
 {
+  // waits for the checks still running
+  mCheckWorkers.reset();
+
   // Monitoring
   if (mCollector) {
     std::chrono::duration<double> diff = endLastObject - startFirstObject;
@@ -202,9 +207,12 @@ void CheckRunner::init(framework::InitContext&)
   try {
     initDatabase();
     initMonitoring();
+    initDeltaDecoders();
     for (auto& check : mChecks) {
       check.init();
+      check.bind(mObjectRegistry);
     }
+    initCheckWorkers();
   } catch (...) {
     // catch the exceptions and print it (the ultimate caller might not know how to display it)
     ILOG(Fatal) << "Unexpected exception during initialization:\n"
@@ -233,9 +241,17 @@ void CheckRunner::run(framework::ProcessingContext& ctx)
 
       // Check if this CheckRunner stores this input
       bool store = mInputStoreSet.count(DataSpecUtils::label(input)) > 0;
+      auto decoder = mDeltaDecoders.find(input.binding);
 
       for (const auto& to : *moArray) {
         std::shared_ptr<MonitorObject> mo{ dynamic_cast<MonitorObject*>(to) };
+        if (mo && decoder != mDeltaDecoders.end()) {
+          // rebuild the full object if we received only its changes
+          mo = decoder->second->decode(mo);
+          if (!mo) {
+            continue;
+          }
+        }
 
         if (mo) {
           update(mo);
@@ -254,7 +270,7 @@ void CheckRunner::run(framework::ProcessingContext& ctx)
   }
 
   // Check if compliant with policy
-  auto triggeredChecks = check(mMonitorObjects);
+  auto triggeredChecks = check();
   store(triggeredChecks);
   send(triggeredChecks, ctx.outputs());
 
@@ -266,24 +282,32 @@ void CheckRunner::run(framework::ProcessingContext& ctx)
   if (timer.isTimeout()) {
     timer.reset(1000000); // 10 s.
     mCollector->send({ mTotalNumberHistosReceived, "objects" }, o2::monitoring::DerivedMetricMode::RATE);
+    sendStorageMetrics();
+    sendCheckMetrics();
   }
 }
 
 void CheckRunner::update(std::shared_ptr<MonitorObject> mo)
 {
-  mMonitorObjects[mo->getFullName()] = mo;
-  mMonitorObjectRevision[mo->getFullName()] = mGlobalRevision;
+  mObjectRegistry.update(mo, mGlobalRevision);
 }
 
-std::vector<Check*> CheckRunner::check(std::map<std::string, std::shared_ptr<MonitorObject>> moMap)
+std::vector<Check*> CheckRunner::check()
 {
-  mLogger << "Running " << mChecks.size() << " checks for " << moMap.size() << " monitor objects"
+  mLogger << "Running " << mChecks.size() << " checks for " << mObjectRegistry.size() << " monitor objects"
           << ENDM;
 
+  if (mCheckWorkers) {
+    return checkInParallel();
+  }
+
   std::vector<Check*> triggeredChecks;
-  for (auto& check : mChecks) {
-    if (check.isReady(mMonitorObjectRevision)) {
-      auto qualityObj = check.check(moMap);
+  for (size_t i = 0; i < mChecks.size(); i++) {
+    auto& check = mChecks[i];
+    if (check.isReady(mObjectRegistry)) {
+      auto start = steady_clock::now();
+      auto qualityObj = check.check(mObjectRegistry);
+      addCheckDuration(i, duration<double, std::milli>(steady_clock::now() - start).count());
       // Check if shared_ptr != nullptr
       if (qualityObj) {
         triggeredChecks.push_back(&check);
@@ -298,22 +322,195 @@ std::vector<Check*> CheckRunner::check(std::map<std::string, std::shared_ptr<Mon
   return triggeredChecks;
 }
 
+std::vector<Check*> CheckRunner::checkInParallel()
+{
+  std::vector<size_t> finishedChecks;
+  auto collect = [&](CheckGroup& group) {
+    // the group is released first, so that a failure does not keep it busy
+    auto running = group.running;
+    auto checks = std::move(group.runningChecks);
+    group.running = {};
+    group.started = {};
+    group.runningChecks.clear();
+    group.objectsInUse.clear();
+    mMonitorObjectStoreVector.insert(mMonitorObjectStoreVector.end(), group.deferredObjects.begin(), group.deferredObjects.end());
+    group.deferredObjects.clear();
+
+    try {
+      running.get();
+    } catch (...) {
+      ILOG(Error) << "Unexpected exception while running the checks:\n"
+                  << current_diagnostic(true) << ENDM;
+    }
+    for (auto i : checks) {
+      addCheckDuration(i, mCheckDurations[i]);
+      if (!mCheckFailures[i].empty()) {
+        ILOG(Error) << "Unexpected exception in the check '" << mChecks[i].getName() << "':\n"
+                    << mCheckFailures[i] << ENDM;
+        mCheckFailures[i].clear();
+        continue;
+      }
+      finishedChecks.push_back(i);
+    }
+  };
+
+  // the checks which did not finish in time during the previous runs
+  for (auto& group : mCheckGroups) {
+    if (group.running.valid() && group.running.wait_for(seconds(0)) == std::future_status::ready) {
+      collect(group);
+    }
+  }
+
+  // the checks are prepared here, as they must not access the registry in the workers
+  std::vector<std::vector<size_t>> batches(mCheckGroups.size());
+  for (size_t i = 0; i < mChecks.size(); i++) {
+    auto& check = mChecks[i];
+    auto& group = mCheckGroups[mCheckGroupIndex[i]];
+    if (group.running.valid()) {
+      mLogger << "The check '" << check.getName() << "' or another one using the same Monitor Objects is still running, ignoring" << ENDM;
+    } else if (check.isReady(mObjectRegistry)) {
+      check.prepare(mObjectRegistry);
+      check.updateRevision(mGlobalRevision);
+      batches[mCheckGroupIndex[i]].push_back(i);
+      if (check.isOnAllObjects()) {
+        for (ObjectRegistry::Id id = 0; id < mObjectRegistry.size(); id++) {
+          group.objectsInUse.insert(mObjectRegistry.getObject(id).get());
+        }
+      } else {
+        for (auto id : check.getObjectIds()) {
+          group.objectsInUse.insert(mObjectRegistry.getObject(id).get());
+        }
+      }
+      group.objectsInUse.erase(nullptr);
+    } else {
+      mLogger << "Monitor Objects for the check '" << check.getName() << "' are not ready, ignoring" << ENDM;
+    }
+  }
+
+  // the checks of a group run one after the other, their timeouts add up
+  std::vector<int> timeoutsMs(mCheckGroups.size(), 0); // 0 means no timeout
+  int totalTimeoutMs = 0;
+  for (size_t g = 0; g < mCheckGroups.size(); g++) {
+    bool limited = !batches[g].empty();
+    for (auto i : batches[g]) {
+      int checkTimeoutMs = mChecks[i].getTimeoutMs() >= 0 ? mChecks[i].getTimeoutMs() : mDefaultCheckTimeoutMs;
+      limited = limited && checkTimeoutMs > 0;
+      timeoutsMs[g] += checkTimeoutMs;
+    }
+    timeoutsMs[g] = limited ? timeoutsMs[g] : 0;
+    totalTimeoutMs += timeoutsMs[g];
+  }
+
+  auto dispatched = steady_clock::now();
+  for (size_t g = 0; g < mCheckGroups.size(); g++) {
+    if (batches[g].empty()) {
+      continue;
+    }
+    auto started = std::make_shared<std::promise<steady_clock::time_point>>();
+    mCheckGroups[g].started = started->get_future().share();
+    auto job = [this, checks = batches[g], started]() {
+      started->set_value(steady_clock::now());
+      for (auto i : checks) {
+        auto checkStart = steady_clock::now();
+        try {
+          mChecks[i].run();
+        } catch (...) {
+          // reported by collect, the next checks of the group still run
+          mCheckFailures[i] = current_diagnostic(true);
+        }
+        mCheckDurations[i] = duration<double, std::milli>(steady_clock::now() - checkStart).count();
+      }
+    };
+    mCheckGroups[g].runningChecks = batches[g];
+    mCheckGroups[g].running = mCheckWorkers->submit(job).share();
+  }
+
+  for (size_t g = 0; g < mCheckGroups.size(); g++) {
+    if (batches[g].empty()) {
+      continue;
+    }
+    auto& group = mCheckGroups[g];
+    if (timeoutsMs[g] > 0) {
+      std::string names;
+      for (auto i : batches[g]) {
+        names += " '" + mChecks[i].getName() + "'";
+      }
+      // the timeout of a group counts from its start, which is delayed while all the workers are busy. They are free
+      // at the latest once the groups dispatched with it used their timeouts, unless checks of previous runs are late.
+      if (group.started.wait_until(dispatched + milliseconds(totalTimeoutMs)) != std::future_status::ready) {
+        ILOG(Warning) << "The checks" << names << " did not start within " << totalTimeoutMs << " ms, as all the workers are busy, their results will be sent once they finish" << ENDM;
+        continue;
+      }
+      if (group.running.wait_until(group.started.get() + milliseconds(timeoutsMs[g])) != std::future_status::ready) {
+        for (auto i : batches[g]) {
+          mCheckStatistics[i].timeouts++;
+        }
+        ILOG(Warning) << "The checks" << names << " did not finish within " << timeoutsMs[g] << " ms, their results will be sent once they finish" << ENDM;
+        continue;
+      }
+    }
+    collect(group);
+  }
+
+  // the MOs still used by the checks are stored once they finish, as they might be beautified
+  std::vector<std::shared_ptr<MonitorObject>> storedNow;
+  for (auto& mo : mMonitorObjectStoreVector) {
+    auto group = std::find_if(mCheckGroups.begin(), mCheckGroups.end(), [&mo](const CheckGroup& group) {
+      return group.running.valid() && group.objectsInUse.count(mo.get());
+    });
+    if (group != mCheckGroups.end()) {
+      group->deferredObjects.push_back(mo);
+    } else {
+      storedNow.push_back(mo);
+    }
+  }
+  mMonitorObjectStoreVector.swap(storedNow);
+
+  // whatever the order in which they finished
+  std::sort(finishedChecks.begin(), finishedChecks.end());
+  std::vector<Check*> triggeredChecks;
+  for (auto i : finishedChecks) {
+    mLogger << mChecks[i].getName() << " Quality: " << mChecks[i].getQualityObject()->getQuality() << ENDM;
+    triggeredChecks.push_back(&mChecks[i]);
+  }
+  return triggeredChecks;
+}
+
+void CheckRunner::addCheckDuration(size_t check, double durationMs)
+{
+  auto& statistics = mCheckStatistics[check];
+  statistics.totalDurationMs += durationMs;
+  statistics.maxDurationMs = std::max(statistics.maxDurationMs, durationMs);
+  statistics.runs++;
+}
+
 void CheckRunner::store(std::vector<Check*>& checks)
 {
+  if (mStorageQueue) {
+    mLogger << "Queuing " << checks.size() << " quality objects and " << mMonitorObjectStoreVector.size() << " monitor objects for storage" << ENDM;
+    for (auto check : checks) {
+      mStorageQueue->push(check->getQualityObject());
+    }
+    for (auto mo : mMonitorObjectStoreVector) {
+      mStorageQueue->push(mo);
+    }
+    return;
+  }
+
   mLogger << "Storing " << checks.size() << " quality objects" << ENDM;
   try {
+    std::vector<std::shared_ptr<QualityObject>> qualityObjects;
     for (auto check : checks) {
-      mDatabase->storeQO(check->getQualityObject());
+      qualityObjects.push_back(check->getQualityObject());
     }
+    mDatabase->storeQOs(qualityObjects);
   } catch (boost::exception& e) {
     mLogger << "Unable to " << diagnostic_information(e) << ENDM;
   }
 
   mLogger << "Storing " << mMonitorObjectStoreVector.size() << " monitor objects" << ENDM;
   try {
-    for (auto mo : mMonitorObjectStoreVector) {
-      mDatabase->storeMO(mo);
-    }
+    mDatabase->storeMOs(mMonitorObjectStoreVector);
   } catch (boost::exception& e) {
     mLogger << "Unable to " << diagnostic_information(e) << ENDM;
   }
@@ -346,11 +543,140 @@ void CheckRunner::updateRevision()
 void CheckRunner::initDatabase()
 {
   std::unique_ptr<ConfigurationInterface> config = ConfigurationFactory::getConfiguration(mConfigurationSource);
-  mDatabase = DatabaseFactory::create(config->get<std::string>("qc.config.database.implementation"));
-  mDatabase->connect(config->getRecursiveMap("qc.config.database"));
+  auto implementation = config->get<std::string>("qc.config.database.implementation");
+  auto databaseConfig = config->getRecursiveMap("qc.config.database");
+  mDatabase = DatabaseFactory::create(implementation);
+  mDatabase->connect(databaseConfig);
   LOG(INFO) << "Database that is going to be used : ";
-  LOG(INFO) << ">> Implementation : " << config->get<std::string>("qc.config.database.implementation");
+  LOG(INFO) << ">> Implementation : " << implementation;
   LOG(INFO) << ">> Host : " << config->get<std::string>("qc.config.database.host");
+
+  if (config->get<bool>("qc.config.storage.async", false)) {
+    initStorageQueue(implementation, databaseConfig);
+  }
+}
+
+void CheckRunner::initStorageQueue(const std::string& implementation, const std::unordered_map<std::string, std::string>& databaseConfig)
+{
+  std::unique_ptr<ConfigurationInterface> config = ConfigurationFactory::getConfiguration(mConfigurationSource);
+  auto workers = config->get<int>("qc.config.storage.workers", 2);
+  auto maxQueueSize = config->get<int>("qc.config.storage.maxQueueSize", 1000);
+  auto policy = config->get<std::string>("qc.config.storage.backpressure", "block");
+  auto spillDirectory = config->get<std::string>("qc.config.storage.spillDirectory", "/tmp/qc_storage_spill");
+  if (workers <= 0 || maxQueueSize <= 0) {
+    BOOST_THROW_EXCEPTION(FatalException() << errinfo_details("Configuration error: qc.config.storage.workers and qc.config.storage.maxQueueSize must be positive"));
+  }
+
+  ILOG(Info) << "Objects are stored asynchronously by " << workers << " workers, the queue holds up to " << maxQueueSize
+             << " objects, backpressure policy: " << policy << ENDM;
+  mStorageQueue = std::make_shared<StorageQueue>(
+    [implementation, databaseConfig]() {
+      auto database = DatabaseFactory::create(implementation);
+      database->connect(databaseConfig);
+      return database;
+    },
+    workers, maxQueueSize, StorageQueue::policyFromString(policy), spillDirectory);
+}
+
+void CheckRunner::sendStorageMetrics()
+{
+  if (!mStorageQueue) {
+    return;
+  }
+  auto statistics = mStorageQueue->getStatistics();
+  mCollector->send({ statistics.queueDepth, "qc_storage_queue_depth" });
+  mCollector->send({ statistics.averageWriteLatencyMs, "qc_storage_write_latency_ms" });
+  mCollector->send({ statistics.maxWriteLatencyMs, "qc_storage_max_write_latency_ms" });
+  mCollector->send({ statistics.stored, "qc_storage_stored_objects" });
+  mCollector->send({ statistics.coalesced, "qc_storage_coalesced_objects" });
+  mCollector->send({ statistics.dropped, "qc_storage_dropped_objects" });
+  mCollector->send({ statistics.spilled, "qc_storage_spilled_objects" });
+  mCollector->send({ statistics.failed, "qc_storage_failed_objects" });
+}
+
+void CheckRunner::sendCheckMetrics()
+{
+  if (mChecks.empty()) {
+    return;
+  }
+  Metric durations{ "qc_check_duration_ms" };
+  Metric maxDurations{ "qc_check_max_duration_ms" };
+  Metric timeouts{ "qc_check_timeouts" };
+  for (size_t i = 0; i < mChecks.size(); i++) {
+    auto& statistics = mCheckStatistics[i];
+    durations.addValue(statistics.runs > 0 ? statistics.totalDurationMs / statistics.runs : 0.0, mChecks[i].getName());
+    maxDurations.addValue(statistics.maxDurationMs, mChecks[i].getName());
+    timeouts.addValue(statistics.timeouts, mChecks[i].getName());
+    statistics = CheckStatistics();
+  }
+  mCollector->send(std::move(durations));
+  mCollector->send(std::move(maxDurations));
+  mCollector->send(std::move(timeouts));
+}
+
+void CheckRunner::initCheckWorkers()
+{
+  mCheckStatistics.assign(mChecks.size(), CheckStatistics());
+  mCheckDurations.assign(mChecks.size(), 0);
+  mCheckFailures.assign(mChecks.size(), "");
+
+  std::unique_ptr<ConfigurationInterface> config = ConfigurationFactory::getConfiguration(mConfigurationSource);
+  auto workers = config->get<int>("qc.config.checks.workers", 0);
+  mDefaultCheckTimeoutMs = config->get<int>("qc.config.checks.timeoutMs", 0);
+  if (workers <= 0 || mChecks.empty()) {
+    return;
+  }
+
+  // the checks sharing MOs are in the same group, as they might beautify the same objects
+  std::vector<size_t> parent(mChecks.size());
+  std::iota(parent.begin(), parent.end(), 0);
+  auto root = [&parent](size_t i) {
+    while (parent[i] != i) {
+      i = parent[i] = parent[parent[i]];
+    }
+    return i;
+  };
+  std::unordered_map<ObjectRegistry::Id, size_t> objectUsers;
+  for (size_t i = 0; i < mChecks.size(); i++) {
+    if (mChecks[i].isOnAllObjects()) {
+      // shares the objects with all the other checks
+      for (size_t j = 0; j < mChecks.size(); j++) {
+        parent[root(j)] = root(i);
+      }
+    }
+    for (auto id : mChecks[i].getObjectIds()) {
+      auto [user, inserted] = objectUsers.emplace(id, i);
+      if (!inserted) {
+        parent[root(i)] = root(user->second);
+      }
+    }
+  }
+  std::unordered_map<size_t, size_t> groupIndices; // root -> group index
+  mCheckGroupIndex.resize(mChecks.size());
+  for (size_t i = 0; i < mChecks.size(); i++) {
+    auto [group, inserted] = groupIndices.emplace(root(i), mCheckGroups.size());
+    if (inserted) {
+      mCheckGroups.emplace_back();
+    }
+    mCheckGroupIndex[i] = group->second;
+  }
+
+  // the checks might create and modify ROOT objects in parallel
+  ROOT::EnableThreadSafety();
+  mCheckWorkers = std::make_shared<WorkerPool>(workers);
+  ILOG(Info) << "The checks run in " << workers << " threads, in " << mCheckGroups.size() << " independent groups" << ENDM;
+}
+
+void CheckRunner::initDeltaDecoders()
+{
+  std::unique_ptr<ConfigurationInterface> config = ConfigurationFactory::getConfiguration(mConfigurationSource);
+  for (const auto& input : mInputs) {
+    // the input bindings are the task names, see Check and InfrastructureGenerator
+    if (config->get<bool>("qc.tasks." + input.binding + ".deltaPublication", false)) {
+      ILOG(Info) << "Objects of the task " << input.binding << " are published as deltas, they will be decoded" << ENDM;
+      mDeltaDecoders[input.binding] = std::make_shared<DeltaDecoder>();
+    }
+  }
 }
 
 void CheckRunner::initMonitoring()
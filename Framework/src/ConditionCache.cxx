@@ -0,0 +1,303 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   ConditionCache.cxx
+///
+
+#include "QualityControl/ConditionCache.h"
+
+#include "QualityControl/QcInfoLogger.h"
+// O2
+#include <CCDB/CcdbApi.h>
+// ROOT
+#include <TFile.h>
+#include <TH1.h>
+#include <TROOT.h>
+#include <TSystem.h>
+// std
+#include <algorithm>
+#include <cctype>
+#include <sstream>
+
+using namespace std::chrono;
+
+namespace o2::quality_control::core
+{
+
+namespace
+{
+
+const char* const objectKey = "ccdb_object";
+
+long now()
+{
+  return duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
+}
+
+// histograms read from a file are attached to it, they would be deleted when it is closed
+void detach(TObject* object)
+{
+  if (object != nullptr && object->InheritsFrom(TH1::Class())) {
+    static_cast<TH1*>(object)->SetDirectory(nullptr);
+  }
+}
+
+long toLong(const std::string& value, long defaultValue)
+{
+  try {
+    return std::stol(value);
+  } catch (std::exception&) {
+    return defaultValue;
+  }
+}
+
+} // namespace
+
+ConditionCache::ConditionCache(const std::string& url, std::string cacheDirectory, std::chrono::seconds latestLifetime)
+  : ConditionCache(Fetcher(), std::move(cacheDirectory), latestLifetime)
+{
+  auto ccdbApi = std::make_shared<o2::ccdb::CcdbApi>();
+  ccdbApi->init(url);
+  if (!ccdbApi->isHostReachable()) {
+    ILOG(Warning) << "CCDB at URL '" << url << "' is not reachable." << ENDM;
+  }
+  mFetcher = [ccdbApi](const std::string& path, const std::map<std::string, std::string>& metadata, long timestamp, std::map<std::string, std::string>& headers) {
+    // the objects stored in TFiles come with their headers, in particular the validity and the ETag
+    TObject* object = ccdbApi->retrieveFromTFileAny<TObject>(path, metadata, timestamp, &headers);
+    if (object == nullptr) {
+      headers.clear();
+      object = ccdbApi->retrieve(path, metadata, timestamp);
+    }
+    return object;
+  };
+}
+
+ConditionCache::ConditionCache(Fetcher fetcher, std::string cacheDirectory, std::chrono::seconds latestLifetime)
+  : mFetcher(std::move(fetcher)), mCacheDirectory(std::move(cacheDirectory)), mLatestLifetime(latestLifetime)
+{
+  // the objects might be requested and deserialized in parallel
+  ROOT::EnableThreadSafety();
+  if (!mCacheDirectory.empty()) {
+    gSystem->mkdir(mCacheDirectory.c_str(), true);
+  }
+}
+
+ConditionCache::~ConditionCache() = default;
+
+TObject* ConditionCache::retrieve(const std::string& path, const std::map<std::string, std::string>& metadata, long timestamp)
+{
+  bool latest = timestamp < 0;
+  long validAt = latest ? now() : timestamp;
+  std::string key = path;
+  for (const auto& [name, value] : metadata) {
+    key += ";" + name + "=" + value;
+  }
+  std::string request = key + "@" + (latest ? std::string("latest") : std::to_string(timestamp));
+
+  VersionPtr version;
+  std::promise<VersionPtr> promise;
+  {
+    std::unique_lock<std::mutex> lock(mMutex);
+    version = findInMemory(key, validAt, latest);
+    if (version) {
+      mStatistics.hits++;
+    } else if (auto inFlight = mInFlight.find(request); inFlight != mInFlight.end()) {
+      mStatistics.deduplicated++;
+      auto result = inFlight->second;
+      lock.unlock();
+      version = result.get();
+    } else {
+      mInFlight[request] = promise.get_future().share();
+      lock.unlock();
+
+      try {
+        version = findOnDisk(path, key, validAt, latest);
+        bool fromDisk = version != nullptr;
+        if (!fromDisk) {
+          version = fetch(path, key, metadata, timestamp);
+        }
+        lock.lock();
+        if (fromDisk) {
+          mStatistics.diskHits++;
+        } else {
+          mStatistics.misses++;
+        }
+      } catch (...) {
+        ILOG(Error) << "Could not retrieve the condition " << path << ENDM;
+        version = nullptr;
+        lock.lock();
+        mStatistics.misses++;
+      }
+      if (version && version->validUntil > version->validFrom) {
+        auto& versions = mVersions[key];
+        // a version already known, e.g. because the latest one did not change, is replaced
+        versions.erase(std::remove_if(versions.begin(), versions.end(), [&](const VersionPtr& v) { return !v->etag.empty() && v->etag == version->etag; }), versions.end());
+        versions.push_back(version);
+      }
+      mInFlight.erase(request);
+      lock.unlock();
+      promise.set_value(version);
+    }
+  }
+
+  if (!version || !version->object) {
+    return nullptr;
+  }
+  TObject* copy = version->object->Clone();
+  detach(copy);
+  return copy;
+}
+
+void ConditionCache::clear()
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  mVersions.clear();
+}
+
+ConditionCache::Statistics ConditionCache::getStatistics()
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  auto statistics = mStatistics;
+  mStatistics = Statistics();
+  return statistics;
+}
+
+bool ConditionCache::isFresh(const Version& version) const
+{
+  return system_clock::now() - version.fetched < mLatestLifetime;
+}
+
+ConditionCache::VersionPtr ConditionCache::findInMemory(const std::string& key, long timestamp, bool latest) const
+{
+  auto versions = mVersions.find(key);
+  if (versions == mVersions.end()) {
+    return nullptr;
+  }
+  // the most recently fetched first, as the condition database returns the most recent upload
+  VersionPtr found = nullptr;
+  for (const auto& version : versions->second) {
+    if (version->validFrom <= timestamp && timestamp < version->validUntil && (!latest || isFresh(*version)) && (!found || version->fetched > found->fetched)) {
+      found = version;
+    }
+  }
+  return found;
+}
+
+std::string ConditionCache::diskDirectory(const std::string& path, const std::string& key) const
+{
+  // the same path can be requested with different metadata. FNV-1a, as the hash must not change between builds.
+  uint64_t hash = 14695981039346656037ull;
+  for (char c : key) {
+    hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+  }
+  std::stringstream directory;
+  directory << mCacheDirectory << "/" << path << "/" << std::hex << hash;
+  return directory.str();
+}
+
+ConditionCache::VersionPtr ConditionCache::findOnDisk(const std::string& path, const std::string& key, long timestamp, bool latest) const
+{
+  if (mCacheDirectory.empty()) {
+    return nullptr;
+  }
+  auto directory = diskDirectory(path, key);
+  void* directoryHandle = gSystem->OpenDirectory(directory.c_str());
+  if (directoryHandle == nullptr) {
+    return nullptr;
+  }
+
+  // the file names are <valid from>_<valid until>_<etag>.root, the modification time is the time of the fetch
+  std::string bestFile;
+  Version best{ 0, 0, "", system_clock::time_point::min(), nullptr };
+  while (const char* entry = gSystem->GetDirEntry(directoryHandle)) {
+    std::string name = entry;
+    auto first = name.find('_');
+    auto second = name.find('_', first + 1);
+    auto extension = name.rfind(".root");
+    if (first == std::string::npos || second == std::string::npos || extension == std::string::npos || extension < second || extension + 5 != name.size()) {
+      continue;
+    }
+    Version candidate{ toLong(name.substr(0, first), 0), toLong(name.substr(first + 1, second - first - 1), 0), name.substr(second + 1, extension - second - 1), {}, nullptr };
+    FileStat_t status;
+    if (gSystem->GetPathInfo((directory + "/" + name).c_str(), status) != 0) {
+      continue;
+    }
+    candidate.fetched = system_clock::from_time_t(status.fMtime);
+    if (candidate.validFrom <= timestamp && timestamp < candidate.validUntil && (!latest || isFresh(candidate)) && candidate.fetched > best.fetched) {
+      best = candidate;
+      bestFile = directory + "/" + name;
+    }
+  }
+  gSystem->FreeDirectory(directoryHandle);
+  if (bestFile.empty()) {
+    return nullptr;
+  }
+
+  std::unique_ptr<TFile> file(TFile::Open(bestFile.c_str(), "READ"));
+  if (file == nullptr || file->IsZombie()) {
+    return nullptr;
+  }
+  TObject* object = file->Get(objectKey);
+  detach(object);
+  if (object == nullptr) {
+    return nullptr;
+  }
+  auto version = std::make_shared<Version>(best);
+  version->object.reset(object);
+  ILOG(Debug) << "Condition " << path << " found in the disk cache" << ENDM;
+  return version;
+}
+
+ConditionCache::VersionPtr ConditionCache::fetch(const std::string& path, const std::string& key, const std::map<std::string, std::string>& metadata, long timestamp)
+{
+  std::map<std::string, std::string> headers;
+  TObject* object = mFetcher(path, metadata, timestamp, headers);
+  if (object == nullptr) {
+    return nullptr;
+  }
+  detach(object);
+
+  auto version = std::make_shared<Version>();
+  version->object.reset(object);
+  version->fetched = system_clock::now();
+  // without validity, the version is not cached
+  version->validFrom = headers.count("Valid-From") ? toLong(headers["Valid-From"], 0) : 0;
+  version->validUntil = headers.count("Valid-Until") ? toLong(headers["Valid-Until"], 0) : 0;
+  version->etag = headers.count("ETag") ? headers["ETag"] : "";
+  version->etag.erase(std::remove_if(version->etag.begin(), version->etag.end(), [](char c) { return !std::isalnum(c) && c != '-'; }), version->etag.end());
+
+  if (version->validUntil > version->validFrom) {
+    writeToDisk(path, key, *version);
+  }
+  return version;
+}
+
+void ConditionCache::writeToDisk(const std::string& path, const std::string& key, const Version& version) const
+{
+  if (mCacheDirectory.empty()) {
+    return;
+  }
+  auto directory = diskDirectory(path, key);
+  gSystem->mkdir(directory.c_str(), true);
+  std::string name = directory + "/" + std::to_string(version.validFrom) + "_" + std::to_string(version.validUntil) + "_" + version.etag + ".root";
+  // written under a temporary name, so that the other processes never read an incomplete file
+  std::string temporary = name + "." + std::to_string(gSystem->GetPid()) + ".tmp";
+  std::unique_ptr<TFile> file(TFile::Open(temporary.c_str(), "RECREATE"));
+  if (file == nullptr || file->IsZombie()) {
+    ILOG(Warning) << "Could not write the condition " << path << " in the disk cache" << ENDM;
+    return;
+  }
+  file->WriteTObject(version.object.get(), objectKey);
+  file->Close();
+  gSystem->Rename(temporary.c_str(), name.c_str());
+}
+
+} // namespace o2::quality_control::core
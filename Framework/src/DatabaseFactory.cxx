@@ -20,6 +20,7 @@
 // QC
 #include "QualityControl/DummyDatabase.h"
 #include "QualityControl/DatabaseFactory.h"
+#include "QualityControl/LocalDatabase.h"
 #include "QualityControl/QcInfoLogger.h"
 #ifdef _WITH_MYSQL
 #include "QualityControl/MySqlDatabase.h"
@@ -46,6 +47,9 @@ std::unique_ptr<DatabaseInterface> DatabaseFactory::create(std::string name)
     // TODO check if CCDB installed
     QcInfoLogger::GetInstance() << "CCDB backend selected" << QcInfoLogger::endm;
     return std::make_unique<CcdbDatabase>();
+  } else if (name == "Local") {
+    QcInfoLogger::GetInstance() << "Local backend selected, objects are stored in files" << QcInfoLogger::endm;
+    return std::make_unique<LocalDatabase>();
   } else if (name == "Dummy") {
     QcInfoLogger::GetInstance() << "Dummy backend selected, MonitorObjects will not be stored nor retrieved" << QcInfoLogger::endm;
     return std::make_unique<DummyDatabase>();
@@ -0,0 +1,91 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   DatabaseInterface.cxx
+///
+
+#include "QualityControl/DatabaseInterface.h"
+
+using namespace o2::quality_control::core;
+
+namespace o2::quality_control::repository
+{
+
+void DatabaseInterface::storeMOs(const std::vector<std::shared_ptr<MonitorObject>>& mos)
+{
+  for (const auto& mo : mos) {
+    storeMO(mo);
+  }
+}
+
+void DatabaseInterface::storeQOs(const std::vector<std::shared_ptr<QualityObject>>& qos)
+{
+  for (const auto& qo : qos) {
+    storeQO(qo);
+  }
+}
+
+std::future<void> DatabaseInterface::storeMOAsync(std::shared_ptr<MonitorObject> mo)
+{
+  return std::async(std::launch::deferred, [this, mo]() { storeMO(mo); });
+}
+
+std::future<void> DatabaseInterface::storeQOAsync(std::shared_ptr<QualityObject> qo)
+{
+  return std::async(std::launch::deferred, [this, qo]() { storeQO(qo); });
+}
+
+std::vector<std::shared_ptr<MonitorObject>> DatabaseInterface::retrieveMOs(const std::vector<std::pair<std::string, std::string>>& taskAndObjectNames, long timestamp)
+{
+  std::vector<std::shared_ptr<MonitorObject>> mos;
+  mos.reserve(taskAndObjectNames.size());
+  for (const auto& [taskName, objectName] : taskAndObjectNames) {
+    mos.push_back(retrieveMO(taskName, objectName, timestamp));
+  }
+  return mos;
+}
+
+std::vector<std::shared_ptr<QualityObject>> DatabaseInterface::retrieveQOs(const std::vector<std::string>& qoPaths, long timestamp)
+{
+  std::vector<std::shared_ptr<QualityObject>> qos;
+  qos.reserve(qoPaths.size());
+  for (const auto& qoPath : qoPaths) {
+    qos.push_back(retrieveQO(qoPath, timestamp));
+  }
+  return qos;
+}
+
+std::vector<TObject*> DatabaseInterface::retrieveTObjects(const std::vector<std::string>& paths, const std::map<std::string, std::string>& metadata, long timestamp)
+{
+  std::vector<TObject*> objects;
+  objects.reserve(paths.size());
+  for (const auto& path : paths) {
+    objects.push_back(retrieveTObject(path, metadata, timestamp));
+  }
+  return objects;
+}
+
+std::future<std::shared_ptr<MonitorObject>> DatabaseInterface::retrieveMOAsync(std::string taskName, std::string objectName, long timestamp)
+{
+  return std::async(std::launch::deferred, [=]() { return retrieveMO(taskName, objectName, timestamp); });
+}
+
+std::future<std::shared_ptr<QualityObject>> DatabaseInterface::retrieveQOAsync(std::string qoPath, long timestamp)
+{
+  return std::async(std::launch::deferred, [=]() { return retrieveQO(qoPath, timestamp); });
+}
+
+std::future<TObject*> DatabaseInterface::retrieveTObjectAsync(std::string path, const std::map<std::string, std::string>& metadata, long timestamp)
+{
+  return std::async(std::launch::deferred, [=]() { return retrieveTObject(path, metadata, timestamp); });
+}
+
+} // namespace o2::quality_control::repository
@@ -0,0 +1,74 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   DeltaDecoder.cxx
+///
+
+#include "QualityControl/DeltaDecoder.h"
+
+#include "QualityControl/HistogramDelta.h"
+#include "QualityControl/QcInfoLogger.h"
+// ROOT
+#include <TH1.h>
+
+namespace o2::quality_control::core
+{
+
+DeltaDecoder::DeltaDecoder() = default;
+
+DeltaDecoder::~DeltaDecoder() = default;
+
+bool DeltaDecoder::isDelta(const MonitorObject* mo)
+{
+  return mo != nullptr && dynamic_cast<HistogramDelta*>(mo->getObject()) != nullptr;
+}
+
+std::shared_ptr<MonitorObject> DeltaDecoder::decode(std::shared_ptr<MonitorObject> mo)
+{
+  auto delta = dynamic_cast<HistogramDelta*>(mo->getObject());
+  if (delta == nullptr) {
+    if (HistogramDelta::isEncodable(mo->getObject())) {
+      // a keyframe, we keep a copy as the baseline, because checks might modify the object
+      auto baseline = static_cast<TH1*>(mo->getObject()->Clone());
+      baseline->SetDirectory(nullptr);
+      mBaselines[mo->getFullName()].reset(baseline);
+    }
+    return mo;
+  }
+
+  auto baselineIt = mBaselines.find(mo->getFullName());
+  if (baselineIt == mBaselines.end()) {
+    ILOG(Warning) << "Received a delta of " << mo->getFullName() << " without its baseline, waiting for the next keyframe" << ENDM;
+    return nullptr;
+  }
+  auto baseline = baselineIt->second.get();
+
+  if (delta->isEmptyBaseline()) {
+    baseline->Reset();
+  } else if (!delta->matchesBaseline(baseline)) {
+    ILOG(Warning) << "The delta of " << mo->getFullName() << " does not match its baseline, waiting for the next keyframe" << ENDM;
+    mBaselines.erase(baselineIt);
+    return nullptr;
+  }
+  if (!delta->apply(baseline)) {
+    ILOG(Warning) << "Could not apply the delta of " << mo->getFullName() << ", waiting for the next keyframe" << ENDM;
+    mBaselines.erase(baselineIt);
+    return nullptr;
+  }
+
+  auto decodedObject = static_cast<TH1*>(baseline->Clone());
+  decodedObject->SetDirectory(nullptr);
+  auto decoded = std::make_shared<MonitorObject>(decodedObject, mo->getTaskName(), mo->getDetectorName());
+  decoded->addMetadata(mo->getMetadataMap());
+  return decoded;
+}
+
+} // namespace o2::quality_control::core
@@ -0,0 +1,94 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   DeltaEncoder.cxx
+///
+
+#include "QualityControl/DeltaEncoder.h"
+
+#include "QualityControl/HistogramDelta.h"
+// ROOT
+#include <TH1.h>
+// std
+#include <unordered_set>
+
+namespace o2::quality_control::core
+{
+
+DeltaEncoder::DeltaEncoder(int keyframeInterval) : mKeyframeInterval(keyframeInterval > 0 ? keyframeInterval : 1)
+{
+}
+
+DeltaEncoder::~DeltaEncoder() = default;
+
+std::unique_ptr<MonitorObjectCollection> DeltaEncoder::encode(const MonitorObjectCollection& objects)
+{
+  mDeltas.clear();
+  bool keyframe = mPublicationNumber % mKeyframeInterval == 0;
+  mPublicationNumber++;
+
+  auto publication = std::make_unique<MonitorObjectCollection>();
+  publication->SetOwner(false);
+  std::unordered_set<std::string> published;
+
+  for (auto tobj : objects) {
+    auto mo = dynamic_cast<MonitorObject*>(tobj);
+    if (mo == nullptr || !HistogramDelta::isEncodable(mo->getObject())) {
+      publication->Add(tobj);
+      continue;
+    }
+    auto current = static_cast<TH1*>(mo->getObject());
+    published.insert(mo->getName());
+    auto& baseline = mBaselines[mo->getName()];
+
+    if (keyframe || baseline.histogram == nullptr || !HistogramDelta::isEncodable(current, baseline.histogram.get())) {
+      baseline.histogram.reset(static_cast<TH1*>(current->Clone()));
+      baseline.histogram->SetDirectory(nullptr);
+      baseline.empty = false;
+      publication->Add(mo);
+      continue;
+    }
+
+    auto delta = HistogramDelta::create(current, baseline.empty ? nullptr : baseline.histogram.get());
+    // the baseline is updated exactly as the receiver will do it, so that rounding errors do not accumulate
+    delta->apply(baseline.histogram.get());
+    baseline.empty = false;
+
+    auto deltaMO = std::make_unique<MonitorObject>(delta, mo->getTaskName(), mo->getDetectorName());
+    deltaMO->addMetadata(mo->getMetadataMap());
+    publication->Add(deltaMO.get());
+    mDeltas.push_back(std::move(deltaMO));
+  }
+
+  // objects which are not published anymore should not take memory
+  for (auto it = mBaselines.begin(); it != mBaselines.end();) {
+    it = published.count(it->first) ? std::next(it) : mBaselines.erase(it);
+  }
+
+  return publication;
+}
+
+void DeltaEncoder::resetBaselines()
+{
+  for (auto& [name, baseline] : mBaselines) {
+    (void)name;
+    baseline.histogram->Reset();
+    baseline.empty = true;
+  }
+}
+
+void DeltaEncoder::forceKeyframe()
+{
+  mBaselines.clear();
+  mPublicationNumber = 0;
+}
+
+} // namespace o2::quality_control::core
@@ -0,0 +1,133 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   HistogramDelta.cxx
+///
+
+#include "QualityControl/HistogramDelta.h"
+
+// ROOT
+#include <TH1.h>
+#include <TProfile.h>
+#include <TProfile2D.h>
+#include <TProfile3D.h>
+
+ClassImp(o2::quality_control::core::HistogramDelta);
+
+namespace o2::quality_control::core
+{
+
+static bool sameAxis(const TAxis* a, const TAxis* b)
+{
+  return a->GetNbins() == b->GetNbins() && a->GetXmin() == b->GetXmin() && a->GetXmax() == b->GetXmax();
+}
+
+bool HistogramDelta::isEncodable(const TObject* object, const TObject* baseline)
+{
+  auto histogram = dynamic_cast<const TH1*>(object);
+  if (histogram == nullptr ||
+      object->InheritsFrom(TProfile::Class()) ||
+      object->InheritsFrom(TProfile2D::Class()) ||
+      object->InheritsFrom(TProfile3D::Class())) {
+    return false;
+  }
+  if (baseline == nullptr) {
+    return true;
+  }
+
+  auto baselineHistogram = dynamic_cast<const TH1*>(baseline);
+  return baselineHistogram != nullptr &&
+         baselineHistogram->IsA() == histogram->IsA() &&
+         baselineHistogram->GetNcells() == histogram->GetNcells() &&
+         sameAxis(baselineHistogram->GetXaxis(), histogram->GetXaxis()) &&
+         sameAxis(baselineHistogram->GetYaxis(), histogram->GetYaxis()) &&
+         sameAxis(baselineHistogram->GetZaxis(), histogram->GetZaxis());
+}
+
+HistogramDelta* HistogramDelta::create(const TH1* current, const TH1* baseline)
+{
+  auto* delta = new HistogramDelta();
+  delta->mName = current->GetName();
+  delta->mNumberOfCells = current->GetNcells();
+  delta->mEmptyBaseline = baseline == nullptr;
+  delta->mBaselineEntries = baseline ? baseline->GetEntries() : 0;
+
+  const TArrayD* currentSumw2 = current->GetSumw2N() > 0 ? current->GetSumw2() : nullptr;
+  const TArrayD* baselineSumw2 = baseline && baseline->GetSumw2N() > 0 ? baseline->GetSumw2() : nullptr;
+
+  for (Int_t bin = 0; bin < delta->mNumberOfCells; ++bin) {
+    Double_t content = current->GetBinContent(bin) - (baseline ? baseline->GetBinContent(bin) : 0.0);
+    Double_t sumw2 = 0.0;
+    if (currentSumw2) {
+      // a baseline without Sumw2 has the squares of weights equal to the contents
+      sumw2 = currentSumw2->At(bin) - (baselineSumw2 ? baselineSumw2->At(bin) : (baseline ? baseline->GetBinContent(bin) : 0.0));
+    }
+    if (content != 0.0 || sumw2 != 0.0) {
+      delta->mBins.push_back(bin);
+      delta->mContents.push_back(content);
+      if (currentSumw2) {
+        delta->mSumw2.push_back(sumw2);
+      }
+    }
+  }
+
+  Double_t currentStats[TH1::kNstat] = { 0 };
+  Double_t baselineStats[TH1::kNstat] = { 0 };
+  current->GetStats(currentStats);
+  if (baseline) {
+    baseline->GetStats(baselineStats);
+  }
+  delta->mStats.resize(TH1::kNstat);
+  for (size_t i = 0; i < TH1::kNstat; ++i) {
+    delta->mStats[i] = currentStats[i] - baselineStats[i];
+  }
+  delta->mEntries = current->GetEntries() - delta->mBaselineEntries;
+
+  return delta;
+}
+
+bool HistogramDelta::apply(TH1* target) const
+{
+  if (target == nullptr || target->GetNcells() != mNumberOfCells) {
+    return false;
+  }
+  if (!mSumw2.empty() && target->GetSumw2N() == 0) {
+    target->Sumw2();
+  }
+
+  // the statistics have to be read before modifying the bins, as they might be computed from them
+  Double_t stats[TH1::kNstat] = { 0 };
+  target->GetStats(stats);
+  Double_t entries = target->GetEntries();
+
+  TArrayD* sumw2 = target->GetSumw2N() > 0 ? target->GetSumw2() : nullptr;
+  for (size_t i = 0; i < mBins.size(); ++i) {
+    target->AddBinContent(mBins[i], mContents[i]);
+    if (sumw2) {
+      // without Sumw2 in the delta, the weights were all equal to 1
+      sumw2->AddAt(sumw2->At(mBins[i]) + (mSumw2.empty() ? mContents[i] : mSumw2[i]), mBins[i]);
+    }
+  }
+
+  for (size_t i = 0; i < mStats.size() && i < TH1::kNstat; ++i) {
+    stats[i] += mStats[i];
+  }
+  target->PutStats(stats);
+  target->SetEntries(entries + mEntries);
+  return true;
+}
+
+bool HistogramDelta::matchesBaseline(const TH1* target) const
+{
+  return target != nullptr && target->GetNcells() == mNumberOfCells && target->GetEntries() == mBaselineEntries;
+}
+
+} // namespace o2::quality_control::core
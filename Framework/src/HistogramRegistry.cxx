@@ -0,0 +1,110 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   HistogramRegistry.cxx
+///
+
+#include "QualityControl/HistogramRegistry.h"
+#include "QualityControl/SparseHistogram.h"
+
+#include <TH1.h>
+#include <TH2.h>
+
+namespace o2::quality_control::core
+{
+
+HistogramRegistry::Handle HistogramRegistry::add(TH1* histogram)
+{
+  return addEntry(Entry{ histogram, histogram, nullptr });
+}
+
+HistogramRegistry::Handle HistogramRegistry::add(SparseHistogram* histogram)
+{
+  return addEntry(Entry{ histogram, nullptr, histogram });
+}
+
+HistogramRegistry::Handle HistogramRegistry::addEntry(const Entry& entry)
+{
+  Handle handle = find(entry.object->GetName());
+  if (handle != InvalidHandle) {
+    mHistograms[handle] = entry;
+    return handle;
+  }
+  mHistograms.push_back(entry);
+  return mHistograms.size() - 1;
+}
+
+HistogramRegistry::Handle HistogramRegistry::find(const std::string& name) const
+{
+  for (size_t handle = 0; handle < mHistograms.size(); handle++) {
+    if (name == mHistograms[handle].object->GetName()) {
+      return handle;
+    }
+  }
+  return InvalidHandle;
+}
+
+void HistogramRegistry::fill(Handle handle, double x)
+{
+  auto& entry = mHistograms[handle];
+  if (entry.histogram) {
+    entry.histogram->Fill(x);
+  } else {
+    entry.sparse->Fill(x);
+  }
+}
+
+void HistogramRegistry::fill(Handle handle, double x, double y)
+{
+  static_cast<TH2*>(mHistograms[handle].histogram)->Fill(x, y);
+}
+
+void HistogramRegistry::reset()
+{
+  for (auto& entry : mHistograms) {
+    if (entry.histogram) {
+      entry.histogram->Reset();
+    } else {
+      entry.sparse->Reset();
+    }
+  }
+}
+
+HistogramRegistry::Buffer::Buffer(HistogramRegistry& registry)
+  : mRegistry(registry), mX(registry.size()), mY(registry.size())
+{
+}
+
+HistogramRegistry::Buffer::~Buffer() = default;
+
+void HistogramRegistry::Buffer::flush()
+{
+  std::lock_guard<std::mutex> lock(mRegistry.mFlushMutex);
+  for (size_t handle = 0; handle < mX.size(); handle++) {
+    auto& x = mX[handle];
+    if (x.empty()) {
+      continue;
+    }
+    auto& y = mY[handle];
+    auto& entry = mRegistry.mHistograms[handle];
+    if (entry.sparse) {
+      entry.sparse->FillN(x.size(), x.data());
+    } else if (y.empty()) {
+      entry.histogram->FillN(x.size(), x.data(), nullptr);
+    } else {
+      static_cast<TH2*>(entry.histogram)->FillN(x.size(), x.data(), y.data(), nullptr);
+    }
+    x.clear();
+    y.clear();
+  }
+}
+
+} // namespace o2::quality_control::core
@@ -22,6 +22,7 @@
 #include "QualityControl/CheckRunnerFactory.h"
 #include "QualityControl/Version.h"
 #include "QualityControl/QcInfoLogger.h"
+#include "QualityControl/MonitorObjectCollection.h"
 
 #include <boost/property_tree/ptree.hpp>
 #include <Configuration/ConfigurationFactory.h>
@@ -84,12 +85,14 @@ WorkflowSpec InfrastructureGenerator::generateLocalInfrastructure(std::string co
         }
 
         bool needsMergers = taskConfig.get_child("localMachines").size() > 1;
+        // the tasks publish the objects accumulated since the last cycle, unless the Mergers expect full objects
+        bool resetAfterPublish = needsMergers && readMergerLayers(taskConfig, taskName).front().deltaInput;
         size_t id = needsMergers ? 1 : 0;
         for (const auto& machine : taskConfig.get_child("localMachines")) {
           // We spawn a task and proxy only if we are on the right machine.
           if (machine.second.get<std::string>("") == host) {
             // Generate QC Task Runner
-            workflow.emplace_back(taskRunnerFactory.create(taskName, configurationSource, id, needsMergers));
+            workflow.emplace_back(taskRunnerFactory.create(taskName, configurationSource, id, resetAfterPublish));
             // Generate an output proxy
             // These should be removed when we are able to declare dangling output in normal DPL devices
             generateLocalTaskLocalProxy(workflow, id, taskName, taskConfig.get<std::string>("remoteMachine"), taskConfig.get<std::string>("remotePort"));
@@ -159,7 +162,8 @@ o2::framework::WorkflowSpec InfrastructureGenerator::generateRemoteInfrastructur
         // I don't expect the list of machines to be reconfigured - all of them should be declared beforehand,
         // even if some of them will be on standby.
         if (numberOfLocalMachines > 1) {
-          generateMergers(workflow, taskName, numberOfLocalMachines, taskConfig.get<double>("cycleDurationSeconds"));
+          generateMergers(workflow, taskName, numberOfLocalMachines, readMergerLayers(taskConfig, taskName),
+                          taskConfig.get<size_t>("mergerThreads", 1));
         }
 
       } else if (taskConfig.get<std::string>("location") == "remote") {
@@ -304,34 +308,116 @@ void InfrastructureGenerator::generateLocalTaskRemoteProxy(framework::WorkflowSp
 }
 
 void InfrastructureGenerator::generateMergers(framework::WorkflowSpec& workflow, std::string taskName,
-                                              size_t numberOfLocalMachines, double cycleDurationSeconds)
+                                              size_t numberOfLocalMachines, const std::vector<MergerLayerConfig>& layers,
+                                              size_t mergerThreads)
 {
-  Inputs mergerInputs;
+  Inputs layerInputs;
   for (size_t id = 1; id <= numberOfLocalMachines; id++) {
-    mergerInputs.emplace_back(
+    layerInputs.emplace_back(
       InputSpec{ { taskName + std::to_string(id) },
                  TaskRunner::createTaskDataOrigin(),
                  TaskRunner::createTaskDataDescription(taskName),
                  static_cast<SubSpec>(id) });
   }
 
-  MergerInfrastructureBuilder mergersBuilder;
-  mergersBuilder.setInfrastructureName(taskName);
-  mergersBuilder.setInputSpecs(mergerInputs);
-  mergersBuilder.setOutputSpec(
-    { { "main" }, TaskRunner::createTaskDataOrigin(), TaskRunner::createTaskDataDescription(taskName), 0 });
-  MergerConfig mergerConfig;
-  // if we are to change the mode to Full, disable reseting tasks after each cycle.
-  mergerConfig.inputObjectTimespan = { InputObjectsTimespan::LastDifference, 0 };
-  mergerConfig.publicationDecision = {
-    PublicationDecision::EachNSeconds, cycleDurationSeconds
-  };
-  mergerConfig.mergedObjectTimespan = { MergedObjectTimespan::FullHistory, 0 };
-  // for now one merger should be enough, multiple layers to be supported later
-  mergerConfig.topologySize = { TopologySize::NumberOfLayers, 1 };
-  mergersBuilder.setConfig(mergerConfig);
-
-  mergersBuilder.generateInfrastructure(workflow);
+  auto firstMerger = workflow.size();
+  for (size_t layer = 0; layer < layers.size(); layer++) {
+    const auto& layerConfig = layers[layer];
+    bool lastLayer = layer + 1 == layers.size();
+    // the last layer consists of one Merger, which publishes the objects to the CheckRunners
+    size_t fanIn = lastLayer || layerConfig.fanIn == 0 ? layerInputs.size() : layerConfig.fanIn;
+    size_t numberOfMergers = (layerInputs.size() + fanIn - 1) / fanIn;
+
+    MergerConfig mergerConfig;
+    mergerConfig.inputObjectTimespan = {
+      layerConfig.deltaInput ? InputObjectsTimespan::LastDifference : InputObjectsTimespan::FullHistory, 0
+    };
+    mergerConfig.publicationDecision = {
+      PublicationDecision::EachNSeconds, layerConfig.cycleDurationSeconds
+    };
+    // intermediate layers publish what the next one expects, the last one publishes everything merged since the start
+    bool deltaOutput = !lastLayer && layers[layer + 1].deltaInput;
+    mergerConfig.mergedObjectTimespan = {
+      deltaOutput ? MergedObjectTimespan::LastDifference : MergedObjectTimespan::FullHistory, 0
+    };
+    // each Merger of the tree is generated separately, so it can have its own inputs
+    mergerConfig.topologySize = { TopologySize::NumberOfLayers, 1 };
+
+    Inputs nextLayerInputs;
+    for (size_t id = 0; id < numberOfMergers; id++) {
+      // the inputs are spread evenly, so no Merger gets more than the fan-in
+      Inputs mergerInputs(layerInputs.begin() + id * layerInputs.size() / numberOfMergers,
+                          layerInputs.begin() + (id + 1) * layerInputs.size() / numberOfMergers);
+
+      std::string mergerName = lastLayer ? taskName : taskName + "-layer" + std::to_string(layer + 1) + "-" + std::to_string(id + 1);
+      auto outputSubSpec = lastLayer ? 0 : createMergerLayerSubSpec(layer + 1, id + 1);
+      auto outputOrigin = lastLayer ? TaskRunner::createTaskDataOrigin() : createMergerLayerDataOrigin();
+
+      MergerInfrastructureBuilder mergersBuilder;
+      mergersBuilder.setInfrastructureName(mergerName);
+      mergersBuilder.setInputSpecs(mergerInputs);
+      mergersBuilder.setOutputSpec(
+        { { "main" }, outputOrigin, TaskRunner::createTaskDataDescription(taskName), outputSubSpec });
+      mergersBuilder.setConfig(mergerConfig);
+      mergersBuilder.generateInfrastructure(workflow);
+
+      nextLayerInputs.emplace_back(
+        InputSpec{ { mergerName }, outputOrigin, TaskRunner::createTaskDataDescription(taskName), outputSubSpec });
+    }
+    layerInputs = std::move(nextLayerInputs);
+  }
+
+  // the number of merge threads is set in the process of each Merger, when it is initialised
+  if (mergerThreads > 1) {
+    for (auto merger = workflow.begin() + firstMerger; merger != workflow.end(); ++merger) {
+      if (auto init = merger->algorithm.onInit) {
+        merger->algorithm.onInit = [init, mergerThreads](InitContext& ctx) {
+          MonitorObjectCollection::setNumberOfMergeThreads(mergerThreads);
+          return init(ctx);
+        };
+      }
+    }
+  }
+}
+
+std::vector<MergerLayerConfig> InfrastructureGenerator::readMergerLayers(const boost::property_tree::ptree& taskConfig, const std::string& taskName)
+{
+  std::vector<MergerLayerConfig> layers;
+  auto cycleDurationSeconds = taskConfig.get<double>("cycleDurationSeconds");
+  if (auto layersConfig = taskConfig.get_child_optional("mergerLayers")) {
+    for (const auto& [_, layerConfig] : *layersConfig) {
+      MergerLayerConfig layer;
+      layer.fanIn = layerConfig.get<size_t>("fanIn", 0);
+      auto input = layerConfig.get<std::string>("input", "delta");
+      if (input != "delta" && input != "full") {
+        throw std::runtime_error("Configuration error: the input of the Merger layers of " + taskName + " should be 'delta' or 'full', not '" + input + "'");
+      }
+      layer.deltaInput = input == "delta";
+      if (layer.deltaInput && !layers.empty() && !layers.back().deltaInput) {
+        throw std::runtime_error("Configuration error: a Merger layer of " + taskName + " cannot get deltas from a layer which gets full objects");
+      }
+      layer.cycleDurationSeconds = layerConfig.get<double>("cycleDurationSeconds", cycleDurationSeconds);
+      layers.push_back(layer);
+    }
+  }
+  if (layers.empty()) {
+    layers.push_back({ 0, true, cycleDurationSeconds });
+  }
+  // a layer receiving full objects keeps the latest one of each input, which a histogram delta would replace
+  if (!layers.front().deltaInput && taskConfig.get<bool>("deltaPublication", false)) {
+    throw std::runtime_error("Configuration error: the task " + taskName + " cannot use the delta publication, as its first Merger layer gets full objects");
+  }
+  return layers;
+}
+
+header::DataOrigin InfrastructureGenerator::createMergerLayerDataOrigin()
+{
+  return header::DataOrigin{ "QCML" };
+}
+
+header::DataHeader::SubSpecificationType InfrastructureGenerator::createMergerLayerSubSpec(size_t layer, size_t id)
+{
+  return static_cast<SubSpec>((layer << 16) + id);
 }
 
 void InfrastructureGenerator::generateCheckRunners(framework::WorkflowSpec& workflow, std::string configurationSource)
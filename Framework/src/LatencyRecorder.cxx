@@ -0,0 +1,79 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   LatencyRecorder.cxx
+///
+
+#include "QualityControl/LatencyRecorder.h"
+
+#include <Monitoring/Monitoring.h>
+#include <TH1F.h>
+
+using o2::monitoring::Metric;
+
+namespace o2::quality_control::core
+{
+
+LatencyRecorder::LatencyRecorder(std::string name, std::vector<std::string> steps, size_t capacity, double maxUs)
+  : mName(std::move(name)), mSteps(steps.size())
+{
+  for (size_t i = 0; i < steps.size(); i++) {
+    auto& step = mSteps[i];
+    step.name = steps[i];
+    step.samples.resize(std::max<size_t>(capacity, 1));
+    step.histogram = std::make_unique<TH1F>((mName + "/" + step.name).c_str(), (step.name + " latency;#mus;samples").c_str(), 100, 0, maxUs);
+    step.histogram->SetDirectory(nullptr);
+  }
+}
+
+LatencyRecorder::~LatencyRecorder() = default;
+
+LatencyRecorder::Statistics LatencyRecorder::getStatistics(size_t step) const
+{
+  const auto& s = mSteps[step];
+  Statistics statistics;
+  statistics.count = s.count;
+  statistics.meanUs = s.count > 0 ? s.sumUs / s.count : 0.;
+  statistics.maxUs = s.maxUs;
+  return statistics;
+}
+
+TH1F* LatencyRecorder::getHistogram(size_t step) const
+{
+  return mSteps[step].histogram.get();
+}
+
+void LatencyRecorder::exportSamples(o2::monitoring::Monitoring* monitoring)
+{
+  Metric metric{ mName };
+  for (auto& step : mSteps) {
+    step.histogram->Reset();
+    size_t stored = std::min<uint64_t>(step.count, step.samples.size());
+    for (size_t i = 0; i < stored; i++) {
+      step.histogram->Fill(step.samples[i]);
+    }
+
+    auto statistics = getStatistics(&step - mSteps.data());
+    metric.addValue(statistics.count, step.name + "_count");
+    metric.addValue(statistics.meanUs, step.name + "_mean_us");
+    metric.addValue(statistics.maxUs, step.name + "_max_us");
+
+    step.next = 0;
+    step.count = 0;
+    step.sumUs = 0.;
+    step.maxUs = 0.;
+  }
+  if (monitoring) {
+    monitoring->send(std::move(metric));
+  }
+}
+
+} // namespace o2::quality_control::core
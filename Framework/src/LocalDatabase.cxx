@@ -0,0 +1,509 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   LocalDatabase.cxx
+///
+
+#include "QualityControl/LocalDatabase.h"
+
+#include "QualityControl/CcdbDatabase.h"
+#include "QualityControl/MonitorObject.h"
+#include "QualityControl/QcInfoLogger.h"
+#include "QualityControl/Version.h"
+#include <Common/Exceptions.h>
+// ROOT
+#include <TBufferFile.h>
+#include <TBufferJSON.h>
+#include <TSystem.h>
+// system
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+// std
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+
+using namespace AliceO2::Common;
+using namespace o2::quality_control::core;
+
+namespace o2::quality_control::repository
+{
+
+static_assert(std::is_trivially_copyable<LocalDatabase::IndexEntry>::value, "the index entries are written as they are");
+
+namespace
+{
+
+void writeAll(int fd, const char* data, size_t size, off_t offset)
+{
+  while (size > 0) {
+    ssize_t written = pwrite(fd, data, size, offset);
+    if (written < 0) {
+      BOOST_THROW_EXCEPTION(DatabaseException() << errinfo_details(std::string("Could not write to the local repository: ") + strerror(errno)));
+    }
+    data += written;
+    size -= written;
+    offset += written;
+  }
+}
+
+bool readAll(int fd, char* data, size_t size, off_t offset)
+{
+  while (size > 0) {
+    ssize_t read = pread(fd, data, size, offset);
+    if (read <= 0) {
+      return false;
+    }
+    data += read;
+    size -= read;
+    offset += read;
+  }
+  return true;
+}
+
+// a record of the data file is: the number of metadata, each key and value prefixed with their size, the object
+void appendString(std::string& buffer, const std::string& value)
+{
+  auto size = static_cast<uint32_t>(value.size());
+  buffer.append(reinterpret_cast<const char*>(&size), sizeof(size));
+  buffer.append(value);
+}
+
+bool extractString(const std::string& buffer, size_t& position, std::string& value)
+{
+  uint32_t size;
+  if (position + sizeof(size) > buffer.size()) {
+    return false;
+  }
+  std::memcpy(&size, buffer.data() + position, sizeof(size));
+  position += sizeof(size);
+  if (position + size > buffer.size()) {
+    return false;
+  }
+  value.assign(buffer.data() + position, size);
+  position += size;
+  return true;
+}
+
+int runFromMetadata(const std::map<std::string, std::string>& metadata)
+{
+  auto run = metadata.find("Run");
+  if (run == metadata.end()) {
+    return -1;
+  }
+  try {
+    return std::stoi(run->second);
+  } catch (std::exception&) {
+    return -1;
+  }
+}
+
+} // namespace
+
+LocalDatabase::~LocalDatabase() { closeFiles(); }
+
+void LocalDatabase::connect(std::string host, std::string /*database*/, std::string /*username*/, std::string /*password*/)
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  closeFiles();
+
+  const std::string scheme = "file://";
+  mDirectory = host.compare(0, scheme.size(), scheme) == 0 ? host.substr(scheme.size()) : host;
+  if (mDirectory.empty()) {
+    BOOST_THROW_EXCEPTION(DatabaseException() << errinfo_details("No directory given for the local repository"));
+  }
+  gSystem->mkdir(mDirectory.c_str(), true);
+
+  mDataFile = open((mDirectory + "/data.bin").c_str(), O_RDWR | O_CREAT, 0644);
+  mIndexFile = open((mDirectory + "/index.bin").c_str(), O_RDWR | O_CREAT, 0644);
+  if (mDataFile < 0 || mIndexFile < 0) {
+    closeFiles();
+    BOOST_THROW_EXCEPTION(DatabaseException() << errinfo_details("Could not open the local repository in " + mDirectory));
+  }
+  updateMapping();
+  ILOG(Info) << "Local repository in " << mDirectory << " opened, it contains " << mNumberOfEntries << " index entries" << ENDM;
+}
+
+void LocalDatabase::connect(const std::unordered_map<std::string, std::string>& config)
+{
+  connect(config.at("host"), "", "", "");
+}
+
+void LocalDatabase::closeFiles()
+{
+  if (mIndex != nullptr) {
+    munmap(const_cast<IndexEntry*>(mIndex), mMappedSize);
+    mIndex = nullptr;
+  }
+  mMappedSize = 0;
+  mNumberOfEntries = 0;
+  mVersions.clear();
+  if (mDataFile >= 0) {
+    close(mDataFile);
+    mDataFile = -1;
+  }
+  if (mIndexFile >= 0) {
+    close(mIndexFile);
+    mIndexFile = -1;
+  }
+}
+
+void LocalDatabase::disconnect()
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  closeFiles();
+}
+
+void LocalDatabase::prepareTaskDataContainer(std::string /*taskName*/)
+{
+  // NOOP, there is one index for all the objects
+}
+
+void LocalDatabase::updateMapping()
+{
+  struct stat status;
+  if (fstat(mIndexFile, &status) != 0) {
+    BOOST_THROW_EXCEPTION(DatabaseException() << errinfo_details("Could not read the index of the local repository"));
+  }
+  // an entry being written by another process is ignored until it is complete
+  size_t entries = status.st_size / sizeof(IndexEntry);
+  size_t size = entries * sizeof(IndexEntry);
+  if (size == mMappedSize) {
+    return;
+  }
+  if (mIndex != nullptr) {
+    munmap(const_cast<IndexEntry*>(mIndex), mMappedSize);
+    mIndex = nullptr;
+  }
+  void* mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, mIndexFile, 0);
+  if (mapping == MAP_FAILED) {
+    mMappedSize = 0;
+    mNumberOfEntries = 0;
+    mVersions.clear();
+    BOOST_THROW_EXCEPTION(DatabaseException() << errinfo_details("Could not map the index of the local repository"));
+  }
+  mIndex = static_cast<const IndexEntry*>(mapping);
+  mMappedSize = size;
+  size_t indexed = mNumberOfEntries;
+  mNumberOfEntries = entries;
+  indexEntries(indexed);
+}
+
+void LocalDatabase::indexEntries(size_t first)
+{
+  for (size_t i = first; i < mNumberOfEntries; i++) {
+    const IndexEntry& entry = mIndex[i];
+    auto& versions = mVersions[std::string(entry.path, strnlen(entry.path, IndexEntry::maxPathLength + 1))];
+    if (entry.type == IndexEntry::typeTruncation) {
+      versions.clear();
+      continue;
+    }
+    // the entries are appended in the order of their validity, unless several clocks are involved
+    auto position = std::upper_bound(versions.begin(), versions.end(), entry.validFrom,
+                                     [this](int64_t validFrom, size_t other) { return validFrom < mIndex[other].validFrom; });
+    versions.insert(position, i);
+  }
+}
+
+void LocalDatabase::store(const std::string& path, const TObject* object, const std::map<std::string, std::string>& metadata, long from, long to, uint32_t type)
+{
+  if (path.empty() || path.size() > IndexEntry::maxPathLength) {
+    BOOST_THROW_EXCEPTION(DatabaseException() << errinfo_details("Invalid object path for the local repository: '" + path + "'"));
+  }
+
+  std::string record;
+  auto numberOfMetadata = static_cast<uint32_t>(metadata.size());
+  record.append(reinterpret_cast<const char*>(&numberOfMetadata), sizeof(numberOfMetadata));
+  for (const auto& [key, value] : metadata) {
+    appendString(record, key);
+    appendString(record, value);
+  }
+  if (object != nullptr) {
+    TBufferFile buffer(TBuffer::kWrite);
+    buffer.WriteObject(object);
+    record.append(buffer.Buffer(), buffer.Length());
+  }
+
+  IndexEntry entry{};
+  std::strncpy(entry.path, path.c_str(), IndexEntry::maxPathLength);
+  entry.validFrom = from;
+  entry.validUntil = to;
+  entry.run = runFromMetadata(metadata);
+  entry.type = type;
+  entry.size = record.size();
+
+  std::lock_guard<std::mutex> lock(mMutex);
+  if (mDataFile < 0) {
+    BOOST_THROW_EXCEPTION(DatabaseException() << errinfo_details("The local repository is not connected"));
+  }
+  // the other processes using the same repository wait until both the record and its index entry are written
+  flock(mIndexFile, LOCK_EX);
+  try {
+    entry.offset = lseek(mDataFile, 0, SEEK_END);
+    writeAll(mDataFile, record.data(), record.size(), entry.offset);
+    off_t indexEnd = lseek(mIndexFile, 0, SEEK_END);
+    writeAll(mIndexFile, reinterpret_cast<const char*>(&entry), sizeof(entry), indexEnd - indexEnd % sizeof(IndexEntry));
+  } catch (...) {
+    flock(mIndexFile, LOCK_UN);
+    throw;
+  }
+  flock(mIndexFile, LOCK_UN);
+}
+
+void LocalDatabase::storeMO(std::shared_ptr<MonitorObject> mo)
+{
+  if (mo->getName().length() == 0 || mo->getTaskName().length() == 0) {
+    BOOST_THROW_EXCEPTION(DatabaseException() << errinfo_details("Object and task names can't be empty. Do not store. "));
+  }
+
+  // same metadata and format as in the CCDB: the object is stored unencapsulated
+  std::map<std::string, std::string> metadata;
+  metadata["qc_version"] = Version::GetQcVersion().getString();
+  auto userMetadata = mo->getMetadataMap();
+  metadata.insert(userMetadata.begin(), userMetadata.end());
+  metadata["qc_detector_name"] = mo->getDetectorName();
+  metadata["qc_task_name"] = mo->getTaskName();
+  metadata["ObjectType"] = mo->getObject()->IsA()->GetName();
+
+  store(mo->getPath(), mo->getObject(), metadata, CcdbDatabase::getCurrentTimestamp(), CcdbDatabase::getFutureTimestamp(60 * 60 * 24 * 365 * 10));
+}
+
+void LocalDatabase::storeQO(std::shared_ptr<QualityObject> qo)
+{
+  std::map<std::string, std::string> metadata;
+  metadata["qc_version"] = Version::GetQcVersion().getString();
+  metadata["qc_quality"] = std::to_string(qo->getQuality().getLevel());
+  metadata["qc_detector_name"] = qo->getDetectorName();
+  metadata["qc_check_name"] = qo->getCheckName();
+  auto userMetadata = qo->getMetadataMap();
+  metadata.insert(userMetadata.begin(), userMetadata.end());
+
+  store(qo->getPath(), qo.get(), metadata, CcdbDatabase::getCurrentTimestamp(), CcdbDatabase::getFutureTimestamp(60 * 60 * 24 * 365 * 10));
+}
+
+const LocalDatabase::IndexEntry* LocalDatabase::find(const std::string& path, long timestamp, const std::map<std::string, std::string>& metadata)
+{
+  if (mIndexFile < 0) {
+    ILOG(Error) << "The local repository is not connected" << ENDM;
+    return nullptr;
+  }
+  updateMapping();
+  if (timestamp < 0) {
+    timestamp = CcdbDatabase::getCurrentTimestamp();
+  }
+  auto versions = mVersions.find(path);
+  if (versions == mVersions.end()) {
+    return nullptr;
+  }
+  int run = metadata.count("Run") ? runFromMetadata(metadata) : -1;
+  bool otherFilters = metadata.size() > (metadata.count("Run") ? 1 : 0);
+
+  // the latest versions starting before the timestamp first
+  const auto& positions = versions->second;
+  auto end = std::upper_bound(positions.begin(), positions.end(), timestamp,
+                              [this](long t, size_t position) { return t < mIndex[position].validFrom; });
+  for (auto it = std::make_reverse_iterator(end); it != positions.rend(); ++it) {
+    const IndexEntry& entry = mIndex[*it];
+    if (entry.validUntil <= timestamp || (metadata.count("Run") && entry.run != run)) {
+      continue;
+    }
+    if (otherFilters) {
+      auto entryMetadata = readMetadata(entry);
+      bool matches = std::all_of(metadata.begin(), metadata.end(), [&](const auto& filter) {
+        return filter.first == "Run" || (entryMetadata.count(filter.first) && entryMetadata.at(filter.first) == filter.second);
+      });
+      if (!matches) {
+        continue;
+      }
+    }
+    return &entry;
+  }
+  return nullptr;
+}
+
+std::map<std::string, std::string> LocalDatabase::readMetadata(const IndexEntry& entry)
+{
+  std::map<std::string, std::string> metadata;
+  std::string record(entry.size, '\0');
+  if (!readAll(mDataFile, record.data(), record.size(), entry.offset)) {
+    ILOG(Error) << "Could not read the record of " << entry.path << " in the local repository" << ENDM;
+    return metadata;
+  }
+  uint32_t numberOfMetadata = 0;
+  std::memcpy(&numberOfMetadata, record.data(), std::min(record.size(), sizeof(numberOfMetadata)));
+  size_t position = sizeof(numberOfMetadata);
+  for (uint32_t i = 0; i < numberOfMetadata; i++) {
+    std::string key, value;
+    if (!extractString(record, position, key) || !extractString(record, position, value)) {
+      break;
+    }
+    metadata[key] = value;
+  }
+  return metadata;
+}
+
+TObject* LocalDatabase::readObject(const IndexEntry& entry)
+{
+  std::string record(entry.size, '\0');
+  if (!readAll(mDataFile, record.data(), record.size(), entry.offset)) {
+    ILOG(Error) << "Could not read the record of " << entry.path << " in the local repository" << ENDM;
+    return nullptr;
+  }
+  uint32_t numberOfMetadata = 0;
+  std::memcpy(&numberOfMetadata, record.data(), std::min(record.size(), sizeof(numberOfMetadata)));
+  size_t position = sizeof(numberOfMetadata);
+  std::string skipped;
+  for (uint32_t i = 0; i < 2 * numberOfMetadata; i++) {
+    if (!extractString(record, position, skipped)) {
+      return nullptr;
+    }
+  }
+  if (position >= record.size()) {
+    return nullptr;
+  }
+  // the buffer does not own the memory, the record is alive until the end of this method
+  TBufferFile buffer(TBuffer::kRead, record.size() - position, record.data() + position, false);
+  return buffer.ReadObject(TObject::Class());
+}
+
+TObject* LocalDatabase::retrieveTObject(std::string path, const std::map<std::string, std::string>& metadata, long timestamp, std::map<std::string, std::string>* headers)
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  auto entry = find(path, timestamp, metadata);
+  if (entry == nullptr) {
+    ILOG(Debug) << "Object " << path << " not found in the local repository" << ENDM;
+    return nullptr;
+  }
+  if (headers != nullptr) {
+    *headers = readMetadata(*entry);
+    (*headers)["Valid-From"] = std::to_string(entry->validFrom);
+    (*headers)["Valid-Until"] = std::to_string(entry->validUntil);
+  }
+  return readObject(*entry);
+}
+
+std::shared_ptr<MonitorObject> LocalDatabase::retrieveMO(std::string taskName, std::string objectName, long timestamp)
+{
+  std::string path = taskName + "/" + objectName;
+  std::map<std::string, std::string> headers;
+  TObject* obj = retrieveTObject(path, {}, timestamp, &headers);
+  if (obj == nullptr) {
+    return nullptr;
+  }
+  auto mo = std::make_shared<MonitorObject>(obj, headers["qc_task_name"], headers["qc_detector_name"]);
+  mo->addMetadata(headers);
+  return mo;
+}
+
+std::shared_ptr<QualityObject> LocalDatabase::retrieveQO(std::string qoPath, long timestamp)
+{
+  std::map<std::string, std::string> headers;
+  TObject* obj = retrieveTObject(qoPath, {}, timestamp, &headers);
+  std::shared_ptr<QualityObject> qo(dynamic_cast<QualityObject*>(obj));
+  if (qo == nullptr) {
+    if (obj != nullptr) {
+      ILOG(Error) << "Could not cast the object " << qoPath << " to QualityObject" << ENDM;
+      delete obj;
+    }
+    return nullptr;
+  }
+  qo->addMetadata(headers);
+  return qo;
+}
+
+std::string LocalDatabase::retrieveJson(std::string path, long timestamp, const std::map<std::string, std::string>& metadata)
+{
+  std::unique_ptr<TObject> object(retrieveTObject(path, metadata, timestamp));
+  if (object == nullptr) {
+    return std::string();
+  }
+  TString json = TBufferJSON::ConvertToJSON(object.get());
+  return json.Data();
+}
+
+std::string LocalDatabase::retrieveMOJson(std::string taskName, std::string objectName, long timestamp)
+{
+  return retrieveJson(taskName + "/" + objectName, timestamp, {});
+}
+
+std::string LocalDatabase::retrieveQOJson(std::string qoPath, long timestamp)
+{
+  return retrieveJson(qoPath, timestamp, {});
+}
+
+std::vector<std::string> LocalDatabase::getListing(std::string subpath)
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  if (mIndexFile < 0) {
+    return {};
+  }
+  updateMapping();
+
+  // the paths starting with subpath are contiguous in the sorted map, the truncated ones have no versions
+  std::vector<std::string> listing;
+  for (auto it = mVersions.lower_bound(subpath); it != mVersions.end() && it->first.compare(0, subpath.size(), subpath) == 0; ++it) {
+    if (!it->second.empty()) {
+      listing.push_back(it->first);
+    }
+  }
+  return listing;
+}
+
+std::vector<long> LocalDatabase::getVersions(std::string path)
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  std::vector<long> versions;
+  if (mIndexFile < 0) {
+    return versions;
+  }
+  updateMapping();
+  auto positions = mVersions.find(path);
+  if (positions == mVersions.end()) {
+    return versions;
+  }
+  for (auto it = positions->second.rbegin(); it != positions->second.rend(); ++it) {
+    versions.push_back(mIndex[*it].validFrom);
+  }
+  return versions;
+}
+
+std::vector<std::string> LocalDatabase::getPublishedObjectNames(std::string taskName)
+{
+  // as in the CCDB, the names start with a slash
+  std::vector<std::string> result;
+  for (const auto& path : getListing(taskName + "/")) {
+    result.push_back(path.substr(taskName.size()));
+  }
+  return result;
+}
+
+void LocalDatabase::truncate(std::string taskName, std::string objectName)
+{
+  ILOG(Info) << "truncating data for " << taskName << "/" << objectName << ENDM;
+
+  std::vector<std::string> paths;
+  if (objectName == "*") {
+    for (const auto& name : getPublishedObjectNames(taskName)) {
+      paths.push_back(taskName + name);
+    }
+  } else {
+    paths.push_back(taskName + "/" + objectName);
+  }
+  for (const auto& path : paths) {
+    store(path, nullptr, {}, 0, 0, IndexEntry::typeTruncation);
+  }
+}
+
+} // namespace o2::quality_control::repository
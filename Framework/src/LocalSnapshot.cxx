@@ -0,0 +1,142 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   LocalSnapshot.cxx
+///
+
+#include "QualityControl/LocalSnapshot.h"
+#include "QualityControl/MonitorObject.h"
+#include "QualityControl/MonitorObjectCollection.h"
+#include "QualityControl/QcInfoLogger.h"
+
+#include <TFile.h>
+#include <TH1.h>
+#include <TROOT.h>
+#include <TSystem.h>
+
+using namespace std::chrono;
+
+namespace o2::quality_control::core
+{
+
+LocalSnapshot::LocalSnapshot(std::string filePath, milliseconds period, std::vector<std::string> objectNames)
+  : mFilePath(std::move(filePath)),
+    mPeriod(period),
+    mObjectNames(objectNames.begin(), objectNames.end())
+{
+  // the file is written in the background thread while the task fills its objects
+  ROOT::EnableThreadSafety();
+  mThread = std::thread(&LocalSnapshot::run, this);
+}
+
+LocalSnapshot::~LocalSnapshot()
+{
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mStopping = true;
+  }
+  mSnapshotAvailable.notify_all();
+  mThread.join();
+}
+
+bool LocalSnapshot::update(const MonitorObjectCollection& objects, bool force)
+{
+  auto now = steady_clock::now();
+  if (!force && (mPeriod.count() <= 0 || (!mFirstSnapshot && now - mLastSnapshot < mPeriod))) {
+    return false;
+  }
+  mFirstSnapshot = false;
+  mLastSnapshot = now;
+
+  auto snapshot = std::make_unique<Snapshot>();
+  for (auto entry : objects) {
+    auto mo = dynamic_cast<const MonitorObject*>(entry);
+    if (mo == nullptr || mo->getObject() == nullptr) {
+      continue;
+    }
+    if (!mObjectNames.empty() && mObjectNames.count(mo->getName()) == 0) {
+      continue;
+    }
+    TObject* copy = mo->getObject()->Clone();
+    if (copy->InheritsFrom(TH1::Class())) {
+      // the copies belong to the snapshot, not to the current directory
+      static_cast<TH1*>(copy)->SetDirectory(nullptr);
+    }
+    snapshot->emplace_back(copy);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (mPending) {
+      mStatistics.replaced++;
+    }
+    mPending = std::move(snapshot);
+  }
+  mSnapshotAvailable.notify_one();
+  return true;
+}
+
+void LocalSnapshot::flush()
+{
+  std::unique_lock<std::mutex> lock(mMutex);
+  mIdle.wait(lock, [this]() { return !mPending && !mWriting; });
+}
+
+LocalSnapshot::Statistics LocalSnapshot::getStatistics() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mStatistics;
+}
+
+void LocalSnapshot::run()
+{
+  std::unique_lock<std::mutex> lock(mMutex);
+  while (true) {
+    mSnapshotAvailable.wait(lock, [this]() { return mStopping || mPending; });
+    if (!mPending) {
+      return;
+    }
+    auto snapshot = std::move(mPending);
+    mWriting = true;
+    lock.unlock();
+
+    auto start = steady_clock::now();
+    bool written = write(*snapshot);
+    double durationMs = duration_cast<microseconds>(steady_clock::now() - start).count() / 1000.;
+
+    lock.lock();
+    mWriting = false;
+    (written ? mStatistics.written : mStatistics.failed)++;
+    mStatistics.lastWriteMs = durationMs;
+    mIdle.notify_all();
+  }
+}
+
+bool LocalSnapshot::write(const Snapshot& snapshot)
+{
+  std::string temporary = mFilePath + "." + std::to_string(gSystem->GetPid()) + ".tmp";
+  std::unique_ptr<TFile> file(TFile::Open(temporary.c_str(), "RECREATE"));
+  if (file == nullptr || file->IsZombie()) {
+    ILOG(Warning) << "Could not write the local snapshot " << mFilePath << ENDM;
+    return false;
+  }
+  for (const auto& object : snapshot) {
+    file->WriteTObject(object.get(), object->GetName());
+  }
+  file->Close();
+  if (gSystem->Rename(temporary.c_str(), mFilePath.c_str()) != 0) {
+    ILOG(Warning) << "Could not move the local snapshot to " << mFilePath << ENDM;
+    return false;
+  }
+  return true;
+}
+
+} // namespace o2::quality_control::core
@@ -16,14 +16,80 @@
 #include "QualityControl/MonitorObjectCollection.h"
 
 #include "QualityControl/MonitorObject.h"
+#include "QualityControl/HistogramDelta.h"
+#include "QualityControl/DeltaDecoder.h"
+#include "QualityControl/QcInfoLogger.h"
+#include "QualityControl/WorkerPool.h"
+
+#include <TH1.h>
+#include <TROOT.h>
 
 #include <Mergers/MergerAlgorithm.h>
 
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
+
 using namespace o2::mergers;
 
 namespace o2::quality_control::core
 {
 
+namespace
+{
+std::mutex gMergeThreadsMutex;
+std::shared_ptr<WorkerPool> gMergeThreads;
+
+/// Merges the other object into the target one, returns false if a delta could not be applied.
+bool mergeObject(MonitorObject* targetMO, MonitorObject* otherMO)
+{
+  if (auto delta = dynamic_cast<HistogramDelta*>(otherMO->getObject())) {
+    // Deltas are additive, they can be applied directly on the merged object.
+    return delta->apply(dynamic_cast<TH1*>(targetMO->getObject()));
+  } else if (dynamic_cast<HistogramDelta*>(targetMO->getObject())) {
+    // The first object we got was a delta, we can start merging only from a full object.
+    if (targetMO->isIsOwner()) {
+      delete targetMO->getObject();
+    }
+    targetMO->setObject(otherMO->getObject()->Clone());
+    targetMO->setIsOwner(true);
+  } else {
+    // That might be another collection or a concrete object to be merged, we walk on the collection recursively.
+    algorithm::merge(targetMO->getObject(), otherMO->getObject());
+  }
+  return true;
+}
+
+/// Merges the objects into their targets in the given order, returns the names of the objects which failed.
+std::vector<std::string> mergeObjects(const std::vector<std::pair<MonitorObject*, MonitorObject*>>& pairs, size_t begin, size_t end)
+{
+  std::vector<std::string> failed;
+  for (size_t i = begin; i < end; i++) {
+    if (!mergeObject(pairs[i].first, pairs[i].second)) {
+      failed.emplace_back(pairs[i].second->getName());
+    }
+  }
+  return failed;
+}
+} // namespace
+
+void MonitorObjectCollection::setNumberOfMergeThreads(size_t threads)
+{
+  std::lock_guard<std::mutex> lock(gMergeThreadsMutex);
+  if (threads <= 1) {
+    gMergeThreads.reset();
+  } else if (!gMergeThreads || gMergeThreads->size() != threads) {
+    ROOT::EnableThreadSafety();
+    gMergeThreads = std::make_shared<WorkerPool>(threads);
+  }
+}
+
+size_t MonitorObjectCollection::getNumberOfMergeThreads()
+{
+  std::lock_guard<std::mutex> lock(gMergeThreadsMutex);
+  return gMergeThreads ? gMergeThreads->size() : 1;
+}
+
 void MonitorObjectCollection::merge(mergers::MergeInterface* const other)
 {
   auto otherCollection = dynamic_cast<MonitorObjectCollection*>(other); // reinterpret_cast maybe?
@@ -31,23 +97,88 @@ void MonitorObjectCollection::merge(mergers::MergeInterface* const other)
     throw std::runtime_error("The other object is not a MonitorObjectCollection");
   }
 
-  auto otherIterator = otherCollection->MakeIterator();
-  while (auto otherObject = otherIterator->Next()) {
-    if (auto targetObject = this->FindObject(otherObject->GetName())) {
+  // The first object with a given name is the merge target, as with FindObject().
+  std::unordered_map<std::string, TObject*> targets;
+  targets.reserve(this->GetEntriesFast() + otherCollection->GetEntriesFast());
+  for (auto targetObject : *this) {
+    if (targetObject) {
+      targets.emplace(targetObject->GetName(), targetObject);
+    }
+  }
+
+  // The pairs with the same target have to be merged one after another, in the order of the other collection.
+  std::unordered_map<MonitorObject*, std::vector<MonitorObject*>> othersByTarget;
+  std::vector<MonitorObject*> targetOrder;
+  for (auto otherObject : *otherCollection) {
+    if (!otherObject) {
+      continue;
+    }
+    auto target = targets.find(otherObject->GetName());
+    if (target != targets.end()) {
       auto otherMO = dynamic_cast<MonitorObject*>(otherObject);
-      auto targetMO = dynamic_cast<MonitorObject*>(targetObject);
+      auto targetMO = dynamic_cast<MonitorObject*>(target->second);
       if (otherMO && targetMO) {
-        // That might be another collection or a concrete object to be merged, we walk on the collection recursively.
-        algorithm::merge(targetMO->getObject(), otherMO->getObject());
+        auto& others = othersByTarget[targetMO];
+        if (others.empty()) {
+          targetOrder.push_back(targetMO);
+        }
+        others.push_back(otherMO);
       } else {
         throw std::runtime_error("The target object or the other object could not be casted to MonitorObject.");
       }
+    } else if (DeltaDecoder::isDelta(dynamic_cast<MonitorObject*>(otherObject))) {
+      ILOG(Warning) << "Received a delta of " << otherObject->GetName() << " before the full object, it is ignored" << ENDM;
     } else {
       // We prefer to clone instead of passing the pointer in order to simplify deleting the `other`.
-      this->Add(otherObject->Clone());
+      auto clone = otherObject->Clone();
+      this->Add(clone);
+      targets.emplace(clone->GetName(), clone);
     }
   }
-  delete otherIterator;
+
+  std::vector<std::pair<MonitorObject*, MonitorObject*>> pairs;
+  for (auto targetMO : targetOrder) {
+    for (auto otherMO : othersByTarget[targetMO]) {
+      pairs.emplace_back(targetMO, otherMO);
+    }
+  }
+
+  std::shared_ptr<WorkerPool> threads;
+  {
+    std::lock_guard<std::mutex> lock(gMergeThreadsMutex);
+    threads = gMergeThreads;
+  }
+
+  std::vector<std::string> failed;
+  if (!threads || targetOrder.size() < 2) {
+    failed = mergeObjects(pairs, 0, pairs.size());
+  } else {
+    // The pairs are split into contiguous chunks which never share a target, a few per thread to balance the load.
+    size_t chunks = std::min(targetOrder.size(), threads->size() * 4);
+    size_t pairsPerChunk = (pairs.size() + chunks - 1) / chunks;
+    std::vector<std::future<std::vector<std::string>>> results;
+    size_t begin = 0;
+    while (begin < pairs.size()) {
+      size_t end = std::min(begin + pairsPerChunk, pairs.size());
+      while (end < pairs.size() && pairs[end].first == pairs[end - 1].first) {
+        end++;
+      }
+      results.push_back(threads->submit([&pairs, begin, end]() { return mergeObjects(pairs, begin, end); }));
+      begin = end;
+    }
+    // all the jobs have to finish before an exception is propagated, they use the other collection
+    for (auto& result : results) {
+      result.wait();
+    }
+    for (auto& result : results) {
+      auto chunkFailed = result.get();
+      failed.insert(failed.end(), chunkFailed.begin(), chunkFailed.end());
+    }
+  }
+
+  for (const auto& name : failed) {
+    ILOG(Warning) << "Could not merge the delta of " << name << ", it is ignored" << ENDM;
+  }
 }
 
 } // namespace o2::quality_control::core
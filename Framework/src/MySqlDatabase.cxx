@@ -98,9 +98,7 @@ void MySqlDatabase::storeQO(std::shared_ptr<o2::quality_control::core::QualityOb
   // we execute grouped insertions. Here we just register that we should keep this mo in memory.
   mQualityObjectsQueue[qo->getName()].push_back(qo);
   queueSize++;
-  if (queueSize > 4 || lastStorage.getTime() > 10 /*sec*/) { // TODO use a configuration to set the max limits
-    storeQueue();
-  }
+  storeQueueIfNeeded();
 }
 
 void MySqlDatabase::storeMO(std::shared_ptr<o2::quality_control::core::MonitorObject> mo)
@@ -109,6 +107,31 @@ void MySqlDatabase::storeMO(std::shared_ptr<o2::quality_control::core::MonitorOb
   // we execute grouped insertions. Here we just register that we should keep this mo in memory.
   mMonitorObjectsQueue[mo->getTaskName()].push_back(mo);
   queueSize++;
+  storeQueueIfNeeded();
+}
+
+void MySqlDatabase::storeQOs(const std::vector<std::shared_ptr<o2::quality_control::core::QualityObject>>& qos)
+{
+  // the whole batch ends up in the same grouped insertions
+  for (const auto& qo : qos) {
+    mQualityObjectsQueue[qo->getName()].push_back(qo);
+  }
+  queueSize += qos.size();
+  storeQueueIfNeeded();
+}
+
+void MySqlDatabase::storeMOs(const std::vector<std::shared_ptr<o2::quality_control::core::MonitorObject>>& mos)
+{
+  // the whole batch ends up in the same grouped insertions
+  for (const auto& mo : mos) {
+    mMonitorObjectsQueue[mo->getTaskName()].push_back(mo);
+  }
+  queueSize += mos.size();
+  storeQueueIfNeeded();
+}
+
+void MySqlDatabase::storeQueueIfNeeded()
+{
   if (queueSize > 4 || lastStorage.getTime() > 10 /*sec*/) { // TODO use a configuration to set the max limits
     storeQueue();
   }
@@ -0,0 +1,83 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   ObjectRegistry.cxx
+///
+
+#include "QualityControl/ObjectRegistry.h"
+
+using namespace o2::quality_control::core;
+
+namespace o2::quality_control::checker
+{
+
+IndexedObjectMap::IndexedObjectMap(const IndexedObjectMap& other) : mMap(other.mMap)
+{
+  // the iterators of the other map cannot be reused
+  mEntries.reserve(other.mEntries.size());
+  for (const auto& entry : other.mEntries) {
+    mEntries.push_back(entry == other.mMap.end() ? mMap.end() : mMap.find(entry->first));
+  }
+}
+
+IndexedObjectMap& IndexedObjectMap::operator=(const IndexedObjectMap& other)
+{
+  if (this != &other) {
+    IndexedObjectMap copy(other);
+    mMap.swap(copy.mMap);
+    mEntries.swap(copy.mEntries);
+  }
+  return *this;
+}
+
+void IndexedObjectMap::set(size_t position, const std::string& name, std::shared_ptr<MonitorObject> mo)
+{
+  if (position >= mEntries.size()) {
+    mEntries.resize(position + 1, mMap.end());
+  }
+  if (mEntries[position] == mMap.end()) {
+    mEntries[position] = mMap.insert_or_assign(name, std::move(mo)).first;
+  } else {
+    mEntries[position]->second = std::move(mo);
+  }
+}
+
+ObjectRegistry::Id ObjectRegistry::intern(const std::string& taskName, const std::string& objectName)
+{
+  auto& taskIds = mIds[taskName];
+  auto [it, inserted] = taskIds.emplace(objectName, static_cast<Id>(mNames.size()));
+  if (inserted) {
+    mNames.push_back(taskName + "/" + objectName);
+    mRevisions.push_back(0);
+    mObjects.emplace_back();
+  }
+  return it->second;
+}
+
+ObjectRegistry::Id ObjectRegistry::intern(const std::string& fullName)
+{
+  // the task names cannot contain slashes, the object names can
+  auto separator = fullName.find('/');
+  if (separator == std::string::npos) {
+    return intern("", fullName);
+  }
+  return intern(fullName.substr(0, separator), fullName.substr(separator + 1));
+}
+
+ObjectRegistry::Id ObjectRegistry::update(const std::shared_ptr<MonitorObject>& mo, unsigned int revision)
+{
+  Id id = intern(mo->getTaskName(), mo->getName());
+  mRevisions[id] = revision;
+  mObjects[id] = mo;
+  return id;
+}
+
+} // namespace o2::quality_control::checker
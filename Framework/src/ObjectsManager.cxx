@@ -46,13 +46,25 @@ ObjectsManager::~ObjectsManager() = default;
 
 void ObjectsManager::startPublishing(TObject* object)
 {
-  if (mMonitorObjects->FindObject(object->GetName()) != 0) {
+  if (mIndex.count(object->GetName()) != 0) {
     ILOG(Warning) << "Object already being published (" << object->GetName() << ")" << ENDM;
     BOOST_THROW_EXCEPTION(DuplicateObjectError() << errinfo_object_name(object->GetName()));
   }
   auto* newObject = new MonitorObject(object, mTaskConfig.taskName, mTaskConfig.detectorName);
   newObject->setIsOwner(false);
   mMonitorObjects->Add(newObject);
+
+  uint32_t index;
+  if (mFreeEntries.empty()) {
+    index = mEntries.size();
+    mEntries.emplace_back();
+  } else {
+    index = mFreeEntries.back();
+    mFreeEntries.pop_back();
+  }
+  mEntries[index].object = newObject;
+  mIndex[object->GetName()] = index;
+  mNonOwningArrayOutdated = true;
   mUpdateServiceDiscovery = true;
 }
 
@@ -88,28 +100,58 @@ void ObjectsManager::stopPublishing(TObject* object)
 
 void ObjectsManager::stopPublishing(const string& objectName)
 {
-  auto* mo = dynamic_cast<MonitorObject*>(getMonitorObject(objectName));
-  mMonitorObjects->Remove(mo);
+  auto handle = getHandle(objectName);
+  auto& entry = mEntries[handle.index];
+  mMonitorObjects->Remove(entry.object);
+  // no hole is left in the array, it is published as it is
+  mMonitorObjects->Compress();
+  delete entry.object;
+
+  entry.object = nullptr;
+  entry.generation++;
+  mFreeEntries.push_back(handle.index);
+  mIndex.erase(objectName);
+  mNonOwningArrayOutdated = true;
+  mUpdateServiceDiscovery = true;
 }
 
 bool ObjectsManager::isBeingPublished(const string& name)
 {
-  return (mMonitorObjects->FindObject(name.c_str()) != nullptr);
+  return mIndex.count(name) != 0;
 }
 
 MonitorObject* ObjectsManager::getMonitorObject(std::string objectName)
 {
-  TObject* object = mMonitorObjects->FindObject(objectName.c_str());
-  if (object == nullptr) {
+  return mEntries[getHandle(objectName).index].object;
+}
+
+ObjectsManager::Handle ObjectsManager::getHandle(const std::string& objectName)
+{
+  auto index = mIndex.find(objectName);
+  if (index == mIndex.end()) {
     ILOG(Error) << "ObjectsManager: Unable to find object \"" << objectName << "\"" << ENDM;
     BOOST_THROW_EXCEPTION(ObjectNotFoundError() << errinfo_object_name(objectName));
   }
-  return dynamic_cast<MonitorObject*>(object);
+  return { index->second, mEntries[index->second].generation };
+}
+
+MonitorObject* ObjectsManager::getMonitorObject(Handle handle)
+{
+  if (handle.index >= mEntries.size() || mEntries[handle.index].generation != handle.generation || mEntries[handle.index].object == nullptr) {
+    ILOG(Error) << "ObjectsManager: The object of the handle is not published anymore" << ENDM;
+    BOOST_THROW_EXCEPTION(ObjectNotFoundError() << errinfo_object_name("unknown"));
+  }
+  return mEntries[handle.index].object;
 }
 
-MonitorObjectCollection* ObjectsManager::getNonOwningArray() const
+MonitorObjectCollection& ObjectsManager::getNonOwningArray()
 {
-  return new MonitorObjectCollection(*mMonitorObjects);
+  if (mNonOwningArrayOutdated) {
+    mNonOwningArray = std::make_unique<MonitorObjectCollection>(*mMonitorObjects);
+    mNonOwningArray->SetOwner(false);
+    mNonOwningArrayOutdated = false;
+  }
+  return *mNonOwningArray;
 }
 
 void ObjectsManager::addMetadata(const std::string& objectName, const std::string& key, const std::string& value)
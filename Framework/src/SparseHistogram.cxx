@@ -0,0 +1,142 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   SparseHistogram.cxx
+///
+
+#include "QualityControl/SparseHistogram.h"
+#include "QualityControl/QcInfoLogger.h"
+
+#include <TH1F.h>
+
+ClassImp(o2::quality_control::core::SparseHistogram);
+
+namespace o2::quality_control::core
+{
+
+SparseHistogram::SparseHistogram(const char* name, const char* title, Int_t nBins, Double_t xMin, Double_t xMax)
+  : TNamed(name, title),
+    mNBins(nBins),
+    mXMin(xMin),
+    mXMax(xMax),
+    mBinsPerUnit(nBins / (xMax - xMin))
+{
+}
+
+SparseHistogram::~SparseHistogram() = default;
+
+void SparseHistogram::FillN(Int_t n, const Double_t* x)
+{
+  for (Int_t i = 0; i < n; i++) {
+    Fill(x[i]);
+  }
+}
+
+Int_t SparseHistogram::addChunk(Int_t chunk)
+{
+  Int_t position = mChunks.size();
+  mChunks.push_back(chunk);
+  mContents.resize(mContents.size() + ChunkSize, 0.f);
+  mChunkPositions[chunk] = position;
+  return position;
+}
+
+void SparseHistogram::buildChunkPositions() const
+{
+  // the positions are not streamed, they are rebuilt at the first use of a deserialized histogram
+  mChunkPositions.assign((mNBins + ChunkSize - 1) / ChunkSize, -1);
+  for (size_t position = 0; position < mChunks.size(); position++) {
+    mChunkPositions[mChunks[position]] = position;
+  }
+}
+
+Double_t SparseHistogram::GetBinContent(Int_t bin) const
+{
+  if (bin <= 0) {
+    return mUnderflow;
+  }
+  if (bin > mNBins) {
+    return mOverflow;
+  }
+  if (mChunkPositions.empty()) {
+    buildChunkPositions();
+  }
+  Int_t position = mChunkPositions[(bin - 1) / ChunkSize];
+  return position < 0 ? 0. : mContents[position * ChunkSize + (bin - 1) % ChunkSize];
+}
+
+void SparseHistogram::Reset(Option_t* /*option*/)
+{
+  mEntries = 0.;
+  mUnderflow = 0.;
+  mOverflow = 0.;
+  mChunks.clear();
+  mContents.clear();
+  mChunkPositions.clear();
+  mModified = true;
+}
+
+void SparseHistogram::Draw(Option_t* option)
+{
+  getHistogram()->Draw(option);
+}
+
+void SparseHistogram::merge(mergers::MergeInterface* const other)
+{
+  auto otherHistogram = dynamic_cast<const SparseHistogram*>(other);
+  if (otherHistogram == nullptr || otherHistogram->mNBins != mNBins || otherHistogram->mXMin != mXMin ||
+      otherHistogram->mXMax != mXMax) {
+    ILOG(Error) << "Cannot merge into the SparseHistogram " << GetName()
+                << " an object which is not a SparseHistogram with the same binning" << ENDM;
+    return;
+  }
+
+  for (size_t otherPosition = 0; otherPosition < otherHistogram->mChunks.size(); otherPosition++) {
+    Int_t firstBin = otherHistogram->mChunks[otherPosition] * ChunkSize;
+    const Float_t* contents = otherHistogram->mContents.data() + otherPosition * ChunkSize;
+    for (Int_t i = 0; i < ChunkSize; i++) {
+      if (contents[i] != 0.f) {
+        addToBin(firstBin + i, contents[i]);
+      }
+    }
+  }
+  mEntries += otherHistogram->mEntries;
+  mUnderflow += otherHistogram->mUnderflow;
+  mOverflow += otherHistogram->mOverflow;
+  mModified = true;
+}
+
+TH1F* SparseHistogram::getHistogram()
+{
+  if (!mHistogram) {
+    mHistogram = std::make_unique<TH1F>(GetName(), GetTitle(), mNBins, mXMin, mXMax);
+    mHistogram->SetDirectory(nullptr);
+    mModified = true;
+  }
+  if (mModified) {
+    mHistogram->Reset();
+    mHistogram->SetBinContent(0, mUnderflow);
+    mHistogram->SetBinContent(mNBins + 1, mOverflow);
+    for (size_t position = 0; position < mChunks.size(); position++) {
+      Int_t firstBin = mChunks[position] * ChunkSize + 1;
+      for (Int_t i = 0; i < ChunkSize && firstBin + i <= mNBins; i++) {
+        mHistogram->SetBinContent(firstBin + i, mContents[position * ChunkSize + i]);
+      }
+    }
+    // the statistics are computed from the bin contents
+    mHistogram->ResetStats();
+    mHistogram->SetEntries(mEntries);
+    mModified = false;
+  }
+  return mHistogram.get();
+}
+
+} // namespace o2::quality_control::core
@@ -0,0 +1,334 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   StorageQueue.cxx
+///
+
+#include "QualityControl/StorageQueue.h"
+
+#include "QualityControl/QcInfoLogger.h"
+// ROOT
+#include <TFile.h>
+#include <TROOT.h>
+#include <TSystem.h>
+// O2
+#include <Common/Exceptions.h>
+// std
+#include <algorithm>
+#include <chrono>
+
+using namespace AliceO2::Common;
+using namespace o2::quality_control::core;
+
+namespace o2::quality_control::repository
+{
+
+StorageQueue::StorageQueue(DatabaseCreator databaseCreator, size_t workers, size_t maxQueueSize, BackpressurePolicy policy, std::string spillDirectory)
+  : mMaxQueueSize(std::max<size_t>(maxQueueSize, 1)),
+    mPolicy(policy),
+    mSpillDirectory(std::move(spillDirectory))
+{
+  // the objects are serialized in parallel
+  ROOT::EnableThreadSafety();
+
+  if (mPolicy == BackpressurePolicy::Spill && gSystem->mkdir(mSpillDirectory.c_str(), true) != 0 && gSystem->AccessPathName(mSpillDirectory.c_str())) {
+    BOOST_THROW_EXCEPTION(FatalException() << errinfo_details("Could not create the storage spill directory " + mSpillDirectory));
+  }
+
+  // the databases are created here, so that a connection failure is reported to the caller
+  for (size_t i = 0; i < std::max<size_t>(workers, 1); i++) {
+    mDatabases.push_back(databaseCreator());
+  }
+  for (auto& database : mDatabases) {
+    mWorkers.emplace_back([this, db = database.get()] { runWorker(db); });
+  }
+}
+
+StorageQueue::~StorageQueue()
+{
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mStopping = true;
+  }
+  mWorkAvailable.notify_all();
+  mSpaceAvailable.notify_all();
+  for (auto& worker : mWorkers) {
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+}
+
+void StorageQueue::push(std::shared_ptr<MonitorObject> mo)
+{
+  if (!mo) {
+    return;
+  }
+  // a deep copy, because the checks might beautify the object again while it is being stored
+  std::shared_ptr<MonitorObject> copy(dynamic_cast<MonitorObject*>(mo->Clone()));
+  copy->setIsOwner(true);
+  push(mo->getPath(), Item{ copy, nullptr });
+}
+
+void StorageQueue::push(std::shared_ptr<QualityObject> qo)
+{
+  if (!qo) {
+    return;
+  }
+  push(qo->getPath(), Item{ nullptr, std::make_shared<QualityObject>(*qo) });
+}
+
+void StorageQueue::push(const std::string& key, Item&& item)
+{
+  std::unique_lock<std::mutex> lock(mMutex);
+
+  // a newer revision makes the spilled one obsolete
+  auto spilled = mSpilled.find(key);
+  if (spilled != mSpilled.end()) {
+    gSystem->Unlink(spilled->second.c_str());
+    mSpilled.erase(spilled);
+    mStatistics.coalesced++;
+  }
+  // same for a revision still being spilled, its file is removed once written
+  if (mSpilling.erase(key)) {
+    mStatistics.coalesced++;
+  }
+
+  auto pending = mPending.find(key);
+  if (pending != mPending.end()) {
+    pending->second = std::move(item);
+    mStatistics.coalesced++;
+    return;
+  }
+
+  if (mPending.size() >= mMaxQueueSize) {
+    switch (mPolicy) {
+      case BackpressurePolicy::DropOldest:
+        mPending.erase(mOrder.front());
+        mOrder.pop_front();
+        mStatistics.dropped++;
+        break;
+      case BackpressurePolicy::Block:
+        mSpaceAvailable.wait(lock, [this] { return mPending.size() < mMaxQueueSize || mStopping; });
+        if (mPending.count(key)) {
+          // pushed by another caller in the meantime
+          mPending[key] = std::move(item);
+          mStatistics.coalesced++;
+          return;
+        }
+        if (mStopping) {
+          // the workers are leaving, the object would never be stored
+          ILOG(Warning) << "The storage queue is stopping, the object " << key << " is dropped" << ENDM;
+          mStatistics.dropped++;
+          return;
+        }
+        break;
+      case BackpressurePolicy::Spill:
+        spill(key, item, lock);
+        return;
+    }
+  }
+
+  mOrder.push_back(key);
+  mPending.emplace(key, std::move(item));
+  lock.unlock();
+  mWorkAvailable.notify_one();
+}
+
+void StorageQueue::flush()
+{
+  std::unique_lock<std::mutex> lock(mMutex);
+  mIdle.wait(lock, [this] { return isIdle(); });
+}
+
+StorageQueue::Statistics StorageQueue::getStatistics()
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  Statistics statistics = mStatistics;
+  statistics.queueDepth = mPending.size() + mSpilled.size() + mSpilling.size();
+  size_t writes = statistics.stored + statistics.failed;
+  statistics.averageWriteLatencyMs = writes > 0 ? mTotalWriteLatencyMs / writes : 0.;
+
+  mStatistics = Statistics();
+  mTotalWriteLatencyMs = 0.;
+  return statistics;
+}
+
+StorageQueue::BackpressurePolicy StorageQueue::policyFromString(const std::string& name)
+{
+  if (name == "dropOldest") {
+    return BackpressurePolicy::DropOldest;
+  } else if (name == "block") {
+    return BackpressurePolicy::Block;
+  } else if (name == "spill") {
+    return BackpressurePolicy::Spill;
+  }
+  BOOST_THROW_EXCEPTION(FatalException() << errinfo_details("Unknown storage backpressure policy: " + name));
+}
+
+bool StorageQueue::hasWork() const
+{
+  auto isFree = [this](const std::string& key) { return mInFlight.count(key) == 0; };
+  return std::any_of(mOrder.begin(), mOrder.end(), isFree) ||
+         std::any_of(mSpilled.begin(), mSpilled.end(), [&](const auto& spilled) { return isFree(spilled.first); });
+}
+
+bool StorageQueue::isIdle() const
+{
+  return mPending.empty() && mSpilled.empty() && mSpilling.empty() && mInFlight.empty();
+}
+
+void StorageQueue::runWorker(DatabaseInterface* database)
+{
+  while (true) {
+    std::string key;
+    Item item;
+    std::string spillFile;
+    {
+      std::unique_lock<std::mutex> lock(mMutex);
+      mWorkAvailable.wait(lock, [this] { return mStopping || hasWork(); });
+      if (!hasWork()) {
+        // stopping, the objects in flight are handled by the other workers
+        return;
+      }
+
+      // objects in memory go first, the spilled ones are taken when there is nothing else to do
+      auto next = std::find_if(mOrder.begin(), mOrder.end(), [this](const std::string& k) { return mInFlight.count(k) == 0; });
+      if (next != mOrder.end()) {
+        key = *next;
+        mOrder.erase(next);
+        auto pending = mPending.find(key);
+        item = std::move(pending->second);
+        mPending.erase(pending);
+      } else {
+        auto spilled = std::find_if(mSpilled.begin(), mSpilled.end(), [this](const auto& s) { return mInFlight.count(s.first) == 0; });
+        key = spilled->first;
+        spillFile = spilled->second;
+        mSpilled.erase(spilled);
+      }
+      mInFlight.insert(key);
+    }
+    mSpaceAvailable.notify_one();
+
+    bool success = false;
+    auto start = std::chrono::steady_clock::now();
+    if (spillFile.empty() || unspill(spillFile, item)) {
+      success = store(database, item);
+    }
+    double latencyMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mInFlight.erase(key);
+      if (success) {
+        mStatistics.stored++;
+      } else {
+        mStatistics.failed++;
+      }
+      mTotalWriteLatencyMs += latencyMs;
+      mStatistics.maxWriteLatencyMs = std::max(mStatistics.maxWriteLatencyMs, latencyMs);
+    }
+    // another revision of this object might be waiting for it
+    mWorkAvailable.notify_all();
+    mIdle.notify_all();
+  }
+}
+
+bool StorageQueue::store(DatabaseInterface* database, const Item& item)
+{
+  try {
+    if (item.mo) {
+      database->storeMO(item.mo);
+    } else if (item.qo) {
+      database->storeQO(item.qo);
+    }
+    return true;
+  } catch (boost::exception& e) {
+    ILOG(Error) << "Unable to store an object: " << diagnostic_information(e) << ENDM;
+  } catch (std::exception& e) {
+    ILOG(Error) << "Unable to store an object: " << e.what() << ENDM;
+  }
+  return false;
+}
+
+std::string StorageQueue::spillFilePath(const std::string& key, size_t number) const
+{
+  // the file names are unique, so that a worker can read a spilled object while a newer revision is spilled
+  std::string fileName = key;
+  std::replace(fileName.begin(), fileName.end(), '/', '_');
+  return mSpillDirectory + "/" + fileName + "_" + std::to_string(number) + ".root";
+}
+
+void StorageQueue::spill(const std::string& key, const Item& item, std::unique_lock<std::mutex>& lock)
+{
+  // the item is our own copy, so it is written without holding the lock, which would block the workers and the other callers
+  size_t number = mSpillCounter++;
+  mSpilling[key] = number;
+  lock.unlock();
+
+  auto path = spillFilePath(key, number);
+  bool written = false;
+  std::unique_ptr<TFile> file(TFile::Open(path.c_str(), "RECREATE"));
+  if (file == nullptr || file->IsZombie()) {
+    ILOG(Error) << "Could not open the spill file " << path << ", the object " << key << " is dropped" << ENDM;
+  } else {
+    TObject* object = item.mo ? static_cast<TObject*>(item.mo.get()) : static_cast<TObject*>(item.qo.get());
+    file->WriteTObject(object, "object");
+    file->Close();
+    written = true;
+  }
+
+  lock.lock();
+  auto spilling = mSpilling.find(key);
+  if (spilling == mSpilling.end() || spilling->second != number) {
+    // a newer revision was pushed in the meantime, it was already counted as coalesced
+    if (written) {
+      gSystem->Unlink(path.c_str());
+    }
+  } else {
+    mSpilling.erase(spilling);
+    if (written) {
+      mSpilled[key] = path;
+      mStatistics.spilled++;
+    } else {
+      mStatistics.dropped++;
+    }
+  }
+  lock.unlock();
+  mWorkAvailable.notify_one();
+  mIdle.notify_all();
+}
+
+bool StorageQueue::unspill(const std::string& path, Item& item)
+{
+  std::unique_ptr<TFile> file(TFile::Open(path.c_str(), "READ"));
+  if (file == nullptr || file->IsZombie()) {
+    ILOG(Error) << "Could not open the spill file " << path << ENDM;
+    return false;
+  }
+  TObject* object = file->Get("object");
+  file->Close();
+  gSystem->Unlink(path.c_str());
+
+  if (auto mo = dynamic_cast<MonitorObject*>(object)) {
+    mo->setIsOwner(true);
+    item.mo.reset(mo);
+  } else if (auto qo = dynamic_cast<QualityObject*>(object)) {
+    item.qo.reset(qo);
+  } else {
+    ILOG(Error) << "The spill file " << path << " does not contain a QC object" << ENDM;
+    delete object;
+    return false;
+  }
+  return true;
+}
+
+} // namespace o2::quality_control::repository
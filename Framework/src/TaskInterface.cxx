@@ -15,10 +15,8 @@
 ///
 
 #include "QualityControl/TaskInterface.h"
+#include "QualityControl/ConditionCache.h"
 #include "QualityControl/QcInfoLogger.h"
-#include <CCDB/CcdbApi.h>
-
-using namespace o2::ccdb;
 
 namespace o2::quality_control::core
 {
@@ -38,14 +36,17 @@ void TaskInterface::setObjectsManager(std::shared_ptr<ObjectsManager> objectsMan
 
 void TaskInterface::loadCcdb(std::string url)
 {
-  if (!mCcdbApi) {
-    mCcdbApi = std::make_shared<CcdbApi>();
-  }
+  mConditionCache = std::make_shared<ConditionCache>(url);
+}
 
-  mCcdbApi->init(url);
-  if (!mCcdbApi->isHostReachable()) {
-    ILOG(Warning) << "CCDB at URL '" << url << "' is not reachable." << ENDM;
-  }
+void TaskInterface::setConditionCache(std::shared_ptr<ConditionCache> conditionCache)
+{
+  mConditionCache = conditionCache;
+}
+
+void TaskInterface::setMonitoring(std::shared_ptr<o2::monitoring::Monitoring> monitoring)
+{
+  mMonitoring = monitoring;
 }
 
 void TaskInterface::setCustomParameters(const std::unordered_map<std::string, std::string>& parameters)
@@ -55,14 +56,43 @@ void TaskInterface::setCustomParameters(const std::unordered_map<std::string, st
 
 TObject* TaskInterface::retrieveCondition(std::string path, std::map<std::string, std::string> metadata, long timestamp)
 {
-  if (mCcdbApi) {
-    return mCcdbApi->retrieve(path, metadata, timestamp);
+  if (mConditionCache) {
+    return mConditionCache->retrieve(path, metadata, timestamp);
   } else {
     ILOG(Error) << "Trying to retrieve a condition, but CCDB API is not constructed." << ENDM;
     return nullptr;
   }
 }
 
+std::future<TObject*> TaskInterface::retrieveConditionAsync(std::string path, std::map<std::string, std::string> metadata, long timestamp)
+{
+  if (!mConditionCache) {
+    ILOG(Error) << "Trying to retrieve a condition, but CCDB API is not constructed." << ENDM;
+    std::promise<TObject*> none;
+    none.set_value(nullptr);
+    return none.get_future();
+  }
+  // the shared cache is kept alive until the request is over
+  return std::async(std::launch::async, [conditionCache = mConditionCache, path, metadata, timestamp]() {
+    return conditionCache->retrieve(path, metadata, timestamp);
+  });
+}
+
+std::vector<TObject*> TaskInterface::retrieveConditions(const std::vector<std::string>& paths, std::map<std::string, std::string> metadata, long timestamp)
+{
+  std::vector<std::future<TObject*>> requests;
+  for (const auto& path : paths) {
+    requests.push_back(retrieveConditionAsync(path, metadata, timestamp));
+  }
+  std::vector<TObject*> conditions;
+  for (auto& request : requests) {
+    conditions.push_back(request.get());
+  }
+  return conditions;
+}
+
 std::shared_ptr<ObjectsManager> TaskInterface::getObjectsManager() { return mObjectsManager; }
 
+std::shared_ptr<o2::monitoring::Monitoring> TaskInterface::getMonitoring() { return mMonitoring; }
+
 } // namespace o2::quality_control::core
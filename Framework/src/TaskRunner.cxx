@@ -84,12 +84,24 @@ void TaskRunner::init(InitContext& iCtx)
   // setup publisher
   mObjectsManager = std::make_shared<ObjectsManager>(mTaskConfig);
 
+  // setup delta publication
+  if (mTaskConfig.deltaPublication) {
+    mDeltaEncoder = std::make_shared<DeltaEncoder>(mTaskConfig.keyframeInterval);
+  }
+
+  // setup local snapshots
+  if (!mTaskConfig.localSnapshotFile.empty()) {
+    mLocalSnapshot = std::make_shared<LocalSnapshot>(mTaskConfig.localSnapshotFile, seconds(mTaskConfig.localSnapshotPeriodSeconds), mTaskConfig.localSnapshotObjects);
+  }
+
   // setup user's task
   TaskFactory f;
   mTask.reset(f.create(mTaskConfig, mObjectsManager));
 
   // init user's task
-  mTask->loadCcdb(mTaskConfig.conditionUrl);
+  mConditionCache = std::make_shared<ConditionCache>(mTaskConfig.conditionUrl, mTaskConfig.conditionCacheDirectory, std::chrono::seconds(mTaskConfig.conditionLatestLifetimeSeconds));
+  mTask->setConditionCache(mConditionCache);
+  mTask->setMonitoring(mCollector);
   mTask->initialize(iCtx);
 
   mNoMoreCycles = false;
@@ -119,6 +131,9 @@ void TaskRunner::run(ProcessingContext& pCtx)
     finishCycle(pCtx.outputs());
     if (mResetAfterPublish) {
       mTask->reset();
+      if (mDeltaEncoder) {
+        mDeltaEncoder->resetBaselines();
+      }
     }
     if (mTaskConfig.maxNumberCycles < 0 || mCycleNumber < mTaskConfig.maxNumberCycles) {
       startCycle();
@@ -193,6 +208,7 @@ void TaskRunner::endOfStream(framework::EndOfStreamContext& eosContext)
   ILOG(Info) << "Received an EndOfStream, finishing the current cycle" << ENDM;
   finishCycle(eosContext.outputs());
   mNoMoreCycles = true;
+  takeLocalSnapshot(true);
 }
 
 void TaskRunner::start()
@@ -216,7 +232,11 @@ void TaskRunner::stop()
     mCycleOn = false;
   }
   endOfActivity();
+  takeLocalSnapshot(true);
   mTask->reset();
+  if (mDeltaEncoder) {
+    mDeltaEncoder->resetBaselines();
+  }
 }
 
 void TaskRunner::reset()
@@ -224,6 +244,8 @@ void TaskRunner::reset()
   mTask.reset();
   mCollector.reset();
   mObjectsManager.reset();
+  mDeltaEncoder.reset();
+  mLocalSnapshot.reset();
 }
 
 std::tuple<bool /*data ready*/, bool /*timer ready*/> TaskRunner::validateInputs(const framework::InputRecord& inputs)
@@ -267,6 +289,19 @@ void TaskRunner::populateConfig(std::string taskName)
   mTaskConfig.maxNumberCycles = taskConfigTree->second.get<int>("maxNumberCycles", -1);
   mTaskConfig.consulUrl = mConfigFile->get<std::string>("qc.config.consul.url", "http://consul-test.cern.ch:8500");
   mTaskConfig.conditionUrl = mConfigFile->get<std::string>("qc.config.conditionDB.url", "http://ccdb-test.cern.ch:8080");
+  mTaskConfig.conditionCacheDirectory = mConfigFile->get<std::string>("qc.config.conditionDB.cacheDirectory", "");
+  mTaskConfig.conditionLatestLifetimeSeconds = mConfigFile->get<int>("qc.config.conditionDB.latestLifetimeSeconds", 300);
+  mTaskConfig.deltaPublication = taskConfigTree->second.get<bool>("deltaPublication", false);
+  mTaskConfig.keyframeInterval = taskConfigTree->second.get<int>("keyframeInterval", 10);
+  if (auto snapshotTree = taskConfigTree->second.get_child_optional("localSnapshot")) {
+    mTaskConfig.localSnapshotFile = snapshotTree->get<std::string>("file", "");
+    mTaskConfig.localSnapshotPeriodSeconds = snapshotTree->get<int>("periodSeconds", 0);
+    if (auto objectsTree = snapshotTree->get_child_optional("objects")) {
+      for (const auto& [key, object] : *objectsTree) {
+        mTaskConfig.localSnapshotObjects.push_back(object.get_value<std::string>());
+      }
+    }
+  }
   try {
     mTaskConfig.customParameters = mConfigFile->getRecursiveMap("qc.tasks." + taskName + ".taskParameters");
   } catch (...) {
@@ -300,6 +335,12 @@ void TaskRunner::populateConfig(std::string taskName)
   ILOG(Info) << ">> Detector name : " << mTaskConfig.detectorName << ENDM;
   ILOG(Info) << ">> Cycle duration seconds : " << mTaskConfig.cycleDurationSeconds << ENDM;
   ILOG(Info) << ">> Max number cycles : " << mTaskConfig.maxNumberCycles << ENDM;
+  if (mTaskConfig.deltaPublication) {
+    ILOG(Info) << ">> Delta publication with a keyframe every " << mTaskConfig.keyframeInterval << " cycles" << ENDM;
+  }
+  if (!mTaskConfig.localSnapshotFile.empty()) {
+    ILOG(Info) << ">> Local snapshots in " << mTaskConfig.localSnapshotFile << ", period (seconds) : " << mTaskConfig.localSnapshotPeriodSeconds << ENDM;
+  }
 }
 
 std::string TaskRunner::validateDetectorName(std::string name)
@@ -337,6 +378,9 @@ void TaskRunner::startOfActivity()
                     mConfigFile->get<int>("qc.config.Activity.type"));
   mTask->startOfActivity(activity);
   mObjectsManager->updateServiceDiscovery();
+  if (mDeltaEncoder) {
+    mDeltaEncoder->forceKeyframe();
+  }
 }
 
 void TaskRunner::endOfActivity()
@@ -356,6 +400,7 @@ void TaskRunner::startCycle()
   mTask->startOfCycle();
   mNumberMessages = 0;
   mNumberObjectsPublishedInCycle = 0;
+  mNumberDeltasPublishedInCycle = 0;
   mTimerDurationCycle.reset();
   mCycleOn = true;
 }
@@ -369,6 +414,7 @@ void TaskRunner::finishCycle(DataAllocator& outputs)
 
   publishCycleStats();
   mObjectsManager->updateServiceDiscovery();
+  takeLocalSnapshot(false);
 
   mCycleNumber++;
   mCycleOn = false;
@@ -399,6 +445,37 @@ void TaskRunner::publishCycleStats()
                      .addValue(rate, "per_second")
                      .addValue(mTotalNumberObjectsPublished, "whole_run")
                      .addValue(wholeRunRate, "per_second_whole_run"));
+
+  if (mDeltaEncoder) {
+    mCollector->send({ mNumberDeltasPublishedInCycle, "qc_deltas_published_in_cycle" });
+  }
+
+  if (mConditionCache) {
+    auto conditionStatistics = mConditionCache->getStatistics();
+    mCollector->send(Metric{ "qc_condition_cache" }
+                       .addValue(conditionStatistics.hits, "hits")
+                       .addValue(conditionStatistics.diskHits, "disk_hits")
+                       .addValue(conditionStatistics.misses, "misses")
+                       .addValue(conditionStatistics.deduplicated, "deduplicated"));
+  }
+}
+
+void TaskRunner::takeLocalSnapshot(bool force)
+{
+  if (!mLocalSnapshot) {
+    return;
+  }
+  mLocalSnapshot->update(mObjectsManager->getNonOwningArray(), force);
+  if (force) {
+    // the end of the run is not reached before the last snapshot is on disk
+    mLocalSnapshot->flush();
+  }
+  auto statistics = mLocalSnapshot->getStatistics();
+  mCollector->send(Metric{ "qc_local_snapshots" }
+                     .addValue(statistics.written, "written")
+                     .addValue(statistics.replaced, "replaced")
+                     .addValue(statistics.failed, "failed")
+                     .addValue(statistics.lastWriteMs, "last_write_ms"));
 }
 
 int TaskRunner::publish(DataAllocator& outputs)
@@ -407,9 +484,16 @@ int TaskRunner::publish(DataAllocator& outputs)
   AliceO2::Common::Timer publicationDurationTimer;
 
   auto concreteOutput = framework::DataSpecUtils::asConcreteDataMatcher(mMonitorObjectsSpec);
-  // getNonOwningArray creates a TObjArray containing the monitoring objects, but not
-  // owning them. The array is created by new and must be cleaned up by the caller
-  std::unique_ptr<MonitorObjectCollection> array(mObjectsManager->getNonOwningArray());
+  // getNonOwningArray returns a TObjArray containing the monitoring objects, but not
+  // owning them. The array belongs to the ObjectsManager, which reuses it in the next cycles
+  MonitorObjectCollection* array = &mObjectsManager->getNonOwningArray();
+  std::unique_ptr<MonitorObjectCollection> deltas;
+  if (mDeltaEncoder) {
+    // histograms which were published before are replaced by their changes since then
+    deltas = mDeltaEncoder->encode(*array);
+    array = deltas.get();
+    mNumberDeltasPublishedInCycle += mDeltaEncoder->getNumberOfDeltas();
+  }
   int objectsPublished = array->GetEntries();
 
   outputs.snapshot(
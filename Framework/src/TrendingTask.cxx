@@ -84,20 +84,35 @@ void TrendingTask::trendValues()
   //  enough if we trend across runs).
   mMetaData.runNumber = -1;
 
+  // all the objects are requested at once, so that the database can retrieve them concurrently
+  std::vector<std::pair<std::string, std::string>> moNames;
+  std::vector<std::string> qoPaths;
+  for (auto& dataSource : mConfig.dataSources) {
+    if (dataSource.type == "repository") {
+      moNames.emplace_back(dataSource.path, dataSource.name);
+    } else if (dataSource.type == "repository-quality") {
+      qoPaths.push_back(dataSource.path + "/" + dataSource.name);
+    }
+  }
+  auto mos = mDatabase->retrieveMOs(moNames);
+  auto qos = mDatabase->retrieveQOs(qoPaths);
+
+  auto mo = mos.begin();
+  auto qo = qos.begin();
   for (auto& dataSource : mConfig.dataSources) {
 
     // todo: make it agnostic to MOs, QOs or other objects. Let the reductor cast to whatever it needs.
     if (dataSource.type == "repository") {
-      auto mo = mDatabase->retrieveMO(dataSource.path, dataSource.name);
-      TObject* obj = mo ? mo->getObject() : nullptr;
+      TObject* obj = *mo ? (*mo)->getObject() : nullptr;
       if (obj) {
         mReductors[dataSource.name]->update(obj);
       }
+      ++mo;
     } else if (dataSource.type == "repository-quality") {
-      auto qo = mDatabase->retrieveQO(dataSource.path + "/" + dataSource.name);
-      if (qo) {
-        mReductors[dataSource.name]->update(qo.get());
+      if (*qo) {
+        mReductors[dataSource.name]->update(qo->get());
       }
+      ++qo;
     } else {
       ILOGE << "Unknown type of data source '" << dataSource.type << "'.";
     }
@@ -0,0 +1,57 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   WorkerPool.cxx
+///
+
+#include "QualityControl/WorkerPool.h"
+
+namespace o2::quality_control::core
+{
+
+WorkerPool::WorkerPool(size_t workers)
+{
+  for (size_t i = 0; i < workers; i++) {
+    mThreads.emplace_back(&WorkerPool::work, this);
+  }
+}
+
+WorkerPool::~WorkerPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mStopping = true;
+  }
+  mJobAvailable.notify_all();
+  for (auto& thread : mThreads) {
+    thread.join();
+  }
+}
+
+void WorkerPool::work()
+{
+  while (true) {
+    std::function<void()> job;
+    {
+      std::unique_lock<std::mutex> lock(mMutex);
+      mJobAvailable.wait(lock, [this]() { return mStopping || !mJobs.empty(); });
+      if (mJobs.empty()) {
+        return;
+      }
+      job = std::move(mJobs.front());
+      mJobs.pop_front();
+    }
+    // the exceptions are given to the future of the job
+    job();
+  }
+}
+
+} // namespace o2::quality_control::core
@@ -0,0 +1,118 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   runMergeBenchmark.cxx
+///
+/// \brief Measures the throughput of MonitorObjectCollection::merge for several collection sizes, numbers of
+/// producers and numbers of merge threads.
+
+#include "QualityControl/MonitorObjectCollection.h"
+#include "QualityControl/MonitorObject.h"
+#include "QualityControl/QcInfoLogger.h"
+
+#include <TH1F.h>
+#include <TRandom3.h>
+#include <boost/program_options.hpp>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+using namespace o2::quality_control::core;
+namespace bpo = boost::program_options;
+
+namespace
+{
+// a collection as published by one producer
+MonitorObjectCollection* produce(size_t objects, int bins, int entries, TRandom3& random)
+{
+  auto collection = new MonitorObjectCollection();
+  collection->SetOwner(true);
+  for (size_t i = 0; i < objects; i++) {
+    std::string name = "histogram" + std::to_string(i);
+    auto histogram = new TH1F(name.c_str(), name.c_str(), bins, 0, bins);
+    histogram->SetDirectory(nullptr);
+    for (int entry = 0; entry < entries; entry++) {
+      histogram->Fill(random.Uniform(0, bins));
+    }
+    collection->Add(new MonitorObject(histogram, "benchmark", "TST"));
+  }
+  return collection;
+}
+
+// returns the duration of merging all the producers into one collection, the first merge included
+double benchmark(size_t objects, size_t producers, int bins, int entries, size_t iterations)
+{
+  TRandom3 random(42);
+  std::vector<std::unique_ptr<MonitorObjectCollection>> published;
+  for (size_t producer = 0; producer < producers; producer++) {
+    published.emplace_back(produce(objects, bins, entries, random));
+  }
+
+  double seconds = 0;
+  for (size_t iteration = 0; iteration < iterations; iteration++) {
+    MonitorObjectCollection merged;
+    merged.SetOwner(true);
+    auto start = std::chrono::steady_clock::now();
+    for (auto& collection : published) {
+      merged.merge(collection.get());
+    }
+    seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  }
+  return seconds / iterations;
+}
+} // namespace
+
+int main(int argc, const char* argv[])
+{
+  try {
+    bpo::options_description desc{ "Options" };
+    desc.add_options()                                                                                                                       //
+      ("help,h", "Help screen")                                                                                                              //
+      ("objects", bpo::value<std::vector<size_t>>()->multitoken()->default_value({ 100, 1000, 10000 }, "100 1000 10000"), "Collection sizes") //
+      ("producers", bpo::value<std::vector<size_t>>()->multitoken()->default_value({ 2, 8, 32 }, "2 8 32"), "Numbers of producers")          //
+      ("threads", bpo::value<std::vector<size_t>>()->multitoken()->default_value({ 1, 4 }, "1 4"), "Numbers of merge threads")               //
+      ("bins", bpo::value<int>()->default_value(100), "Number of bins of the histograms")                                                    //
+      ("entries", bpo::value<int>()->default_value(100), "Number of entries filled in each histogram")                                       //
+      ("iterations", bpo::value<size_t>()->default_value(3), "Number of times each merge is repeated");
+
+    bpo::variables_map vm;
+    store(parse_command_line(argc, argv, desc), vm);
+    notify(vm);
+
+    if (vm.count("help")) {
+      ILOG(Info) << desc << ENDM;
+      return 0;
+    }
+
+    auto bins = vm["bins"].as<int>();
+    auto entries = vm["entries"].as<int>();
+    auto iterations = std::max<size_t>(vm["iterations"].as<size_t>(), 1);
+
+    std::cout << std::setw(10) << "objects" << std::setw(10) << "producers" << std::setw(10) << "threads"
+              << std::setw(14) << "time [ms]" << std::setw(18) << "objects/s" << std::endl;
+    for (auto objects : vm["objects"].as<std::vector<size_t>>()) {
+      for (auto producers : vm["producers"].as<std::vector<size_t>>()) {
+        for (auto threads : vm["threads"].as<std::vector<size_t>>()) {
+          MonitorObjectCollection::setNumberOfMergeThreads(threads);
+          double seconds = benchmark(objects, producers, bins, entries, iterations);
+          std::cout << std::setw(10) << objects << std::setw(10) << producers << std::setw(10) << threads
+                    << std::setw(14) << std::fixed << std::setprecision(2) << seconds * 1000
+                    << std::setw(18) << std::setprecision(0) << objects * producers / seconds << std::endl;
+        }
+      }
+    }
+    MonitorObjectCollection::setNumberOfMergeThreads(1);
+    return 0;
+  } catch (const bpo::error& ex) {
+    ILOG(Error) << "Exception caught: " << ex.what() << ENDM;
+    return 1;
+  }
+}
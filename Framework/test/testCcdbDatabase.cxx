@@ -175,6 +175,27 @@ BOOST_AUTO_TEST_CASE(ccdb_retrieve_qo, *utf::depends_on("ccdb_store"))
   BOOST_CHECK_EQUAL(q.getLevel(), 3);
 }
 
+BOOST_AUTO_TEST_CASE(ccdb_retrieve_batch_async, *utf::depends_on("ccdb_store"))
+{
+  test_fixture f;
+  auto mos = f.backend->retrieveMOs({ { "qc/TST/my/task", "quarantine" }, { "non/existing", "object" }, { "qc/TST/my/task", "metadata" } });
+  BOOST_REQUIRE_EQUAL(mos.size(), 3);
+  BOOST_CHECK(mos[0] != nullptr && mos[0]->getName() == "quarantine");
+  BOOST_CHECK(mos[1] == nullptr);
+  BOOST_CHECK(mos[2] != nullptr && mos[2]->getName() == "metadata");
+
+  auto qos = f.backend->retrieveQOs({ "qc/checks/TST/test-ccdb-check", "qc/checks/TST/metadata" });
+  BOOST_REQUIRE_EQUAL(qos.size(), 2);
+  BOOST_CHECK(qos[0] != nullptr && qos[0]->getQuality() == Quality::Bad);
+  BOOST_CHECK(qos[1] != nullptr && qos[1]->getName() == "metadata");
+
+  auto futureMO = f.backend->retrieveMOAsync("qc/TST/my/task", "quarantine");
+  auto futureQO = f.backend->retrieveQOAsync("qc/checks/TST/test-ccdb-check");
+  auto mo = futureMO.get();
+  BOOST_CHECK(mo != nullptr && mo->getName() == "quarantine");
+  BOOST_CHECK(futureQO.get() != nullptr);
+}
+
 BOOST_AUTO_TEST_CASE(ccdb_retrieve_json, *utf::depends_on("ccdb_store"))
 {
   test_fixture f;
@@ -0,0 +1,172 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   testConditionCache.cxx
+///
+
+#include "QualityControl/ConditionCache.h"
+
+#define BOOST_TEST_MODULE ConditionCache test
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <TH1F.h>
+#include <TSystem.h>
+#include <atomic>
+#include <thread>
+
+using namespace std;
+
+namespace o2::quality_control::core
+{
+
+// serves one version valid between 1000 and 2000 and one valid after 2000
+struct CountingFetcher {
+  std::shared_ptr<std::atomic<int>> calls = std::make_shared<std::atomic<int>>(0);
+  std::chrono::milliseconds delay{ 0 };
+
+  TObject* operator()(const std::string& path, const std::map<std::string, std::string>&, long timestamp, std::map<std::string, std::string>& headers) const
+  {
+    (*calls)++;
+    std::this_thread::sleep_for(delay);
+    if (path == "missing") {
+      return nullptr;
+    }
+    bool first = timestamp >= 0 && timestamp < 2000;
+    headers["Valid-From"] = first ? "1000" : "2000";
+    headers["Valid-Until"] = first ? "2000" : "99999999999999";
+    headers["ETag"] = first ? "\"etag-1\"" : "\"etag-2\"";
+    auto histogram = new TH1F(path.c_str(), path.c_str(), 10, 0, 10);
+    histogram->SetDirectory(nullptr);
+    histogram->Fill(first ? 1 : 2);
+    return histogram;
+  }
+};
+
+double content(TObject* object)
+{
+  return dynamic_cast<TH1F*>(object)->GetMean();
+}
+
+BOOST_AUTO_TEST_CASE(cache_memory)
+{
+  CountingFetcher fetcher;
+  ConditionCache cache(fetcher);
+
+  std::unique_ptr<TObject> object(cache.retrieve("path", {}, 1500));
+  BOOST_REQUIRE(object != nullptr);
+  BOOST_CHECK_EQUAL(content(object.get()), 1);
+  // another timestamp within the validity is served from memory, as a separate copy
+  std::unique_ptr<TObject> again(cache.retrieve("path", {}, 1999));
+  BOOST_REQUIRE(again != nullptr);
+  BOOST_CHECK(again.get() != object.get());
+  BOOST_CHECK_EQUAL(fetcher.calls->load(), 1);
+
+  // out of the validity
+  std::unique_ptr<TObject> second(cache.retrieve("path", {}, 2000));
+  BOOST_CHECK_EQUAL(content(second.get()), 2);
+  BOOST_CHECK_EQUAL(fetcher.calls->load(), 2);
+
+  // other metadata are another object
+  std::unique_ptr<TObject> withMetadata(cache.retrieve("path", { { "Run", "1" } }, 1500));
+  BOOST_CHECK_EQUAL(fetcher.calls->load(), 3);
+
+  // missing objects are not cached
+  BOOST_CHECK(cache.retrieve("missing", {}, 1500) == nullptr);
+  BOOST_CHECK(cache.retrieve("missing", {}, 1500) == nullptr);
+  BOOST_CHECK_EQUAL(fetcher.calls->load(), 5);
+
+  auto statistics = cache.getStatistics();
+  BOOST_CHECK_EQUAL(statistics.hits, 1);
+  BOOST_CHECK_EQUAL(statistics.misses, 5);
+  BOOST_CHECK_EQUAL(cache.getStatistics().misses, 0);
+
+  cache.clear();
+  std::unique_ptr<TObject> afterClear(cache.retrieve("path", {}, 1500));
+  BOOST_CHECK_EQUAL(fetcher.calls->load(), 6);
+}
+
+BOOST_AUTO_TEST_CASE(cache_latest)
+{
+  CountingFetcher fetcher;
+  {
+    ConditionCache cache(fetcher, "", std::chrono::seconds(60));
+    std::unique_ptr<TObject> first(cache.retrieve("path"));
+    std::unique_ptr<TObject> second(cache.retrieve("path"));
+    BOOST_CHECK(first != nullptr && second != nullptr);
+    BOOST_CHECK_EQUAL(fetcher.calls->load(), 1);
+  }
+  {
+    // the latest version is asked again once its lifetime is over
+    ConditionCache cache(fetcher, "", std::chrono::seconds(0));
+    std::unique_ptr<TObject> first(cache.retrieve("path"));
+    std::unique_ptr<TObject> second(cache.retrieve("path"));
+    BOOST_CHECK_EQUAL(fetcher.calls->load(), 3);
+    // but it is still valid for explicit timestamps
+    std::unique_ptr<TObject> timestamped(cache.retrieve("path", {}, 3000));
+    BOOST_CHECK_EQUAL(content(timestamped.get()), 2);
+    BOOST_CHECK_EQUAL(fetcher.calls->load(), 3);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(cache_disk)
+{
+  std::string directory = std::string(gSystem->TempDirectory()) + "/testConditionCache";
+  gSystem->Exec(("rm -rf " + directory).c_str());
+
+  CountingFetcher fetcher;
+  {
+    ConditionCache cache(fetcher, directory);
+    std::unique_ptr<TObject> object(cache.retrieve("path/to/object", {}, 1500));
+    BOOST_CHECK_EQUAL(fetcher.calls->load(), 1);
+  }
+  {
+    // a new instance, e.g. after a restart, finds the object on disk
+    ConditionCache cache(fetcher, directory);
+    std::unique_ptr<TObject> object(cache.retrieve("path/to/object", {}, 1700));
+    BOOST_REQUIRE(object != nullptr);
+    BOOST_CHECK_EQUAL(content(object.get()), 1);
+    BOOST_CHECK_EQUAL(fetcher.calls->load(), 1);
+    BOOST_CHECK_EQUAL(cache.getStatistics().diskHits, 1);
+
+    std::unique_ptr<TObject> other(cache.retrieve("path/to/object", {}, 2500));
+    BOOST_CHECK_EQUAL(fetcher.calls->load(), 2);
+  }
+  gSystem->Exec(("rm -rf " + directory).c_str());
+}
+
+BOOST_AUTO_TEST_CASE(cache_concurrent)
+{
+  CountingFetcher fetcher;
+  fetcher.delay = std::chrono::milliseconds(200);
+  ConditionCache cache(fetcher);
+
+  std::vector<std::thread> threads;
+  std::atomic<int> retrieved = 0;
+  for (int i = 0; i < 4; i++) {
+    threads.emplace_back([&]() {
+      std::unique_ptr<TObject> object(cache.retrieve("path", {}, 1500));
+      if (object) {
+        retrieved++;
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  BOOST_CHECK_EQUAL(retrieved.load(), 4);
+  BOOST_CHECK_EQUAL(fetcher.calls->load(), 1);
+  auto statistics = cache.getStatistics();
+  BOOST_CHECK_EQUAL(statistics.misses, 1);
+  BOOST_CHECK_EQUAL(statistics.hits + statistics.deduplicated, 3);
+}
+
+} // namespace o2::quality_control::core
@@ -60,6 +60,46 @@ BOOST_AUTO_TEST_CASE(db_factory_test)
   BOOST_CHECK(dynamic_cast<DummyDatabase*>(database4.get()));
 }
 
+// counts the single-object calls made by the default batch and asynchronous implementations
+class CountingDatabase : public DummyDatabase
+{
+ public:
+  void storeMO(std::shared_ptr<MonitorObject>) override { storedMOs++; }
+  void storeQO(std::shared_ptr<QualityObject>) override { storedQOs++; }
+  std::shared_ptr<MonitorObject> retrieveMO(std::string taskName, std::string objectName, long) override
+  {
+    if (objectName == "missing") {
+      return nullptr;
+    }
+    return make_shared<MonitorObject>(new TH1F(objectName.c_str(), "", 1, 0, 1), taskName, "TST");
+  }
+  int storedMOs = 0;
+  int storedQOs = 0;
+};
+
+BOOST_AUTO_TEST_CASE(db_default_batch_async)
+{
+  CountingDatabase database;
+  auto mo = make_shared<MonitorObject>(new TH1F("histo", "", 1, 0, 1), "task", "TST");
+  auto qo = make_shared<QualityObject>("check");
+
+  database.storeMOs({ mo, mo, mo });
+  database.storeQOs({ qo, qo });
+  BOOST_CHECK_EQUAL(database.storedMOs, 3);
+  BOOST_CHECK_EQUAL(database.storedQOs, 2);
+
+  auto future = database.storeMOAsync(mo);
+  future.get();
+  BOOST_CHECK_EQUAL(database.storedMOs, 4);
+
+  auto mos = database.retrieveMOs({ { "task", "first" }, { "task", "missing" }, { "task", "last" } });
+  BOOST_REQUIRE_EQUAL(mos.size(), 3);
+  BOOST_CHECK_EQUAL(mos[0]->getName(), "first");
+  BOOST_CHECK(mos[1] == nullptr);
+  BOOST_CHECK_EQUAL(mos[2]->getName(), "last");
+  BOOST_CHECK_EQUAL(database.retrieveMOAsync("task", "async").get()->getName(), "async");
+}
+
 BOOST_AUTO_TEST_CASE(db_ccdb_listing)
 {
   std::unique_ptr<DatabaseInterface> database3 = DatabaseFactory::create("CCDB");
@@ -0,0 +1,160 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   testDeltaPublication.cxx
+///
+
+#include "QualityControl/DeltaEncoder.h"
+#include "QualityControl/DeltaDecoder.h"
+#include "QualityControl/HistogramDelta.h"
+#include "QualityControl/MonitorObjectCollection.h"
+
+#define BOOST_TEST_MODULE DeltaPublication test
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <TH1F.h>
+#include <TH2F.h>
+#include <TObjString.h>
+
+using namespace std;
+
+namespace o2::quality_control::core
+{
+
+// simulates the serialization and the reception of a published object
+static MonitorObject* receive(const TObject* published)
+{
+  auto mo = dynamic_cast<MonitorObject*>(published->Clone());
+  mo->setIsOwner(true);
+  return mo;
+}
+
+static void checkEqual(const TH1* a, const TH1* b)
+{
+  BOOST_REQUIRE(a != nullptr);
+  BOOST_REQUIRE(b != nullptr);
+  BOOST_REQUIRE_EQUAL(a->GetNcells(), b->GetNcells());
+  for (int bin = 0; bin < a->GetNcells(); ++bin) {
+    BOOST_CHECK_EQUAL(a->GetBinContent(bin), b->GetBinContent(bin));
+  }
+  BOOST_CHECK_EQUAL(a->GetEntries(), b->GetEntries());
+  BOOST_CHECK_CLOSE(a->GetMean(), b->GetMean(), 0.0001);
+}
+
+BOOST_AUTO_TEST_CASE(histogram_delta)
+{
+  TH2F current("th2", "th2", 10, 0, 10, 10, 0, 10);
+  current.Fill(1, 1);
+  current.Fill(5, 5, 2);
+  std::unique_ptr<TH2F> baseline(dynamic_cast<TH2F*>(current.Clone()));
+  current.Fill(5, 5);
+  current.Fill(7, 2);
+
+  BOOST_CHECK(HistogramDelta::isEncodable(&current, baseline.get()));
+  TH1F other("th1", "th1", 10, 0, 10);
+  BOOST_CHECK(!HistogramDelta::isEncodable(&current, &other));
+  TObjString string("content");
+  BOOST_CHECK(!HistogramDelta::isEncodable(&string));
+
+  std::unique_ptr<HistogramDelta> delta(HistogramDelta::create(&current, baseline.get()));
+  BOOST_CHECK_EQUAL(delta->getNumberOfChangedBins(), 2);
+  BOOST_CHECK(delta->matchesBaseline(baseline.get()));
+  BOOST_CHECK(!delta->matchesBaseline(&current));
+  BOOST_CHECK(delta->apply(baseline.get()));
+  checkEqual(&current, baseline.get());
+  BOOST_CHECK(!delta->apply(&other));
+}
+
+BOOST_AUTO_TEST_CASE(encode_decode)
+{
+  TH1F histo("histo", "histo", 100, 0, 100);
+  TObjString string("content");
+  MonitorObjectCollection objects;
+  objects.SetOwner(true);
+  auto histoMO = new MonitorObject(&histo, "task", "TST");
+  histoMO->setIsOwner(false);
+  auto stringMO = new MonitorObject(&string, "task", "TST");
+  stringMO->setIsOwner(false);
+  objects.Add(histoMO);
+  objects.Add(stringMO);
+
+  DeltaEncoder encoder(3);
+  DeltaDecoder decoder;
+
+  for (int cycle = 0; cycle < 7; cycle++) {
+    histo.Fill(cycle);
+    histo.Fill(50);
+
+    auto publication = encoder.encode(objects);
+    BOOST_CHECK_EQUAL(publication->GetEntries(), 2);
+    // keyframes on cycles 0, 3 and 6
+    BOOST_CHECK_EQUAL(encoder.getNumberOfDeltas(), cycle % 3 == 0 ? 0 : 1);
+
+    for (auto tobj : *publication) {
+      auto decoded = decoder.decode(std::shared_ptr<MonitorObject>(receive(tobj)));
+      BOOST_REQUIRE(decoded != nullptr);
+      BOOST_CHECK(!DeltaDecoder::isDelta(decoded.get()));
+      if (decoded->getName() == "histo") {
+        checkEqual(&histo, dynamic_cast<TH1*>(decoded->getObject()));
+      }
+    }
+  }
+
+  // a missed publication is detected
+  histo.Fill(10);
+  encoder.encode(objects);
+  histo.Fill(11);
+  auto publication = encoder.encode(objects);
+  for (auto tobj : *publication) {
+    std::shared_ptr<MonitorObject> mo(receive(tobj));
+    if (DeltaDecoder::isDelta(mo.get())) {
+      BOOST_CHECK(decoder.decode(mo) == nullptr);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(merge_deltas)
+{
+  TH1F histo("histo", "histo", 100, 0, 100);
+  MonitorObjectCollection objects;
+  objects.SetOwner(true);
+  auto histoMO = new MonitorObject(&histo, "task", "TST");
+  histoMO->setIsOwner(false);
+  objects.Add(histoMO);
+
+  DeltaEncoder encoder(100);
+  MonitorObjectCollection merged;
+  merged.SetOwner(true);
+  TH1F expected("expected", "expected", 100, 0, 100);
+
+  for (int cycle = 0; cycle < 4; cycle++) {
+    histo.Fill(cycle);
+    expected.Fill(cycle);
+    auto publication = encoder.encode(objects);
+    MonitorObjectCollection received;
+    received.SetOwner(true);
+    for (auto tobj : *publication) {
+      received.Add(receive(tobj));
+    }
+    merged.merge(&received);
+
+    // as with Mergers, the task resets its objects after each publication
+    histo.Reset();
+    encoder.resetBaselines();
+  }
+
+  auto mergedMO = dynamic_cast<MonitorObject*>(merged.FindObject("histo"));
+  BOOST_REQUIRE(mergedMO != nullptr);
+  checkEqual(&expected, dynamic_cast<TH1*>(mergedMO->getObject()));
+}
+
+} // namespace o2::quality_control::core
@@ -0,0 +1,131 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   testHistogramRegistry.cxx
+///
+
+#include "QualityControl/HistogramRegistry.h"
+#include "QualityControl/SparseHistogram.h"
+
+#define BOOST_TEST_MODULE HistogramRegistry test
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <TH1F.h>
+#include <TH2F.h>
+#include <thread>
+
+namespace o2::quality_control::core
+{
+
+BOOST_AUTO_TEST_CASE(registry_handles)
+{
+  TH1F histo1("histo1", "histo1", 10, 0, 10);
+  TH2F histo2("histo2", "histo2", 10, 0, 10, 10, 0, 10);
+  HistogramRegistry registry;
+  auto handle1 = registry.add(&histo1);
+  auto handle2 = registry.add(&histo2);
+  BOOST_CHECK_NE(handle1, handle2);
+  BOOST_CHECK_EQUAL(registry.find("histo2"), handle2);
+  BOOST_CHECK_EQUAL(registry.find("histo3"), HistogramRegistry::InvalidHandle);
+  BOOST_CHECK_EQUAL(registry.get(handle1), &histo1);
+  BOOST_CHECK_EQUAL(registry.size(), 2);
+
+  registry.fill(handle1, 3);
+  registry.fill(handle2, 3, 4);
+  BOOST_CHECK_EQUAL(histo1.GetBinContent(histo1.FindBin(3)), 1);
+  BOOST_CHECK_EQUAL(histo2.GetBinContent(histo2.FindBin(3, 4)), 1);
+
+  registry.reset();
+  BOOST_CHECK_EQUAL(histo1.GetEntries(), 0);
+  BOOST_CHECK_EQUAL(histo2.GetEntries(), 0);
+
+  // a histogram with the same name replaces the previous one
+  TH1F histo1bis("histo1", "histo1", 10, 0, 10);
+  BOOST_CHECK_EQUAL(registry.add(&histo1bis), handle1);
+  BOOST_CHECK_EQUAL(registry.size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(registry_buffer)
+{
+  TH1F histo1("histo1", "histo1", 10, 0, 10);
+  TH2F histo2("histo2", "histo2", 10, 0, 10, 10, 0, 10);
+  HistogramRegistry registry;
+  auto handle1 = registry.add(&histo1);
+  auto handle2 = registry.add(&histo2);
+
+  HistogramRegistry::Buffer buffer(registry);
+  buffer.fill(handle1, 3);
+  buffer.fill(handle1, 5);
+  buffer.fill(handle2, 1, 2);
+  BOOST_CHECK_EQUAL(histo1.GetEntries(), 0);
+
+  buffer.flush();
+  BOOST_CHECK_EQUAL(histo1.GetEntries(), 2);
+  BOOST_CHECK_EQUAL(histo1.GetBinContent(histo1.FindBin(5)), 1);
+  BOOST_CHECK_EQUAL(histo2.GetBinContent(histo2.FindBin(1, 2)), 1);
+
+  // the values are not applied twice
+  buffer.flush();
+  BOOST_CHECK_EQUAL(histo1.GetEntries(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(registry_sparse_histogram)
+{
+  TH1F histo1("histo1", "histo1", 10, 0, 10);
+  SparseHistogram histo2("histo2", "histo2", 100000, 0, 100000);
+  HistogramRegistry registry;
+  auto handle1 = registry.add(&histo1);
+  auto handle2 = registry.add(&histo2);
+  BOOST_CHECK_EQUAL(registry.find("histo2"), handle2);
+  BOOST_CHECK(registry.get(handle2) == nullptr);
+  BOOST_CHECK_EQUAL(registry.getSparse(handle2), &histo2);
+  BOOST_CHECK(registry.getSparse(handle1) == nullptr);
+
+  registry.fill(handle2, 5.5);
+  HistogramRegistry::Buffer buffer(registry);
+  buffer.fill(handle2, 5.5);
+  buffer.fill(handle2, 90000.5);
+  buffer.flush();
+  BOOST_CHECK_EQUAL(histo2.GetEntries(), 3);
+  BOOST_CHECK_EQUAL(histo2.GetBinContent(6), 2);
+  BOOST_CHECK_EQUAL(histo2.GetBinContent(90001), 1);
+
+  registry.reset();
+  BOOST_CHECK_EQUAL(histo2.GetEntries(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(registry_buffers_in_threads)
+{
+  TH1F histo("histo", "histo", 10, 0, 10);
+  HistogramRegistry registry;
+  auto handle = registry.add(&histo);
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([&registry, handle]() {
+      HistogramRegistry::Buffer buffer(registry);
+      for (int i = 0; i < 1000; i++) {
+        buffer.fill(handle, i % 10);
+        if (i % 100 == 99) {
+          buffer.flush();
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  BOOST_CHECK_EQUAL(histo.GetEntries(), 4000);
+  BOOST_CHECK_EQUAL(histo.GetBinContent(1), 400);
+}
+
+} // namespace o2::quality_control::core
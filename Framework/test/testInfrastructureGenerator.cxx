@@ -187,4 +187,32 @@ BOOST_AUTO_TEST_CASE(qc_factory_standalone_test)
              d.inputs.size() == 1;
     });
   BOOST_REQUIRE_EQUAL(checkRunnerCount, 3);
-}
\ No newline at end of file
+}
+
+BOOST_AUTO_TEST_CASE(qc_factory_merger_tree_test)
+{
+  std::string configFilePath = std::string("json://") + getTestDataDirectory() + "testMergerTopology.json";
+  auto workflow = InfrastructureGenerator::generateRemoteInfrastructure(configFilePath);
+
+  // the 5 inputs are merged by 3 Mergers in the first layer (fan-in of 2), then by one Merger in the last layer
+  auto mergers = std::count_if(
+    workflow.begin(), workflow.end(),
+    [](const DataProcessorSpec& d) {
+      return d.name.find("MERGER") != std::string::npos;
+    });
+  BOOST_CHECK_EQUAL(mergers, 4);
+
+  auto lastMerger = std::find_if(
+    workflow.begin(), workflow.end(),
+    [](const DataProcessorSpec& d) {
+      return d.name.find("MERGER") != std::string::npos &&
+             d.inputs.size() == 4 &&
+             d.outputs.size() == 1 && DataSpecUtils::getOptionalSubSpec(d.outputs[0]).value_or(-1) == 0;
+    });
+  BOOST_CHECK(lastMerger != workflow.end());
+
+  // the local part of the task does not depend on the Merger layers
+  auto localWorkflow = InfrastructureGenerator::generateLocalInfrastructure(configFilePath, "o2flp3");
+  BOOST_REQUIRE_EQUAL(localWorkflow.size(), 2);
+  BOOST_CHECK_EQUAL(DataSpecUtils::getOptionalSubSpec(localWorkflow[0].outputs[0]).value_or(-1), 3);
+}
@@ -0,0 +1,77 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   testLatencyRecorder.cxx
+///
+
+#include "QualityControl/LatencyRecorder.h"
+
+#define BOOST_TEST_MODULE LatencyRecorder test
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <TH1F.h>
+
+using namespace std::chrono;
+
+namespace o2::quality_control::core
+{
+
+BOOST_AUTO_TEST_CASE(latency_statistics)
+{
+  LatencyRecorder recorder("timing", { "first", "second" }, 10, 100);
+  recorder.add(0, microseconds(10));
+  recorder.add(0, microseconds(30));
+  recorder.add(1, microseconds(50));
+
+  auto first = recorder.getStatistics(0);
+  BOOST_CHECK_EQUAL(first.count, 2);
+  BOOST_CHECK_CLOSE(first.meanUs, 20., 0.01);
+  BOOST_CHECK_CLOSE(first.maxUs, 30., 0.01);
+  BOOST_CHECK_EQUAL(recorder.getStatistics(1).count, 1);
+  BOOST_CHECK_EQUAL(recorder.getNumberOfSteps(), 2);
+  BOOST_CHECK_EQUAL(recorder.getHistogram(0)->GetName(), "timing/first");
+}
+
+BOOST_AUTO_TEST_CASE(latency_export)
+{
+  LatencyRecorder recorder("timing", { "step" }, 4, 100);
+  // the ring keeps the last 4 samples, but all of them are counted
+  for (int i = 0; i < 6; i++) {
+    recorder.add(0, microseconds(10 * (i + 1)));
+  }
+  BOOST_CHECK_EQUAL(recorder.getStatistics(0).count, 6);
+  BOOST_CHECK_CLOSE(recorder.getStatistics(0).maxUs, 60., 0.01);
+
+  recorder.exportSamples();
+  auto histogram = recorder.getHistogram(0);
+  BOOST_CHECK_EQUAL(histogram->GetEntries(), 4);
+  BOOST_CHECK_EQUAL(histogram->GetBinContent(histogram->FindBin(10.)), 0);
+  BOOST_CHECK_EQUAL(histogram->GetBinContent(histogram->FindBin(50.)), 1);
+  BOOST_CHECK_EQUAL(recorder.getStatistics(0).count, 0);
+
+  // the next export shows only the new samples
+  recorder.add(0, microseconds(15));
+  recorder.exportSamples();
+  BOOST_CHECK_EQUAL(histogram->GetEntries(), 1);
+  BOOST_CHECK_EQUAL(histogram->GetBinContent(histogram->FindBin(15.)), 1);
+}
+
+BOOST_AUTO_TEST_CASE(latency_since_start)
+{
+  LatencyRecorder recorder("timing", { "step" });
+  auto start = LatencyRecorder::Clock::now();
+  recorder.add(0, start);
+  BOOST_CHECK_EQUAL(recorder.getStatistics(0).count, 1);
+  BOOST_CHECK_GE(recorder.getStatistics(0).meanUs, 0.);
+}
+
+} // namespace o2::quality_control::core
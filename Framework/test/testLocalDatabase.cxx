@@ -0,0 +1,140 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   testLocalDatabase.cxx
+///
+
+#include "QualityControl/LocalDatabase.h"
+#include "QualityControl/CcdbDatabase.h"
+#include "QualityControl/DatabaseFactory.h"
+
+#define BOOST_TEST_MODULE LocalDatabase test
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <TH1F.h>
+#include <TSystem.h>
+#include <thread>
+
+using namespace std;
+using namespace o2::quality_control::core;
+
+namespace o2::quality_control::repository
+{
+
+struct test_fixture {
+  test_fixture()
+  {
+    directory = std::string(gSystem->TempDirectory()) + "/testLocalDatabase_" + boost::unit_test::framework::current_test_case().p_name.get();
+    gSystem->Unlink((directory + "/data.bin").c_str());
+    gSystem->Unlink((directory + "/index.bin").c_str());
+    backend = DatabaseFactory::create("Local");
+    backend->connect({ { "host", "file://" + directory } });
+  }
+
+  std::shared_ptr<MonitorObject> histogram(const std::string& name, int entries)
+  {
+    auto h = new TH1F(name.c_str(), name.c_str(), 100, 0, 99);
+    h->SetDirectory(nullptr);
+    for (int i = 0; i < entries; i++) {
+      h->Fill(i);
+    }
+    return make_shared<MonitorObject>(h, "task", "TST");
+  }
+
+  std::string directory;
+  std::unique_ptr<DatabaseInterface> backend;
+};
+
+BOOST_AUTO_TEST_CASE(local_store_retrieve)
+{
+  test_fixture f;
+  f.backend->storeMO(f.histogram("histo", 10));
+  auto qo = make_shared<QualityObject>("check", vector<string>{ "input" }, "TST");
+  qo->setQuality(Quality::Bad);
+  f.backend->storeQO(qo);
+
+  auto mo = f.backend->retrieveMO("qc/TST/task", "histo");
+  BOOST_REQUIRE(mo != nullptr);
+  BOOST_CHECK_EQUAL(mo->getName(), "histo");
+  BOOST_CHECK_EQUAL(mo->getTaskName(), "task");
+  BOOST_CHECK_EQUAL(dynamic_cast<TH1F*>(mo->getObject())->GetEntries(), 10);
+
+  auto retrievedQO = f.backend->retrieveQO("qc/checks/TST/check");
+  BOOST_REQUIRE(retrievedQO != nullptr);
+  BOOST_CHECK_EQUAL(retrievedQO->getQuality(), Quality::Bad);
+
+  BOOST_CHECK(f.backend->retrieveMO("qc/TST/task", "missing") == nullptr);
+  BOOST_CHECK(!f.backend->retrieveMOJson("qc/TST/task", "histo").empty());
+  BOOST_CHECK(f.backend->retrieveQOJson("qc/checks/TST/missing").empty());
+
+  // a new connection sees the same content
+  LocalDatabase other;
+  other.connect(f.directory, "", "", "");
+  auto reopened = other.retrieveMO("qc/TST/task", "histo");
+  BOOST_REQUIRE(reopened != nullptr);
+  BOOST_CHECK_EQUAL(dynamic_cast<TH1F*>(reopened->getObject())->GetEntries(), 10);
+}
+
+BOOST_AUTO_TEST_CASE(local_versions)
+{
+  test_fixture f;
+  f.backend->storeMO(f.histogram("histo", 1));
+  long between = CcdbDatabase::getCurrentTimestamp();
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  auto mo = f.histogram("histo", 2);
+  mo->addMetadata("Run", "123");
+  f.backend->storeMO(mo);
+
+  auto latest = f.backend->retrieveMO("qc/TST/task", "histo");
+  BOOST_CHECK_EQUAL(dynamic_cast<TH1F*>(latest->getObject())->GetEntries(), 2);
+  auto older = f.backend->retrieveMO("qc/TST/task", "histo", between);
+  BOOST_CHECK_EQUAL(dynamic_cast<TH1F*>(older->getObject())->GetEntries(), 1);
+
+  auto* local = dynamic_cast<LocalDatabase*>(f.backend.get());
+  BOOST_CHECK_EQUAL(local->getVersions("qc/TST/task/histo").size(), 2);
+
+  // metadata filters
+  std::unique_ptr<TObject> run123(f.backend->retrieveTObject("qc/TST/task/histo", { { "Run", "123" } }));
+  BOOST_CHECK(run123 != nullptr);
+  std::unique_ptr<TObject> run124(f.backend->retrieveTObject("qc/TST/task/histo", { { "Run", "124" } }));
+  BOOST_CHECK(run124 == nullptr);
+  std::unique_ptr<TObject> detector(f.backend->retrieveTObject("qc/TST/task/histo", { { "qc_detector_name", "TST" } }));
+  BOOST_CHECK(detector != nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(local_listing_truncate)
+{
+  test_fixture f;
+  f.backend->storeMO(f.histogram("object1", 1));
+  f.backend->storeMO(f.histogram("object2", 1));
+  f.backend->storeMO(f.histogram("path/to/object3", 1));
+
+  auto names = f.backend->getPublishedObjectNames("qc/TST/task");
+  vector<string> expected{ "/object1", "/object2", "/path/to/object3" };
+  BOOST_CHECK_EQUAL_COLLECTIONS(names.begin(), names.end(), expected.begin(), expected.end());
+
+  f.backend->truncate("qc/TST/task", "object2");
+  BOOST_CHECK(f.backend->retrieveMO("qc/TST/task", "object2") == nullptr);
+  names = f.backend->getPublishedObjectNames("qc/TST/task");
+  BOOST_CHECK_EQUAL(names.size(), 2);
+
+  // storing again after a truncation
+  f.backend->storeMO(f.histogram("object2", 3));
+  BOOST_CHECK(f.backend->retrieveMO("qc/TST/task", "object2") != nullptr);
+  auto* local = dynamic_cast<LocalDatabase*>(f.backend.get());
+  BOOST_CHECK_EQUAL(local->getVersions("qc/TST/task/object2").size(), 1);
+
+  f.backend->truncate("qc/TST/task", "*");
+  BOOST_CHECK(f.backend->getPublishedObjectNames("qc/TST/task").empty());
+}
+
+} // namespace o2::quality_control::repository
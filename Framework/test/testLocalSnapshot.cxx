@@ -0,0 +1,116 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   testLocalSnapshot.cxx
+///
+
+#include "QualityControl/LocalSnapshot.h"
+#include "QualityControl/MonitorObject.h"
+#include "QualityControl/MonitorObjectCollection.h"
+
+#define BOOST_TEST_MODULE LocalSnapshot test
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <TFile.h>
+#include <TH1F.h>
+#include <TSystem.h>
+
+using namespace std::chrono;
+
+namespace o2::quality_control::core
+{
+
+static TH1F* addHistogram(MonitorObjectCollection& collection, const std::string& name)
+{
+  auto histo = new TH1F(name.c_str(), name.c_str(), 10, 0, 10);
+  histo->SetDirectory(nullptr);
+  auto mo = new MonitorObject(histo, "task", "TST");
+  mo->setIsOwner(true);
+  collection.Add(mo);
+  return histo;
+}
+
+static std::string snapshotPath()
+{
+  return "/tmp/testLocalSnapshot_" + std::to_string(gSystem->GetPid()) + ".root";
+}
+
+BOOST_AUTO_TEST_CASE(snapshot_content)
+{
+  MonitorObjectCollection collection;
+  collection.SetOwner(true);
+  auto histo1 = addHistogram(collection, "histo1");
+  addHistogram(collection, "histo2");
+  histo1->Fill(3);
+
+  std::string path = snapshotPath();
+  {
+    LocalSnapshot snapshot(path, seconds(0));
+    // only the end of the run is written without a period
+    BOOST_CHECK(!snapshot.update(collection));
+    BOOST_CHECK(snapshot.update(collection, true));
+    // the copies are not affected by the task
+    histo1->Fill(3);
+    snapshot.flush();
+    BOOST_CHECK_EQUAL(snapshot.getStatistics().written, 1);
+    BOOST_CHECK_EQUAL(snapshot.getStatistics().failed, 0);
+  }
+
+  std::unique_ptr<TFile> file(TFile::Open(path.c_str(), "READ"));
+  BOOST_REQUIRE(file != nullptr && !file->IsZombie());
+  auto stored = dynamic_cast<TH1F*>(file->Get("histo1"));
+  BOOST_REQUIRE(stored != nullptr);
+  BOOST_CHECK_EQUAL(stored->GetEntries(), 1);
+  BOOST_CHECK(dynamic_cast<TH1F*>(file->Get("histo2")) != nullptr);
+  file->Close();
+  gSystem->Unlink(path.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(snapshot_selection_and_period)
+{
+  MonitorObjectCollection collection;
+  collection.SetOwner(true);
+  addHistogram(collection, "histo1");
+  addHistogram(collection, "histo2");
+
+  std::string path = snapshotPath();
+  {
+    LocalSnapshot snapshot(path, hours(1), { "histo2" });
+    BOOST_CHECK(snapshot.update(collection));
+    BOOST_CHECK(!snapshot.update(collection));
+    BOOST_CHECK(snapshot.update(collection, true));
+    snapshot.flush();
+    auto statistics = snapshot.getStatistics();
+    BOOST_CHECK_EQUAL(statistics.written + statistics.replaced, 2);
+  }
+
+  std::unique_ptr<TFile> file(TFile::Open(path.c_str(), "READ"));
+  BOOST_REQUIRE(file != nullptr && !file->IsZombie());
+  BOOST_CHECK(dynamic_cast<TH1F*>(file->Get("histo1")) == nullptr);
+  BOOST_CHECK(dynamic_cast<TH1F*>(file->Get("histo2")) != nullptr);
+  file->Close();
+  gSystem->Unlink(path.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(snapshot_failure)
+{
+  MonitorObjectCollection collection;
+  collection.SetOwner(true);
+  addHistogram(collection, "histo1");
+
+  LocalSnapshot snapshot("/nonexistent/directory/snapshot.root", seconds(0));
+  snapshot.update(collection, true);
+  snapshot.flush();
+  BOOST_CHECK_EQUAL(snapshot.getStatistics().failed, 1);
+}
+
+} // namespace o2::quality_control::core
@@ -0,0 +1,122 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   testMonitorObjectCollection.cxx
+///
+
+#include "QualityControl/MonitorObjectCollection.h"
+#include "QualityControl/MonitorObject.h"
+
+#define BOOST_TEST_MODULE MonitorObjectCollection test
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <TH1F.h>
+
+namespace o2::quality_control::core
+{
+
+// a collection as published by one producer, each histogram is filled with the producer id
+static MonitorObjectCollection* produce(size_t objects, int producer)
+{
+  auto collection = new MonitorObjectCollection();
+  collection->SetOwner(true);
+  for (size_t i = 0; i < objects; i++) {
+    std::string name = "histo" + std::to_string(i);
+    auto histo = new TH1F(name.c_str(), name.c_str(), 10, 0, 10);
+    histo->SetDirectory(nullptr);
+    histo->Fill(producer);
+    auto mo = new MonitorObject(histo, "task", "TST");
+    mo->setIsOwner(true);
+    collection->Add(mo);
+  }
+  return collection;
+}
+
+static void mergeAll(MonitorObjectCollection& merged, size_t objects, int producers)
+{
+  for (int producer = 0; producer < producers; producer++) {
+    std::unique_ptr<MonitorObjectCollection> other(produce(objects, producer));
+    merged.merge(other.get());
+  }
+}
+
+static TH1* histogram(MonitorObjectCollection& collection, const std::string& name)
+{
+  auto mo = dynamic_cast<MonitorObject*>(collection.FindObject(name.c_str()));
+  BOOST_REQUIRE(mo != nullptr);
+  return dynamic_cast<TH1*>(mo->getObject());
+}
+
+BOOST_AUTO_TEST_CASE(merge_sequential)
+{
+  MonitorObjectCollection::setNumberOfMergeThreads(1);
+  BOOST_CHECK_EQUAL(MonitorObjectCollection::getNumberOfMergeThreads(), 1);
+
+  MonitorObjectCollection merged;
+  merged.SetOwner(true);
+  mergeAll(merged, 5, 3);
+  BOOST_CHECK_EQUAL(merged.GetEntries(), 5);
+  for (size_t i = 0; i < 5; i++) {
+    auto histo = histogram(merged, "histo" + std::to_string(i));
+    BOOST_CHECK_EQUAL(histo->GetEntries(), 3);
+    BOOST_CHECK_EQUAL(histo->GetBinContent(histo->FindBin(2)), 1);
+  }
+
+  // objects with the same name in one collection are all merged into the same target
+  std::unique_ptr<MonitorObjectCollection> duplicates(produce(2, 4));
+  std::unique_ptr<MonitorObjectCollection> more(produce(3, 4));
+  for (auto tobj : *more) {
+    duplicates->Add(tobj->Clone());
+  }
+  merged.merge(duplicates.get());
+  BOOST_CHECK_EQUAL(merged.GetEntries(), 5);
+  BOOST_CHECK_EQUAL(histogram(merged, "histo0")->GetEntries(), 5);
+  BOOST_CHECK_EQUAL(histogram(merged, "histo2")->GetEntries(), 4);
+
+  // the objects are added only once, even if repeated in the first collection
+  MonitorObjectCollection empty;
+  empty.SetOwner(true);
+  empty.merge(duplicates.get());
+  BOOST_CHECK_EQUAL(empty.GetEntries(), 3);
+  BOOST_CHECK_EQUAL(histogram(empty, "histo0")->GetEntries(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(merge_parallel)
+{
+  const size_t objects = 200;
+  const int producers = 8;
+
+  MonitorObjectCollection::setNumberOfMergeThreads(1);
+  MonitorObjectCollection sequential;
+  sequential.SetOwner(true);
+  mergeAll(sequential, objects, producers);
+
+  MonitorObjectCollection::setNumberOfMergeThreads(4);
+  BOOST_CHECK_EQUAL(MonitorObjectCollection::getNumberOfMergeThreads(), 4);
+  MonitorObjectCollection parallel;
+  parallel.SetOwner(true);
+  mergeAll(parallel, objects, producers);
+  MonitorObjectCollection::setNumberOfMergeThreads(1);
+
+  BOOST_REQUIRE_EQUAL(parallel.GetEntries(), sequential.GetEntries());
+  for (size_t i = 0; i < objects; i++) {
+    auto name = "histo" + std::to_string(i);
+    auto expected = histogram(sequential, name);
+    auto actual = histogram(parallel, name);
+    BOOST_CHECK_EQUAL(actual->GetEntries(), producers);
+    for (int bin = 0; bin < expected->GetNcells(); bin++) {
+      BOOST_CHECK_EQUAL(actual->GetBinContent(bin), expected->GetBinContent(bin));
+    }
+  }
+}
+
+} // namespace o2::quality_control::core
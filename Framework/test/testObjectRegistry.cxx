@@ -0,0 +1,144 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   testObjectRegistry.cxx
+///
+
+#include "QualityControl/ObjectRegistry.h"
+#include "QualityControl/Check.h"
+#include "getTestDataDirectory.h"
+
+#define BOOST_TEST_MODULE ObjectRegistry test
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <TH1F.h>
+
+using namespace o2::quality_control::checker;
+using namespace o2::quality_control::core;
+using namespace std;
+
+std::shared_ptr<MonitorObject> monitorObject(const std::string& task, const std::string& name)
+{
+  auto histogram = new TH1F(name.c_str(), name.c_str(), 10, 0, 10);
+  histogram->SetDirectory(nullptr);
+  return make_shared<MonitorObject>(histogram, task, "TST");
+}
+
+BOOST_AUTO_TEST_CASE(registry_intern)
+{
+  ObjectRegistry registry;
+  auto id1 = registry.intern("task", "object1");
+  auto id2 = registry.intern("task/path/object2");
+  BOOST_CHECK_EQUAL(id1, 0);
+  BOOST_CHECK_EQUAL(id2, 1);
+  BOOST_CHECK_EQUAL(registry.intern("task/object1"), id1);
+  BOOST_CHECK_EQUAL(registry.intern("task", "path/object2"), id2);
+  BOOST_CHECK_EQUAL(registry.size(), 2);
+  BOOST_CHECK_EQUAL(registry.getName(id2), "task/path/object2");
+  BOOST_CHECK_EQUAL(registry.getRevision(id1), 0);
+  BOOST_CHECK(registry.getObject(id1) == nullptr);
+  BOOST_CHECK(registry.getObject(id2) == nullptr);
+
+  // interning does not give any object to the checks, they get exactly the bound ones once received
+  std::string configFilePath = std::string("json://") + getTestDataDirectory() + "testSharedConfig.json";
+  Check check("checkAll", configFilePath);
+  check.init();
+  check.bind(registry);
+  BOOST_CHECK_EQUAL(registry.size(), 4);
+  check.prepare(registry);
+  BOOST_CHECK(check.getObjectMap().empty());
+
+  auto test1 = monitorObject("abcTask", "test1");
+  auto test2 = monitorObject("abcTask", "test2");
+  registry.update(test1, 1);
+  registry.update(test2, 1);
+  registry.update(monitorObject("task", "object1"), 1);
+  check.prepare(registry);
+  std::map<std::string, std::shared_ptr<MonitorObject>> expected{ { "abcTask/test1", test1 }, { "abcTask/test2", test2 } };
+  BOOST_CHECK(check.getObjectMap() == expected);
+}
+
+BOOST_AUTO_TEST_CASE(registry_update)
+{
+  ObjectRegistry registry;
+  auto id = registry.intern("task/object");
+  auto mo = monitorObject("task", "object");
+  BOOST_CHECK_EQUAL(registry.update(mo, 3), id);
+  BOOST_CHECK_EQUAL(registry.getRevision(id), 3);
+  BOOST_CHECK_EQUAL(registry.getObject(id), mo);
+
+  auto newer = monitorObject("task", "object");
+  registry.update(newer, 4);
+  BOOST_CHECK_EQUAL(registry.getRevision(id), 4);
+  BOOST_CHECK_EQUAL(registry.getObject(id), newer);
+  BOOST_CHECK_EQUAL(registry.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(indexed_object_map)
+{
+  IndexedObjectMap map;
+  auto mo = monitorObject("task", "object");
+  map.set(3, "task/object", mo);
+  BOOST_CHECK_EQUAL(map.get().size(), 1);
+  BOOST_CHECK_EQUAL(map.get().at("task/object"), mo);
+
+  auto newer = monitorObject("task", "object");
+  map.set(3, "task/object", newer);
+  BOOST_CHECK_EQUAL(map.get().size(), 1);
+  BOOST_CHECK_EQUAL(map.get().at("task/object"), newer);
+
+  // the copies are independent
+  IndexedObjectMap copy = map;
+  auto newest = monitorObject("task", "object");
+  copy.set(3, "task/object", newest);
+  BOOST_CHECK_EQUAL(copy.get().at("task/object"), newest);
+  BOOST_CHECK_EQUAL(map.get().at("task/object"), newer);
+}
+
+BOOST_AUTO_TEST_CASE(registry_check_policy)
+{
+  std::string configFilePath = std::string("json://") + getTestDataDirectory() + "testSharedConfig.json";
+
+  Check check("checkAll", configFilePath);
+  check.init();
+  ObjectRegistry registry;
+  check.bind(registry);
+  BOOST_CHECK_EQUAL(registry.size(), 2);
+  BOOST_CHECK(!check.isReady(registry));
+  check.prepare(registry);
+  BOOST_CHECK(check.getObjectMap().empty());
+
+  registry.update(monitorObject("abcTask", "test1"), 10);
+  BOOST_CHECK(!check.isReady(registry));
+  registry.update(monitorObject("abcTask", "test2"), 13);
+  BOOST_CHECK(check.isReady(registry));
+
+  check.updateRevision(10);
+  BOOST_CHECK(!check.isReady(registry));
+  registry.update(monitorObject("abcTask", "test1"), 14);
+  BOOST_CHECK(check.isReady(registry));
+
+  // only the declared objects are given to the check
+  registry.update(monitorObject("abcTask", "other"), 14);
+  BOOST_CHECK(check.check(registry) != nullptr);
+  BOOST_CHECK_EQUAL(check.getObjectIds().size(), 2);
+  BOOST_CHECK_EQUAL(registry.size(), 3);
+  BOOST_CHECK_EQUAL(check.getObjectMap().size(), 2);
+  BOOST_CHECK_EQUAL(check.getObjectMap().count("abcTask/other"), 0);
+
+  // the shadowed entries are replaced by the newer versions
+  auto newer = monitorObject("abcTask", "test2");
+  registry.update(newer, 15);
+  check.prepare(registry);
+  BOOST_CHECK_EQUAL(check.getObjectMap().size(), 2);
+  BOOST_CHECK_EQUAL(check.getObjectMap().at("abcTask/test2"), newer);
+}
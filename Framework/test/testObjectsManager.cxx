@@ -99,17 +99,50 @@ BOOST_AUTO_TEST_CASE(getters_test)
   BOOST_CHECK_THROW(objectsManager.getMonitorObject("unexisting object"), ObjectNotFoundError);
 
   // non owning array
-  TObjArray* array = objectsManager.getNonOwningArray();
+  TObjArray* array = &objectsManager.getNonOwningArray();
   BOOST_CHECK_EQUAL(array->GetEntries(), 2);
   BOOST_CHECK(array->FindObject("content") != nullptr);
   BOOST_CHECK(array->FindObject("histo") != nullptr);
+  BOOST_CHECK(!array->IsOwner());
 
-  // we confirm that deleting the array does not delete objects
-  delete array;
-  BOOST_CHECK_NO_THROW(objectsManager.getMonitorObject("content"));
+  // the array is reused as long as the published objects do not change
+  BOOST_CHECK_EQUAL(&objectsManager.getNonOwningArray(), array);
+  objectsManager.stopPublishing("content");
+  array = &objectsManager.getNonOwningArray();
+  BOOST_CHECK_EQUAL(array->GetEntries(), 1);
+  BOOST_CHECK(array->FindObject("content") == nullptr);
   BOOST_CHECK_NO_THROW(objectsManager.getMonitorObject("histo"));
 }
 
+BOOST_AUTO_TEST_CASE(handles_test)
+{
+  TaskConfig config;
+  config.taskName = "test";
+  ObjectsManager objectsManager(config, true);
+
+  TObjString s("content");
+  TH1F h("histo", "h", 100, 0, 99);
+  objectsManager.startPublishing(&s);
+  objectsManager.startPublishing(&h);
+
+  auto handle = objectsManager.getHandle("histo");
+  BOOST_CHECK_EQUAL(objectsManager.getMonitorObject(handle), objectsManager.getMonitorObject("histo"));
+  BOOST_CHECK_EQUAL(objectsManager.getMonitorObject(handle)->getObject(), &h);
+  BOOST_CHECK_THROW(objectsManager.getHandle("unexisting object"), ObjectNotFoundError);
+
+  // the handles of the other objects are not affected
+  objectsManager.stopPublishing("content");
+  BOOST_CHECK_EQUAL(objectsManager.getMonitorObject(handle)->getObject(), &h);
+
+  // the handles of the unpublished objects are invalidated, also if their entry is reused
+  objectsManager.stopPublishing("histo");
+  BOOST_CHECK_THROW(objectsManager.getMonitorObject(handle), ObjectNotFoundError);
+  objectsManager.startPublishing(&s);
+  BOOST_CHECK_THROW(objectsManager.getMonitorObject(handle), ObjectNotFoundError);
+  BOOST_CHECK_THROW(objectsManager.getMonitorObject(ObjectsManager::Handle()), ObjectNotFoundError);
+  BOOST_CHECK_EQUAL(objectsManager.getMonitorObject(objectsManager.getHandle("content"))->getObject(), &s);
+}
+
 BOOST_AUTO_TEST_CASE(metadata_test)
 {
   TaskConfig config;
@@ -0,0 +1,132 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   testSparseHistogram.cxx
+///
+
+#include "QualityControl/SparseHistogram.h"
+
+#define BOOST_TEST_MODULE SparseHistogram test
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <TH1F.h>
+#include <TBufferFile.h>
+#include <limits>
+
+namespace o2::quality_control::core
+{
+
+BOOST_AUTO_TEST_CASE(sparse_histogram_fill)
+{
+  SparseHistogram histo("histo", "histo", 1000000, 0, 1000000);
+  histo.Fill(10.5);
+  histo.Fill(10.5);
+  histo.Fill(999999.5, 3);
+  histo.Fill(-1);
+  histo.Fill(1000000);
+
+  BOOST_CHECK_EQUAL(histo.GetEntries(), 5);
+  BOOST_CHECK_EQUAL(histo.GetBinContent(11), 2);
+  BOOST_CHECK_EQUAL(histo.GetBinContent(12), 0);
+  BOOST_CHECK_EQUAL(histo.GetBinContent(1000000), 3);
+  BOOST_CHECK_EQUAL(histo.GetBinContent(0), 1);
+  BOOST_CHECK_EQUAL(histo.GetBinContent(1000001), 1);
+  // only the chunks which were filled are stored
+  BOOST_CHECK_EQUAL(histo.getNumberOfChunks(), 2);
+
+  // the non-finite values go to the underflow and overflow
+  histo.Fill(std::numeric_limits<double>::quiet_NaN());
+  histo.Fill(std::numeric_limits<double>::infinity());
+  histo.Fill(-std::numeric_limits<double>::infinity());
+  BOOST_CHECK_EQUAL(histo.GetBinContent(0), 2);
+  BOOST_CHECK_EQUAL(histo.GetBinContent(1000001), 3);
+  BOOST_CHECK_EQUAL(histo.getNumberOfChunks(), 2);
+
+  double values[] = { 11.5, 20.5, 5000.5 };
+  histo.FillN(3, values);
+  BOOST_CHECK_EQUAL(histo.GetBinContent(12), 1);
+  BOOST_CHECK_EQUAL(histo.getNumberOfChunks(), 3);
+
+  histo.Reset();
+  BOOST_CHECK_EQUAL(histo.GetEntries(), 0);
+  BOOST_CHECK_EQUAL(histo.GetBinContent(11), 0);
+  BOOST_CHECK_EQUAL(histo.getNumberOfChunks(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(sparse_histogram_merge)
+{
+  SparseHistogram histo1("histo", "histo", 1000, 0, 100);
+  SparseHistogram histo2("histo", "histo", 1000, 0, 100);
+  histo1.Fill(1.05);
+  histo2.Fill(1.05);
+  histo2.Fill(90.05);
+
+  histo1.merge(&histo2);
+  BOOST_CHECK_EQUAL(histo1.GetEntries(), 3);
+  BOOST_CHECK_EQUAL(histo1.GetBinContent(11), 2);
+  BOOST_CHECK_EQUAL(histo1.GetBinContent(901), 1);
+
+  // a different binning is refused
+  SparseHistogram histo3("histo", "histo", 100, 0, 100);
+  histo3.Fill(1.5);
+  histo1.merge(&histo3);
+  BOOST_CHECK_EQUAL(histo1.GetEntries(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(sparse_histogram_conversion)
+{
+  SparseHistogram histo("histo", "title", 1000, 0, 100);
+  histo.Fill(1.05);
+  histo.Fill(50.05, 2);
+
+  auto th1 = histo.getHistogram();
+  BOOST_REQUIRE(th1 != nullptr);
+  BOOST_CHECK_EQUAL(th1->GetNbinsX(), 1000);
+  BOOST_CHECK_EQUAL(th1->GetBinContent(11), 1);
+  BOOST_CHECK_EQUAL(th1->GetBinContent(501), 2);
+  BOOST_CHECK_EQUAL(th1->GetEntries(), 2);
+
+  // the histogram is updated after a fill
+  histo.Fill(1.05);
+  BOOST_CHECK_EQUAL(histo.getHistogram(), th1);
+  BOOST_CHECK_EQUAL(th1->GetBinContent(11), 2);
+  BOOST_CHECK_EQUAL(th1->GetEntries(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(sparse_histogram_streamer)
+{
+  SparseHistogram histo("histo", "title", 1000000, 0, 1000000);
+  histo.Fill(10.5);
+  histo.Fill(500000.5, 2);
+
+  TBufferFile buffer(TBuffer::kWrite);
+  buffer.WriteObject(&histo);
+  // only the filled chunks are serialized
+  BOOST_CHECK_LT(buffer.Length(), 10000);
+  buffer.SetReadMode();
+  buffer.SetBufferOffset(0);
+  std::unique_ptr<SparseHistogram> read(static_cast<SparseHistogram*>(buffer.ReadObject(SparseHistogram::Class())));
+
+  BOOST_REQUIRE(read != nullptr);
+  BOOST_CHECK_EQUAL(std::string(read->GetName()), "histo");
+  BOOST_CHECK_EQUAL(read->GetEntries(), 2);
+  BOOST_CHECK_EQUAL(read->GetBinContent(11), 1);
+  BOOST_CHECK_EQUAL(read->GetBinContent(500001), 2);
+  BOOST_CHECK_EQUAL(read->getNumberOfChunks(), 2);
+
+  // a deserialized histogram can be filled again
+  read->Fill(10.5);
+  BOOST_CHECK_EQUAL(read->GetBinContent(11), 2);
+  BOOST_CHECK_EQUAL(read->getNumberOfChunks(), 2);
+}
+
+} // namespace o2::quality_control::core
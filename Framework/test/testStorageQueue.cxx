@@ -0,0 +1,196 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   testStorageQueue.cxx
+///
+
+#include "QualityControl/StorageQueue.h"
+#include "QualityControl/DummyDatabase.h"
+
+#include <Common/Exceptions.h>
+
+#define BOOST_TEST_MODULE StorageQueue test
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <TH1F.h>
+#include <TSystem.h>
+
+using namespace std;
+using namespace o2::quality_control::core;
+
+namespace o2::quality_control::repository
+{
+
+// records what the workers store, the stores can be held until the gate is opened
+struct Recorder {
+  std::mutex mutex;
+  std::condition_variable cv;
+  bool open = true;
+  int waiting = 0;
+  std::vector<std::string> stored;
+
+  void close()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    open = false;
+  }
+  void release()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      open = true;
+    }
+    cv.notify_all();
+  }
+  void waitForWorkers(int number)
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait(lock, [&] { return waiting == number; });
+  }
+};
+
+class RecordingDatabase : public DummyDatabase
+{
+ public:
+  explicit RecordingDatabase(Recorder& recorder) : mRecorder(recorder) {}
+
+  void storeMO(std::shared_ptr<MonitorObject> mo) override
+  {
+    std::unique_lock<std::mutex> lock(mRecorder.mutex);
+    mRecorder.waiting++;
+    mRecorder.cv.notify_all();
+    mRecorder.cv.wait(lock, [&] { return mRecorder.open; });
+    mRecorder.waiting--;
+    auto histo = dynamic_cast<TH1*>(mo->getObject());
+    mRecorder.stored.push_back(mo->getName() + ":" + std::to_string((int)histo->GetEntries()));
+  }
+
+  void storeQO(std::shared_ptr<QualityObject> qo) override
+  {
+    std::lock_guard<std::mutex> lock(mRecorder.mutex);
+    mRecorder.stored.push_back(qo->getName());
+  }
+
+ private:
+  Recorder& mRecorder;
+};
+
+static StorageQueue::DatabaseCreator creator(Recorder& recorder)
+{
+  return [&recorder]() { return std::make_unique<RecordingDatabase>(recorder); };
+}
+
+// the histogram is filled 'revision' times, so that the stored revision is known
+static std::shared_ptr<MonitorObject> object(const std::string& name, int revision)
+{
+  auto histo = new TH1F(name.c_str(), name.c_str(), 10, 0, 10);
+  histo->SetDirectory(nullptr);
+  for (int i = 0; i < revision; i++) {
+    histo->Fill(i);
+  }
+  auto mo = std::make_shared<MonitorObject>(histo, "task", "TST");
+  mo->setIsOwner(true);
+  return mo;
+}
+
+BOOST_AUTO_TEST_CASE(policy_from_string)
+{
+  BOOST_CHECK(StorageQueue::policyFromString("dropOldest") == StorageQueue::BackpressurePolicy::DropOldest);
+  BOOST_CHECK(StorageQueue::policyFromString("block") == StorageQueue::BackpressurePolicy::Block);
+  BOOST_CHECK(StorageQueue::policyFromString("spill") == StorageQueue::BackpressurePolicy::Spill);
+  BOOST_CHECK_THROW(StorageQueue::policyFromString("unknown"), AliceO2::Common::FatalException);
+}
+
+BOOST_AUTO_TEST_CASE(coalescing)
+{
+  Recorder recorder;
+  StorageQueue queue(creator(recorder), 1, 10, StorageQueue::BackpressurePolicy::Block);
+
+  recorder.close();
+  queue.push(object("a", 1));
+  recorder.waitForWorkers(1);
+  // the worker is busy with a:1, these ones wait in the queue
+  queue.push(object("a", 2));
+  queue.push(object("b", 1));
+  queue.push(object("a", 3));
+  queue.push(std::make_shared<QualityObject>("check"));
+  recorder.release();
+  queue.flush();
+
+  std::vector<std::string> expected{ "a:1", "a:3", "b:1", "check" };
+  BOOST_CHECK_EQUAL_COLLECTIONS(recorder.stored.begin(), recorder.stored.end(), expected.begin(), expected.end());
+  auto statistics = queue.getStatistics();
+  BOOST_CHECK_EQUAL(statistics.stored, 4);
+  BOOST_CHECK_EQUAL(statistics.coalesced, 1);
+  BOOST_CHECK_EQUAL(statistics.queueDepth, 0);
+  // the counters are reset
+  BOOST_CHECK_EQUAL(queue.getStatistics().stored, 0);
+}
+
+BOOST_AUTO_TEST_CASE(drop_oldest)
+{
+  Recorder recorder;
+  StorageQueue queue(creator(recorder), 1, 2, StorageQueue::BackpressurePolicy::DropOldest);
+
+  recorder.close();
+  queue.push(object("x", 1));
+  recorder.waitForWorkers(1);
+  queue.push(object("a", 1));
+  queue.push(object("b", 1));
+  queue.push(object("c", 1));
+  BOOST_CHECK_EQUAL(queue.getStatistics().dropped, 1);
+  recorder.release();
+  queue.flush();
+
+  std::vector<std::string> expected{ "x:1", "b:1", "c:1" };
+  BOOST_CHECK_EQUAL_COLLECTIONS(recorder.stored.begin(), recorder.stored.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(spill)
+{
+  Recorder recorder;
+  std::string directory = std::string(gSystem->TempDirectory()) + "/testStorageQueue";
+  StorageQueue queue(creator(recorder), 1, 1, StorageQueue::BackpressurePolicy::Spill, directory);
+
+  recorder.close();
+  queue.push(object("x", 1));
+  recorder.waitForWorkers(1);
+  queue.push(object("a", 1));
+  queue.push(object("b", 1));
+  queue.push(object("c", 1));
+  queue.push(object("c", 2));
+  auto statistics = queue.getStatistics();
+  BOOST_CHECK_EQUAL(statistics.spilled, 3);
+  BOOST_CHECK_EQUAL(statistics.coalesced, 1);
+  BOOST_CHECK_EQUAL(statistics.queueDepth, 3);
+  recorder.release();
+  queue.flush();
+
+  std::sort(recorder.stored.begin(), recorder.stored.end());
+  std::vector<std::string> expected{ "a:1", "b:1", "c:2", "x:1" };
+  BOOST_CHECK_EQUAL_COLLECTIONS(recorder.stored.begin(), recorder.stored.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(many_workers)
+{
+  Recorder recorder;
+  {
+    StorageQueue queue(creator(recorder), 4, 2, StorageQueue::BackpressurePolicy::Block);
+    for (int i = 0; i < 100; i++) {
+      queue.push(object("histo" + std::to_string(i), 1));
+    }
+    // the destructor stores the remaining objects
+  }
+  BOOST_CHECK_EQUAL(recorder.stored.size(), 100);
+}
+
+} // namespace o2::quality_control::repository
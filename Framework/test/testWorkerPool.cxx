@@ -0,0 +1,80 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   testWorkerPool.cxx
+///
+
+#include "QualityControl/WorkerPool.h"
+
+#define BOOST_TEST_MODULE WorkerPool test
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <atomic>
+#include <stdexcept>
+
+using namespace std::chrono;
+
+namespace o2::quality_control::core
+{
+
+BOOST_AUTO_TEST_CASE(pool_results)
+{
+  WorkerPool pool(4);
+  BOOST_CHECK_EQUAL(pool.size(), 4);
+
+  std::vector<std::future<int>> results;
+  for (int i = 0; i < 100; i++) {
+    results.push_back(pool.submit([i]() { return i * i; }));
+  }
+  for (int i = 0; i < 100; i++) {
+    BOOST_CHECK_EQUAL(results[i].get(), i * i);
+  }
+
+  auto failing = pool.submit([]() -> int { throw std::runtime_error("failure"); });
+  BOOST_CHECK_THROW(failing.get(), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(pool_concurrency)
+{
+  WorkerPool pool(4);
+  auto start = steady_clock::now();
+  std::vector<std::future<void>> results;
+  for (int i = 0; i < 4; i++) {
+    results.push_back(pool.submit([]() { std::this_thread::sleep_for(milliseconds(200)); }));
+  }
+  for (auto& result : results) {
+    result.get();
+  }
+  BOOST_CHECK(steady_clock::now() - start < milliseconds(700));
+
+  // a job which is too slow can be left behind
+  auto slow = pool.submit([]() { std::this_thread::sleep_for(milliseconds(300)); });
+  BOOST_CHECK(slow.wait_for(milliseconds(10)) == std::future_status::timeout);
+  BOOST_CHECK(pool.submit([]() { return true; }).get());
+}
+
+BOOST_AUTO_TEST_CASE(pool_destruction)
+{
+  std::atomic<int> executed = 0;
+  {
+    WorkerPool pool(1);
+    for (int i = 0; i < 10; i++) {
+      pool.submit([&executed]() {
+        std::this_thread::sleep_for(milliseconds(5));
+        executed++;
+      });
+    }
+  }
+  BOOST_CHECK_EQUAL(executed.load(), 10);
+}
+
+} // namespace o2::quality_control::core
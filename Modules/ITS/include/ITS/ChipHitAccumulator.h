@@ -0,0 +1,101 @@
+///
+/// \file   ChipHitAccumulator.h
+/// \brief  Hit counters of the pixels of the ITS chips
+///
+
+#ifndef QC_MODULE_ITS_CHIPHITACCUMULATOR_H
+#define QC_MODULE_ITS_CHIPHITACCUMULATOR_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace o2
+{
+namespace quality_control_modules
+{
+namespace its
+{
+
+/// \brief Hit counters of the pixels of the ITS chips, folded into summaries on demand
+///
+/// The counters of a chip are allocated at its first hit, so that the memory follows the number of chips which receive
+/// data, and counting a hit is a single increment. fold(), typically called once per cycle, updates the summaries of
+/// the chips which received hits since the previous fold: their number of hits per region of RegionSize x RegionSize
+/// pixels, and their contribution to the distribution of the number of hits per fired pixel of their group of chips.
+class ChipHitAccumulator
+{
+ public:
+  static constexpr int NCols = 1024;
+  static constexpr int NRows = 512;
+  static constexpr int RegionSize = 4;
+  static constexpr int NRegionCols = NCols / RegionSize;
+  static constexpr int NRegionRows = NRows / RegionSize;
+  static constexpr int NLogBins = 1000; // bins of log10(hits), from 0 to NLogBins * LogBinWidth
+  static constexpr double LogBinWidth = 0.01;
+
+  /// Hits of a chip at the last fold.
+  struct Summary {
+    uint64_t hits = 0;
+    uint64_t firedPixels = 0;
+    const uint32_t* regions = nullptr; // [region row][region column], only valid during the fold callback
+  };
+
+  /// \param groups  group of each chip, from 0 to the number of groups - 1
+  explicit ChipHitAccumulator(std::vector<int> groups);
+  ~ChipHitAccumulator();
+
+  void add(int chip, int row, int col)
+  {
+    auto& c = mChips[chip];
+    if (!c.changed) {
+      markChanged(chip);
+    }
+    c.pixels[row * NCols + col]++;
+  }
+
+  /// \brief Updates the summaries of the chips which received hits since the previous call.
+  /// Calls function(int chip, uint64_t previousHits, const Summary& summary) for each of them.
+  template <typename Function>
+  void fold(Function&& function)
+  {
+    for (int chip : mChanged) {
+      uint64_t previousHits = mChips[chip].summary.hits;
+      foldChip(chip);
+      function(chip, previousHits, mChips[chip].summary);
+    }
+    mChanged.clear();
+  }
+
+  const Summary& getSummary(int chip) const { return mChips[chip].summary; }
+  /// Number of fired pixels of the group per bin of log10(hits), at the last fold.
+  const std::vector<uint64_t>& getHitDistribution(int group) const { return mDistributions[group]; }
+  int getNumberOfChips() const { return mChips.size(); }
+  int getNumberOfAllocatedChips() const { return mAllocatedChips; }
+  /// Forgets all the hits and frees the counters.
+  void clear();
+
+ private:
+  struct Chip {
+    std::unique_ptr<uint32_t[]> pixels;  // [row][column]
+    std::unique_ptr<uint32_t[]> logHits; // contribution of the chip to the distribution of its group
+    Summary summary;
+    bool changed = false;
+  };
+
+  void markChanged(int chip);
+  void foldChip(int chip);
+
+  std::vector<Chip> mChips;
+  std::vector<int> mGroups;
+  std::vector<std::vector<uint64_t>> mDistributions; // [group][log bin]
+  std::vector<int> mChanged;                         // chips with hits since the last fold
+  std::vector<uint32_t> mRegions;                    // regions of the chip being folded
+  int mAllocatedChips = 0;
+};
+
+} // namespace its
+} // namespace quality_control_modules
+} // namespace o2
+
+#endif // QC_MODULE_ITS_CHIPHITACCUMULATOR_H
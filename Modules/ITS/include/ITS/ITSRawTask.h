@@ -9,7 +9,9 @@
 #ifndef QC_MODULE_ITS_ITSRAWTASK_H
 #define QC_MODULE_ITS_ITSRAWTASK_H
 
+#include "QualityControl/LatencyRecorder.h"
 #include "QualityControl/TaskInterface.h"
+#include "ITS/ChipHitAccumulator.h"
 
 #include <TH2F.h>
 #include <TPaveText.h>
@@ -81,10 +83,12 @@ class ITSRawTask : public TaskInterface // todo add back the "final" when doxyge
   void resetHitmaps();
   void resetOccupancyPlots();
   void updateOccupancyPlots(int nEvents);
+  void foldHits();
   void addObject(TObject* aObject, bool published = true);
   void enableLayers();
   void formatStatistics(TH2* h);
   void format2DZaxis(TH2* h);
+  void buildChipLocations();
 
   ChipPixelData* mChipData = nullptr;
   std::vector<ChipPixelData> mChips;
@@ -101,10 +105,6 @@ class ITSRawTask : public TaskInterface // todo add back the "final" when doxyge
   const int NColHis = 1024;
   const int NRowHis = 512;
 
-  int mSizeReduce = 4;
-
-  const int occUpdateFrequency = 1000000;
-
   int mDivisionStep = 32;
   static constexpr int NPixels = NRows * NCols;
   static constexpr int NLayer = 7;
@@ -128,12 +128,34 @@ class ITSRawTask : public TaskInterface // todo add back the "final" when doxyge
   TH2I* hEtaPhiHitmap[NLayer];
   TH2D* hChipStaveOccupancy[NLayer];
   TH2I* hHicHitmap[7][48][14];
-  TH2I* hChipHitmap[7][48][14][14];
   TH2I* hIBHitmap[3];
   const std::vector<o2::itsmft::Digit>* mDigits = nullptr;
 
   o2::its::GeometryTGeo* gm = o2::its::GeometryTGeo::Instance();
 
+  // Position of a chip in the detector and in the histograms, computed once from the geometry at initialization,
+  // so that the loop over the digits does not need the geometry.
+  struct ChipLocation {
+    int layer = -1; // -1 if the layer is not enabled
+    int stave = 0;
+    int hic = 0;
+    int chip = 0;           // chip number in the HIC, as given by the geometry
+    int chipInHic = 0;      // chip index in the HIC, without the gap of the OB HICs
+    int firstEtaPhiBin = 0; // index of the first block of the chip in mEtaPhiBins
+  };
+  // The eta and phi of the hits are those of the center of their block of pixels. The blocks are smaller than the
+  // bins of hEtaPhiHitmap.
+  static constexpr int BlockCols = 64;
+  static constexpr int BlockRows = 64;
+  static constexpr int NBlockCols = NCols / BlockCols;
+  static constexpr int NBlockRows = NRows / BlockRows;
+  std::vector<ChipLocation> mChipLocations;
+  std::vector<int> mEtaPhiBins;        // [chip][row block][column block], global bin of hEtaPhiHitmap of the layer
+  std::vector<uint32_t> mEtaPhiFolded; // hits of each block already added to hEtaPhiHitmap
+
+  // hits of the pixels, added to the hitmaps at the end of each cycle
+  std::unique_ptr<ChipHitAccumulator> mHits;
+
   static constexpr int NError = 11;
   std::array<unsigned int, NError> mErrors;
   std::array<unsigned int, NError> mErrorPre;
@@ -160,14 +182,20 @@ class ITSRawTask : public TaskInterface // todo add back the "final" when doxyge
   TEllipse* bulb;
 
   int mTotalDigits = 0;
-  int mNEvent;
-  int mNEventPre;
+  int mNEvent = 0;
+  int mNEventPre = 0;
   int mTotalFileDone;
   //	int FileRest;
 
-  int mCounted;
-  int mTotalCounted = 10000;
   int mYellowed;
+
+  // durations of the steps of monitorData, exported at the end of each cycle
+  enum LatencyStep { LatencyBeforeLoop,
+                     LatencyDigit,
+                     LatencyDigitLoop,
+                     LatencyMonitorData };
+  std::unique_ptr<LatencyRecorder> mLatency;
+  int mDigitTimingPeriod = 1000; // one digit out of mDigitTimingPeriod is timed
 };
 
 } // namespace its
@@ -0,0 +1,92 @@
+///
+/// \file   ChipHitAccumulator.cxx
+/// \brief  Hit counters of the pixels of the ITS chips
+///
+
+#include "ITS/ChipHitAccumulator.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace o2
+{
+namespace quality_control_modules
+{
+namespace its
+{
+
+ChipHitAccumulator::ChipHitAccumulator(std::vector<int> groups)
+  : mChips(groups.size()), mGroups(std::move(groups)), mRegions(NRegionRows * NRegionCols)
+{
+  int nGroups = mGroups.empty() ? 0 : *std::max_element(mGroups.begin(), mGroups.end()) + 1;
+  mDistributions.assign(nGroups, std::vector<uint64_t>(NLogBins));
+}
+
+ChipHitAccumulator::~ChipHitAccumulator() = default;
+
+void ChipHitAccumulator::markChanged(int chip)
+{
+  auto& c = mChips[chip];
+  c.changed = true;
+  mChanged.push_back(chip);
+  if (!c.pixels) {
+    c.pixels = std::make_unique<uint32_t[]>(NRows * NCols);
+    c.logHits = std::make_unique<uint32_t[]>(NLogBins);
+    mAllocatedChips++;
+  }
+}
+
+void ChipHitAccumulator::foldChip(int chip)
+{
+  auto& c = mChips[chip];
+  auto& distribution = mDistributions[mGroups[chip]];
+  c.changed = false;
+
+  // the previous contribution of the chip is replaced by the new one
+  for (int bin = 0; bin < NLogBins; bin++) {
+    distribution[bin] -= c.logHits[bin];
+    c.logHits[bin] = 0;
+  }
+  std::fill(mRegions.begin(), mRegions.end(), 0);
+
+  uint64_t hits = 0, firedPixels = 0;
+  for (int row = 0; row < NRows; row++) {
+    const uint32_t* pixels = c.pixels.get() + row * NCols;
+    uint32_t* regions = mRegions.data() + (row / RegionSize) * NRegionCols;
+    for (int col = 0; col < NCols; col++) {
+      uint32_t pixelHits = pixels[col];
+      if (pixelHits == 0) {
+        continue;
+      }
+      hits += pixelHits;
+      firedPixels++;
+      regions[col / RegionSize] += pixelHits;
+      // the small offset keeps the exact powers of 10 in their own bin despite the rounding of log10
+      int bin = static_cast<int>(std::log10(pixelHits) / LogBinWidth + 1e-6);
+      c.logHits[std::min(bin, NLogBins - 1)]++;
+    }
+  }
+
+  for (int bin = 0; bin < NLogBins; bin++) {
+    distribution[bin] += c.logHits[bin];
+  }
+  c.summary.hits = hits;
+  c.summary.firedPixels = firedPixels;
+  c.summary.regions = mRegions.data();
+}
+
+void ChipHitAccumulator::clear()
+{
+  for (auto& c : mChips) {
+    c = Chip();
+  }
+  for (auto& distribution : mDistributions) {
+    std::fill(distribution.begin(), distribution.end(), 0);
+  }
+  mChanged.clear();
+  mAllocatedChips = 0;
+}
+
+} // namespace its
+} // namespace quality_control_modules
+} // namespace o2
@@ -12,6 +12,7 @@
 #include "ITS/ITSRawTask.h"
 #include "ITS/ITSTaskVariables.h"
 
+#include <ITSMFTBase/SegmentationAlpide.h>
 #include <TGaxis.h>
 #include <TStyle.h>
 #include <TPad.h>
@@ -70,9 +71,6 @@ ITSRawTask::~ITSRawTask()
     for (int j = 0; j < 48; j++) {
       for (int k = 0; k < 14; k++) {
         delete hHicHitmap[i][j][k];
-        for (int l = 0; l < 14; l++) {
-          delete hChipHitmap[i][j][k][l];
-        }
       }
     }
   }
@@ -102,6 +100,7 @@ void ITSRawTask::initialize(o2::framework::InitContext& /*ctx*/)
   int numOfChips = geom->getNumberOfChips();
   QcInfoLogger::GetInstance() << "numOfChips = " << numOfChips << AliceO2::InfoLogger::InfoLogger::endm;
   setNChips(numOfChips);
+  buildChipLocations();
 
   for (int i = 0; i < NError; i++) {
     pt[i] = new TPaveText(0.20, 0.80 - i * 0.05, 0.85, 0.85 - i * 0.05, "NDC");
@@ -144,6 +143,12 @@ void ITSRawTask::initialize(o2::framework::InitContext& /*ctx*/)
 
   //		InfoCanvas->SetStats(false);
 
+  // the timing of the task is published with its histograms
+  mLatency = std::make_unique<LatencyRecorder>("General/Latency", std::vector<std::string>{ "before_loop", "digit", "digit_loop", "monitor_data" }, 1000, 1e6);
+  for (size_t iStep = 0; iStep < mLatency->getNumberOfSteps(); iStep++) {
+    addObject(mLatency->getHistogram(iStep));
+  }
+
   publishHistos();
 
   QcInfoLogger::GetInstance() << "DONE Inititing Publication = " << AliceO2::InfoLogger::InfoLogger::endm;
@@ -151,7 +156,6 @@ void ITSRawTask::initialize(o2::framework::InitContext& /*ctx*/)
   bulb->SetFillColor(kRed);
   mTotalFileDone = 0;
   TotalHisTime = 0;
-  mCounted = 0;
   mYellowed = 0;
 }
 
@@ -167,21 +171,8 @@ void ITSRawTask::startOfCycle()
 
 void ITSRawTask::monitorData(o2::framework::ProcessingContext& ctx)
 {
-  double eta, phi;
-  int lay, sta, ssta, mod, chip;
   UShort_t col = 0, row = 0, ChipID = 0;
-  std::chrono::time_point<std::chrono::high_resolution_clock> start;
-  std::chrono::time_point<std::chrono::high_resolution_clock> startLoop;
-  std::chrono::time_point<std::chrono::high_resolution_clock> end;
-  int difference;
-
-  start = std::chrono::high_resolution_clock::now();
-
-  ofstream timefout("HisTimeGlobal.dat", ios::app);
-
-  ofstream timefout2("HisTimeLoop.dat", ios::app);
-
-  QcInfoLogger::GetInstance() << "BEEN HERE BRO" << AliceO2::InfoLogger::InfoLogger::endm;
+  auto start = LatencyRecorder::Clock::now();
 
   int FileID = ctx.inputs().get<int>("File");
   int EPID = ctx.inputs().get<int>("EP");
@@ -220,12 +211,16 @@ void ITSRawTask::monitorData(o2::framework::ProcessingContext& ctx)
     }
   }
 
-  difference = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
-  //	QcInfoLogger::GetInstance() << "Before Loop = " << difference/1000.0 << "s" <<  AliceO2::InfoLogger::InfoLogger::endm;
-  timefout << "Before Loop  = " << difference / 1000.0 << "s" << std::endl;
+  auto startLoop = LatencyRecorder::Clock::now();
+  mLatency->add(LatencyBeforeLoop, startLoop - start);
   int i = 0;
   for (auto&& pixeldata : digits) {
-    startLoop = std::chrono::high_resolution_clock::now();
+    // only a fraction of the digits is timed, so that the measurement does not cost more than the digit itself
+    bool timed = i % mDigitTimingPeriod == 0;
+    LatencyRecorder::Clock::time_point startDigit;
+    if (timed) {
+      startDigit = LatencyRecorder::Clock::now();
+    }
 
     ChipID = pixeldata.getChipIndex();
     col = pixeldata.getColumn();
@@ -235,116 +230,30 @@ void ITSRawTask::monitorData(o2::framework::ProcessingContext& ctx)
     i++;
     //cout << "Event Compare: " << NEvent << ", " << NEventPre << endl;
 
-    if (mNEvent % occUpdateFrequency == 0 && mNEvent > 0 && mNEvent != mNEventPre) {
-      updateOccupancyPlots(mNEventPre);
-      // cout << "Carried out, " << NEventPre << endl;
-    }
-
-    // cout << "NFrame = " << NEvent  << endl;
-    if (mCounted < mTotalCounted) {
-      end = std::chrono::high_resolution_clock::now();
-      difference = std::chrono::duration_cast<std::chrono::nanoseconds>(end - startLoop).count();
-      //	QcInfoLogger::GetInstance() << "Before Geo = " << difference << "ns" <<  AliceO2::InfoLogger::InfoLogger::endm;
-      timefout2 << "Getting Value Time  = " << difference << "ns" << std::endl;
-    }
-
-    if (mNEvent % 1000000 == 0 && mNEvent > 0) {
+    if (mNEvent % 1000000 == 0 && mNEvent > 0 && mNEvent != mNEventPre) {
       QcInfoLogger::GetInstance() << "ChipID = " << ChipID << "  col = " << col << "  row = " << row << "  mNEvent = " << mNEvent << AliceO2::InfoLogger::InfoLogger::endm;
     }
-    // wouldnt this update this update the text for every digit in events 1000, 2000 ... ?
-    if (mNEvent % 1000 == 0 || mNEventPre != mNEvent) {
-      ptNEvent->Clear();
-      ptNEvent->AddText(Form("Event Being Processed: %d", mNEvent));
-    }
-
-    if (mCounted < mTotalCounted) {
-      end = std::chrono::high_resolution_clock::now();
-      difference = std::chrono::duration_cast<std::chrono::nanoseconds>(end - startLoop).count();
-      //	QcInfoLogger::GetInstance() << "Before Geo = " << difference << "ns" <<  AliceO2::InfoLogger::InfoLogger::endm;
-      timefout2 << "Before Geo  = " << difference << "ns" << std::endl;
-    }
-
-    gm->getChipId(ChipID, lay, sta, ssta, mod, chip);
-    // cout << "getID : " << ChipID << ", " << lay << ", " << sta << ", " << ssta << ", " << mod << ", " << chip << endl;
-    gm->fillMatrixCache(o2::utils::bit2Mask(o2::TransformType::L2G));
-    const Point3D<float> loc(0., 0., 0.);
-    auto glo = gm->getMatrixL2G(ChipID)(loc);
 
-    if (!mlayerEnable[lay]) {
+    if (ChipID >= mChipLocations.size() || mChipLocations[ChipID].layer < 0 || col >= NCols || row >= NRows) {
       continue;
     }
-
-    if (mCounted < mTotalCounted) {
-      end = std::chrono::high_resolution_clock::now();
-      difference = std::chrono::duration_cast<std::chrono::nanoseconds>(end - startLoop).count();
-      //	QcInfoLogger::GetInstance() << "After Geo = " << difference << "ns" <<  AliceO2::InfoLogger::InfoLogger::endm;
-      timefout2 << "After Geo =  " << difference << "ns" << std::endl;
-    }
-
-    int hicCol, hicRow;
-    // Todo: check if chipID is really chip ID
-    getHicCoordinates(lay, chip, col, row, hicRow, hicCol);
-    //  if (lay == 0 && sta == 0 && ssta == 0 && mod == 0 && chip == 0) cout << ChipID << ", " << col << ", " << row << endl;
-    hHicHitmap[lay][sta][mod]->Fill(hicCol, hicRow);
-    if (lay > NLayerIB && chip > 6) {
-      // OB HICs: take into account that chip IDs are 0 .. 6, 8 .. 14
-      hChipHitmap[lay][sta][mod][chip - 1]->Fill(col, row);
-    } else {
-      hChipHitmap[lay][sta][mod][chip]->Fill(col, row);
-      // hIBHitmap[lay]->Fill(hicCol, row+(sta*NRowHis));
-    }
-
-    if (mCounted < mTotalCounted) {
-      end = std::chrono::high_resolution_clock::now();
-      difference = std::chrono::duration_cast<std::chrono::nanoseconds>(end - startLoop).count();
-      //	QcInfoLogger::GetInstance() << "After Geo = " << difference << "ns" <<  AliceO2::InfoLogger::InfoLogger::endm;
-      timefout2 << "Fill HitMaps =  " << difference << "ns" << std::endl;
-    }
-
-    if (mCounted < mTotalCounted) {
-      end = std::chrono::high_resolution_clock::now();
-      difference = std::chrono::duration_cast<std::chrono::nanoseconds>(end - startLoop).count();
-      //	QcInfoLogger::GetInstance() << "After Geo = " << difference << "ns" <<  AliceO2::InfoLogger::InfoLogger::endm;
-      timefout2 << "Before glo etaphi =  " << difference << "ns" << std::endl;
-    }
-
-    eta = glo.eta();
-    phi = glo.phi();
-    hEtaPhiHitmap[lay]->Fill(eta, phi);
-
-    if (mCounted < mTotalCounted) {
-      end = std::chrono::high_resolution_clock::now();
-      difference = std::chrono::duration_cast<std::chrono::nanoseconds>(end - startLoop).count();
-      //	QcInfoLogger::GetInstance() << "After Geo = " << difference << "ns" <<  AliceO2::InfoLogger::InfoLogger::endm;
-      timefout2 << "After glo etaphi =  " << difference << "ns" << std::endl;
-      mCounted = mCounted + 1;
-    }
+    // the histograms are filled from the counters at the end of the cycle
+    mHits->add(ChipID, row, col);
 
     mNEventPre = mNEvent;
 
+    if (timed) {
+      mLatency->add(LatencyDigit, startDigit);
+    }
   } // end digits loop
   i = 0;
-  if (mNEventPre > 0) {
-    updateOccupancyPlots(mNEventPre);
-  }
-  //cout << "EndUpdateOcc " << NEventPre <<endl;
-  end = std::chrono::high_resolution_clock::now();
-  difference = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
-  QcInfoLogger::GetInstance() << "Time After Loop = " << difference / 1000.0 << "s"
-                              << AliceO2::InfoLogger::InfoLogger::endm;
-  timefout << "Time After Loop = " << difference / 1000.0 << "s" << std::endl;
-
-  QcInfoLogger::GetInstance() << "NEventDone = " << mNEvent << AliceO2::InfoLogger::InfoLogger::endm;
-  QcInfoLogger::GetInstance() << "Test  " << AliceO2::InfoLogger::InfoLogger::endm;
+  mLatency->add(LatencyDigitLoop, startLoop);
 
   digits.clear();
 
-  end = std::chrono::high_resolution_clock::now();
-  difference = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
-  TotalHisTime = TotalHisTime + difference;
-  QcInfoLogger::GetInstance() << "Time in Histogram = " << difference / 1000.0 << "s"
-                              << AliceO2::InfoLogger::InfoLogger::endm;
-  timefout << "Time in Histogram = " << difference / 1000.0 << "s" << std::endl;
+  auto end = LatencyRecorder::Clock::now();
+  mLatency->add(LatencyMonitorData, end - start);
+  TotalHisTime = TotalHisTime + std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
 
   if (mNEvent == 0 && ChipID == 0 && row == 0 && col == 0 && mYellowed == 0) {
     bulb->SetFillColor(kYellow);
@@ -427,8 +336,8 @@ void ITSRawTask::createLayerHistos(int aLayer)
   addObject(hIBHitmap[aLayer]);
   }
 */
-  // HITMAPS per HIC, binning in groups of SizeReduce * SizeReduce pixels
-  // chipHitmap: fine binning, one hitmap per chip, but not to be saved to CCDB (only for determination of noisy pixels)
+  // HITMAPS per HIC, binning in groups of RegionSize * RegionSize pixels
+  // the hits of each pixel are kept in mHits, not in histograms (only for determination of noisy pixels)
   for (int iStave = 0; iStave < NStaves[aLayer]; iStave++) {
     createStaveHistos(aLayer, iStave);
   }
@@ -491,23 +400,22 @@ void ITSRawTask::createStaveHistos(int aLayer, int aStave)
 void ITSRawTask::createHicHistos(int aLayer, int aStave, int aHic)
 {
   TString Name, Title;
-  int nBinsX, nBinsY, maxX, maxY, nChips;
+  int nBinsX, nBinsY, maxX, maxY;
 
   if (aLayer < NLayerIB) {
     Name = Form("Occupancy/Layer%d/Stave%d/Layer%dStave%dHITMAP", aLayer, aStave, aLayer, aStave);
     Title = Form("Hits on Layer %d, Stave %d", aLayer, aStave);
     maxX = 9 * NColHis;
     maxY = NRowHis;
-    nChips = 9;
   } else {
     Name = Form("Occupancy/Layer%d/Stave%d/HIC%d/Layer%dStave%dHIC%dHITMAP", aLayer, aStave, aHic, aLayer, aStave, aHic);
     Title = Form("Hits on Layer %d, Stave %d, Hic %d", aLayer, aStave, aHic);
     maxX = 7 * NColHis;
     maxY = 2 * NRowHis;
-    nChips = 14;
   }
-  nBinsX = maxX / mSizeReduce;
-  nBinsY = maxY / mSizeReduce;
+  // one bin per region of the hit counters
+  nBinsX = maxX / ChipHitAccumulator::RegionSize;
+  nBinsY = maxY / ChipHitAccumulator::RegionSize;
   hHicHitmap[aLayer][aStave][aHic] = new TH2I(Name, Title, nBinsX, 0, maxX, nBinsY, 0, maxY);
   formatAxes(hHicHitmap[aLayer][aStave][aHic], "Column", "Row", 1., 1.1);
   // formatting, moved here from initialize
@@ -516,12 +424,47 @@ void ITSRawTask::createHicHistos(int aLayer, int aStave, int aHic)
   hHicHitmap[aLayer][aStave][aHic]->GetXaxis()->SetNdivisions(-32);
   hHicHitmap[aLayer][aStave][aHic]->Draw("COLZ"); // should this really be drawn here?
   addObject(hHicHitmap[aLayer][aStave][aHic]);
+}
 
-  for (int iChip = 0; iChip < nChips; iChip++) {
-    hChipHitmap[aLayer][aStave][aHic][iChip] = new TH2I(Form("chipHitmapL%dS%dH%dC%d", aLayer, aStave, aHic, iChip),
-                                                        Form("chipHitmapL%dS%dH%dC%d", aLayer, aStave, aHic, iChip), 1024, -.5, 1023.5, 512, -.5, 511.5);
-    addObject(hChipHitmap[aLayer][aStave][aHic][iChip], false);
+void ITSRawTask::buildChipLocations()
+{
+  int lay, sta, ssta, mod, chip;
+  int numOfChips = gm->getNumberOfChips();
+  mChipLocations.assign(numOfChips, ChipLocation());
+  mEtaPhiBins.clear();
+  std::vector<int> chipLayers(numOfChips);
+
+  for (int chipID = 0; chipID < numOfChips; chipID++) {
+    gm->getChipId(chipID, lay, sta, ssta, mod, chip);
+    chipLayers[chipID] = lay;
+    if (!mlayerEnable[lay]) {
+      continue;
+    }
+    auto& location = mChipLocations[chipID];
+    location.layer = lay;
+    location.stave = sta;
+    location.hic = mod;
+    location.chip = chip;
+    // OB HICs: take into account that chip IDs are 0 .. 6, 8 .. 14
+    location.chipInHic = (lay >= NLayerIB && chip > 6) ? chip - 1 : chip;
+    location.firstEtaPhiBin = mEtaPhiBins.size();
+
+    const auto& matrix = gm->getMatrixL2G(chipID);
+    for (int blockRow = 0; blockRow < NBlockRows; blockRow++) {
+      for (int blockCol = 0; blockCol < NBlockCols; blockCol++) {
+        float rowCenter = blockRow * BlockRows + (BlockRows - 1) / 2.f;
+        float colCenter = blockCol * BlockCols + (BlockCols - 1) / 2.f;
+        float x, z;
+        SegmentationAlpide::detectorToLocal(rowCenter, colCenter, x, z);
+        auto glo = matrix(Point3D<float>(x, 0., z));
+        mEtaPhiBins.push_back(hEtaPhiHitmap[lay]->FindBin(glo.eta(), glo.phi()));
+      }
+    }
   }
+  mEtaPhiFolded.assign(mEtaPhiBins.size(), 0);
+  mHits = std::make_unique<ChipHitAccumulator>(chipLayers);
+  QcInfoLogger::GetInstance() << "Chip locations computed for " << mEtaPhiBins.size() / (NBlockRows * NBlockCols)
+                              << " chips" << AliceO2::InfoLogger::InfoLogger::endm;
 }
 
 // To be checked:
@@ -539,7 +482,7 @@ void ITSRawTask::getHicCoordinates(int aLayer, int aChip, int aCol, int aRow, in
       aHicRow = NRows - aRow - 1;
     } else {
       aHicRow = NRows + aRow;
-      aHicCol = 7 * NCols - ((aChip - 8) * NCols + aCol);
+      aHicCol = 7 * NCols - ((aChip - 8) * NCols + aCol) - 1;
     }
   }
 }
@@ -672,6 +615,18 @@ void ITSRawTask::updateFile(int aRunID, int aEpID, int aFileID)
 void ITSRawTask::endOfCycle()
 {
   QcInfoLogger::GetInstance() << "endOfCycle" << AliceO2::InfoLogger::InfoLogger::endm;
+
+  foldHits();
+  if (mNEventPre > 0) {
+    updateOccupancyPlots(mNEventPre);
+  }
+
+  // the annotations are refreshed once per cycle, not for each digit
+  ptNEvent->Clear();
+  ptNEvent->AddText(Form("Event Being Processed: %d", mNEvent));
+  QcInfoLogger::GetInstance() << "NEventDone = " << mNEvent << AliceO2::InfoLogger::InfoLogger::endm;
+
+  mLatency->exportSamples(getMonitoring().get());
 }
 
 void ITSRawTask::endOfActivity(Activity& /*activity*/)
@@ -717,12 +672,13 @@ void ITSRawTask::resetHitmaps()
     for (int iStave = 0; iStave < NStaves[iLayer]; iStave++) {
       for (int iHic = 0; iHic < nHicPerStave[iLayer]; iHic++) {
         hHicHitmap[iLayer][iStave][iHic]->Reset();
-        for (int iChip = 0; iChip < nChipsPerHic[iLayer]; iChip++) {
-          hChipHitmap[iLayer][iStave][iHic][iChip]->Reset();
-        }
       }
     }
   }
+  if (mHits) {
+    mHits->clear();
+    std::fill(mEtaPhiFolded.begin(), mEtaPhiFolded.end(), 0);
+  }
 }
 
 // reset method for all histos that are to be reset regularly
@@ -740,39 +696,88 @@ void ITSRawTask::resetOccupancyPlots()
 
 void ITSRawTask::updateOccupancyPlots(int nEvents)
 {
-  double pixelOccupancy, chipOccupancy;
-
   resetOccupancyPlots();
 
+  // the summaries of the chips are up to date after foldHits()
+  for (size_t chipID = 0; chipID < mChipLocations.size(); chipID++) {
+    const auto& location = mChipLocations[chipID];
+    uint64_t hits = mHits->getSummary(chipID).hits;
+    if (location.layer < 0 || hits == 0) {
+      continue;
+    }
+    double chipOccupancy = hits / ((double)nEvents * (double)NPixels);
+    if (location.layer < NLayerIB) {
+      hChipStaveOccupancy[location.layer]->Fill(location.chipInHic, location.stave, chipOccupancy);
+    } else {
+      hChipStaveOccupancy[location.layer]->Fill(location.hic, location.stave, chipOccupancy / nChipsPerHic[location.layer]);
+    }
+  }
+
+  // occupancy = hits / nEvents, so that the distribution of log10(occupancy) is the one of log10(hits), shifted
+  double logEvents = log10((double)nEvents);
   for (int iLayer = 0; iLayer < NLayer; iLayer++) {
     if (!mlayerEnable[iLayer]) {
       continue;
     }
-    //hEtaPhiHitmap[iLayer]->Reset();
-    for (int iStave = 0; iStave < NStaves[iLayer]; iStave++) {
-      for (int iHic = 0; iHic < nHicPerStave[iLayer]; iHic++) {
-        for (int iChip = 0; iChip < nChipsPerHic[iLayer]; iChip++) {
-          chipOccupancy = hChipHitmap[iLayer][iStave][iHic][iChip]->Integral();
-          chipOccupancy = chipOccupancy / ((double)nEvents * (double)NPixels);
-          // cout << "chipOcc = " << hChipHitmap[iLayer][iStave][iHic][iChip]->Integral() << ", " << iLayer << ", " << iStave << ", " << iHic << ", " << iChip << endl;
-          if (iLayer < NLayerIB) {
-            hChipStaveOccupancy[iLayer]->Fill(iChip, iStave, chipOccupancy);
-          } else {
-            hChipStaveOccupancy[iLayer]->Fill(iHic, iStave, chipOccupancy / nChipsPerHic[iLayer]);
-          }
-          for (int iCol = 0; iCol < NCols; iCol++) {
-            for (int iRow = 0; iRow < NRows; iRow++) {
-              pixelOccupancy = hChipHitmap[iLayer][iStave][iHic][iChip]->GetBinContent(iCol + 1, iRow + 1);
-              if (pixelOccupancy > 0) {
-                pixelOccupancy /= (double)nEvents;
-                hOccupancyPlot[iLayer]->Fill(log10(pixelOccupancy));
-              }
-            }
+    const auto& distribution = mHits->getHitDistribution(iLayer);
+    uint64_t firedPixels = 0;
+    for (int bin = 0; bin < ChipHitAccumulator::NLogBins; bin++) {
+      if (distribution[bin] > 0) {
+        hOccupancyPlot[iLayer]->Fill((bin + 0.5) * ChipHitAccumulator::LogBinWidth - logEvents, distribution[bin]);
+        firedPixels += distribution[bin];
+      }
+    }
+    hOccupancyPlot[iLayer]->SetEntries(firedPixels);
+  }
+}
+
+void ITSRawTask::foldHits()
+{
+  constexpr int regionsPerBlockRow = BlockRows / ChipHitAccumulator::RegionSize;
+  constexpr int regionsPerBlockCol = BlockCols / ChipHitAccumulator::RegionSize;
+  static_assert(BlockRows % ChipHitAccumulator::RegionSize == 0 && BlockCols % ChipHitAccumulator::RegionSize == 0,
+                "the eta-phi blocks must be made of whole regions");
+
+  mHits->fold([this](int chipID, uint64_t previousHits, const ChipHitAccumulator::Summary& summary) {
+    const auto& location = mChipLocations[chipID];
+    int lay = location.layer;
+    auto hicHitmap = hHicHitmap[lay][location.stave][location.hic];
+    double newHits = summary.hits - previousHits;
+
+    // the counters only grow until they are cleared together with the histograms, so that the HIC bins can be set
+    for (int regionRow = 0; regionRow < ChipHitAccumulator::NRegionRows; regionRow++) {
+      for (int regionCol = 0; regionCol < ChipHitAccumulator::NRegionCols; regionCol++) {
+        uint32_t regionHits = summary.regions[regionRow * ChipHitAccumulator::NRegionCols + regionCol];
+        if (regionHits == 0) {
+          continue;
+        }
+        int hicRow, hicCol;
+        getHicCoordinates(lay, location.chip, regionCol * ChipHitAccumulator::RegionSize,
+                          regionRow * ChipHitAccumulator::RegionSize, hicRow, hicCol);
+        hicHitmap->SetBinContent(hicCol / ChipHitAccumulator::RegionSize + 1, hicRow / ChipHitAccumulator::RegionSize + 1, regionHits);
+      }
+    }
+    hicHitmap->SetEntries(hicHitmap->GetEntries() + newHits);
+
+    // the eta-phi hitmap of the layer gathers several chips, so only the new hits of each block are added
+    for (int blockRow = 0; blockRow < NBlockRows; blockRow++) {
+      for (int blockCol = 0; blockCol < NBlockCols; blockCol++) {
+        uint32_t blockHits = 0;
+        for (int regionRow = blockRow * regionsPerBlockRow; regionRow < (blockRow + 1) * regionsPerBlockRow; regionRow++) {
+          const uint32_t* regions = summary.regions + regionRow * ChipHitAccumulator::NRegionCols + blockCol * regionsPerBlockCol;
+          for (int regionCol = 0; regionCol < regionsPerBlockCol; regionCol++) {
+            blockHits += regions[regionCol];
           }
         }
+        int block = location.firstEtaPhiBin + blockRow * NBlockCols + blockCol;
+        if (blockHits != mEtaPhiFolded[block]) {
+          hEtaPhiHitmap[lay]->AddBinContent(mEtaPhiBins[block], (double)blockHits - mEtaPhiFolded[block]);
+          mEtaPhiFolded[block] = blockHits;
+        }
       }
     }
-  }
+    hEtaPhiHitmap[lay]->SetEntries(hEtaPhiHitmap[lay]->GetEntries() + newHits);
+  });
 }
 
 void ITSRawTask::enableLayers()
@@ -0,0 +1,99 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   testChipHitAccumulator.cxx
+///
+
+#include "ITS/ChipHitAccumulator.h"
+
+#define BOOST_TEST_MODULE ChipHitAccumulator test
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+
+namespace o2
+{
+namespace quality_control_modules
+{
+namespace its
+{
+
+using Accumulator = ChipHitAccumulator;
+
+BOOST_AUTO_TEST_CASE(fold_regions)
+{
+  Accumulator accumulator({ 0, 0, 1 });
+  accumulator.add(1, 0, 0);
+  accumulator.add(1, 3, 3);
+  accumulator.add(1, 4, 0);
+  accumulator.add(1, 511, 1023);
+  BOOST_CHECK_EQUAL(accumulator.getNumberOfAllocatedChips(), 1);
+
+  int folded = 0;
+  accumulator.fold([&](int chip, uint64_t previousHits, const Accumulator::Summary& summary) {
+    folded++;
+    BOOST_CHECK_EQUAL(chip, 1);
+    BOOST_CHECK_EQUAL(previousHits, 0);
+    BOOST_CHECK_EQUAL(summary.hits, 4);
+    BOOST_CHECK_EQUAL(summary.firedPixels, 4);
+    BOOST_CHECK_EQUAL(summary.regions[0], 2);
+    BOOST_CHECK_EQUAL(summary.regions[Accumulator::NRegionCols], 1);
+    BOOST_CHECK_EQUAL(summary.regions[Accumulator::NRegionRows * Accumulator::NRegionCols - 1], 1);
+  });
+  BOOST_CHECK_EQUAL(folded, 1);
+
+  // only the chips with new hits are folded again
+  accumulator.fold([&](int, uint64_t, const Accumulator::Summary&) { folded++; });
+  BOOST_CHECK_EQUAL(folded, 1);
+  accumulator.add(1, 0, 0);
+  accumulator.fold([&](int, uint64_t previousHits, const Accumulator::Summary& summary) {
+    folded++;
+    BOOST_CHECK_EQUAL(previousHits, 4);
+    BOOST_CHECK_EQUAL(summary.hits, 5);
+    BOOST_CHECK_EQUAL(summary.regions[0], 3);
+  });
+  BOOST_CHECK_EQUAL(folded, 2);
+  BOOST_CHECK_EQUAL(accumulator.getSummary(1).hits, 5);
+}
+
+BOOST_AUTO_TEST_CASE(fold_distribution)
+{
+  Accumulator accumulator({ 0, 0, 1 });
+  for (int i = 0; i < 10; i++) {
+    accumulator.add(0, 10, 10);
+  }
+  accumulator.add(1, 10, 10);
+  accumulator.add(2, 10, 10);
+  accumulator.fold([](int, uint64_t, const Accumulator::Summary&) {});
+
+  // log10(1) = 0 and log10(10) = 1
+  const auto& distribution = accumulator.getHitDistribution(0);
+  BOOST_CHECK_EQUAL(distribution[0], 1);
+  BOOST_CHECK_EQUAL(distribution[static_cast<int>(1 / Accumulator::LogBinWidth)], 1);
+  BOOST_CHECK_EQUAL(accumulator.getHitDistribution(1)[0], 1);
+
+  // the previous contribution of a chip is replaced when it is folded again
+  accumulator.add(1, 10, 10);
+  accumulator.fold([](int, uint64_t, const Accumulator::Summary&) {});
+  BOOST_CHECK_EQUAL(distribution[0], 0);
+  BOOST_CHECK_EQUAL(distribution[static_cast<int>(std::log10(2) / Accumulator::LogBinWidth)], 1);
+
+  accumulator.clear();
+  BOOST_CHECK_EQUAL(accumulator.getNumberOfAllocatedChips(), 0);
+  BOOST_CHECK_EQUAL(accumulator.getSummary(0).hits, 0);
+  BOOST_CHECK_EQUAL(distribution[static_cast<int>(1 / Accumulator::LogBinWidth)], 0);
+}
+
+} // namespace its
+} // namespace quality_control_modules
+} // namespace o2
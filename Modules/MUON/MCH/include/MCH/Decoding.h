@@ -7,10 +7,15 @@
 #define QC_MODULE_MUONCHAMBERS_DATA_DECODER_H
 
 #include "QualityControl/TaskInterface.h"
+#include "QualityControl/WorkerPool.h"
 #include "MCH/sampa_header.h"
 #include "MCH/Mapping.h"
+#include "MCH/SampaHitBuffer.h"
+#include "MCH/DecodingErrors.h"
 #include "MCHBase/Digit.h"
 
+#include <memory>
+
 using namespace o2::quality_control::core;
 
 namespace o2
@@ -31,15 +36,6 @@ enum DualSampaStatus {
   //OK = 8 // Data block filled (over a time window)
 };
 
-struct SampaHit {
-  uint8_t cru_id, link_id, ds_addr, chan_addr;
-  int64_t bxc;
-  uint32_t size, time;
-  std::vector<uint16_t> samples;
-  uint64_t csum;
-  MapPad pad;
-};
-
 struct DualSampa {
   int id;
   DualSampaStatus status;          // Status during the data filling
@@ -58,6 +54,7 @@ struct DualSampa {
   int nclus[2][32];
   double pedestal[2][32], noise[2][32];
   SampaHit hit;
+  std::vector<uint16_t> samples; // samples of the hit being decoded, the memory is kept between the hits
 };
 
 struct DualSampaGroup {
@@ -75,14 +72,22 @@ class Decoder
   ~Decoder();
 
   // Definition of the methods for the template method pattern
-  void initialize();
+  /// \param padTableFile file where the pad lookup table is cached between the runs, none if empty
+  void initialize(std::string padTableFile = "");
+  /// \brief Decodes the links of the CRUs in parallel, in the given number of threads.
+  /// The pages of each (CRU, link) are decoded in order by a single thread, the hits are then merged in the order
+  /// of the pages. With less than two threads, the buffers are decoded in the calling thread.
+  void setNumberOfThreads(size_t threads);
   void processData(const char* buf, size_t size);
   void decodeRaw(uint32_t* payload_buf, size_t nGBTwords, int cru_id, int link_id);
   void decodeUL(uint32_t* payload_buf, size_t nWords, int cru_id, int dpw_id);
   void clearHits();
   void clearDigits();
-  std::vector<SampaHit>& getHits() { return mHits; }
+  /// Hits of the last buffer given to processData()
+  SampaHitBuffer& getHits() { return mHits; }
   std::vector<o2::mch::Digit>& getDigits() { return mDigits; }
+  /// Errors found in the data since the initialization
+  DecodingErrors& getErrors() { return mErrors; }
   void reset();
 
   int32_t getMapCRU(int cruid, int linkid) { return mMapCRU.getLink(cruid, linkid); }
@@ -95,15 +100,51 @@ class Decoder
   MapFEC& getMapFEC() { return mMapFEC; }
 
  private:
+  /// Piece of work found in a buffer: the decoding of one page, or the reset of the links after an orbit jump.
+  struct DecodingStep {
+    enum Type { ResetLinks, RawPage, ULPage } type;
+    int cruId;
+    int linkMin, linkMax; // links whose state is used by the step
+    uint32_t* payload;
+    size_t nWords;
+    int linkId; // CRU link of the raw pages, DPW of the UL pages
+    // hits of the page, in the buffer of the link group which decoded it
+    SampaHitBuffer* hits;
+    size_t firstHit, lastHit;
+  };
+  /// Links decoded by the same thread, and the steps which use them in the order of the buffer.
+  struct LinkGroup {
+    int cruId, linkMin, linkMax;
+    std::vector<size_t> steps;
+    SampaHitBuffer hits;
+  };
+
+  void executeStep(DecodingStep& step, SampaHitBuffer& hits, int linkMin, int linkMax);
+  /// Returns false if the steps cannot be decoded in parallel, the links used by the pages overlapping.
+  bool decodeInParallel();
+  void resetLinks(int cruId, int linkMin, int linkMax);
+  /// Assigns the pads to the hits and converts their channel address.
+  void mapHits(gsl::span<SampaHit> hits);
+  void decodeRaw(uint32_t* payload_buf, size_t nGBTwords, int cru_id, int link_id, SampaHitBuffer& hits);
+  void decodeUL(uint32_t* payload_buf, size_t nWords, int cru_id, int dpw_id, SampaHitBuffer& hits);
+  /// Decodes the bits received on one e-link, the oldest bit being the least significant one.
+  void decodeELink(uint64_t bits, int nbits, int cru_id, int link_id, int ds_id, SampaHitBuffer& hits);
+
   int hb_orbit;
   DualSampa ds[MCH_MAX_CRU_ID][24][40];
   DualSampaGroup dsg[MCH_MAX_CRU_ID][24][8];
   int ds_enable[MCH_MAX_CRU_IN_FLP][24][40];
-  std::vector<SampaHit> mHits;
+  SampaHitBuffer mHits;
   std::vector<o2::mch::Digit> mDigits;
   int nFrames;
   MapCRU mMapCRU;
   MapFEC mMapFEC;
+  DecodingErrors mErrors;
+
+  std::unique_ptr<o2::quality_control::core::WorkerPool> mWorkers;
+  std::vector<DecodingStep> mSteps;
+  std::vector<LinkGroup> mGroups; // kept between the buffers to reuse the memory of the hits
+  size_t mNGroups = 0;
 };
 
 } // namespace muonchambers
@@ -0,0 +1,102 @@
+///
+/// \file   DecodingErrors.h
+///
+
+#ifndef QC_MODULE_MUONCHAMBERS_DECODINGERRORS_H
+#define QC_MODULE_MUONCHAMBERS_DECODINGERRORS_H
+
+#include "MCH/Mapping.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class TH2F;
+
+namespace o2::monitoring
+{
+class Monitoring;
+}
+
+namespace o2::quality_control_modules::muonchambers
+{
+
+enum class DecodingError : uint8_t {
+  WrongRdh,           // RDH with a wrong version or size
+  WrongLink,          // CRU, link or DS board address outside of the decoder arrays
+  HeaderParity,       // parity error in a SAMPA header
+  HammingError,       // Hamming error in a SAMPA header
+  BunchCrossing,      // bunch crossing counter different from the one of the other chips of the link
+  TruncatedPacket,    // packet of type 1 or 3
+  Heartbeat,          // packet of type 0
+  UnexpectedPacket,   // packet of type 5
+  UnexpectedSync,     // packet of type 2
+  ChipAddress,        // chip address which does not belong to the DS board
+  ChannelAddress,     // channel address out of the expected sequence
+  ClusterSize,        // cluster larger than its packet
+  PacketEnd,          // end of the packet in the middle of a cluster
+  Count
+};
+
+/// \brief Counters of the errors found while decoding the MCH data, for each CRU link
+///
+/// The errors are counted and not printed, so that corrupted data does not slow down the decoding. A few samples of
+/// the offending words are kept in each cycle for the logs. The errors can be added from several decoding threads.
+class DecodingErrors
+{
+ public:
+  static constexpr int sNLinks = MCH_MAX_CRU_ID * 24;
+  static constexpr int sNErrors = static_cast<int>(DecodingError::Count);
+
+  struct Sample {
+    int cruId, linkId, dsAddr;
+    DecodingError error;
+    uint64_t word;
+  };
+
+  /// \param maxSamples  number of samples of offending words kept between two calls to logSamples()
+  explicit DecodingErrors(size_t maxSamples = 10);
+
+  /// Counts an error. The errors of the links out of range are counted together.
+  void add(int cruId, int linkId, int dsAddr, DecodingError error, uint64_t word)
+  {
+    bool known = cruId >= 0 && cruId < MCH_MAX_CRU_ID && linkId >= 0 && linkId < 24;
+    int link = known ? (cruId * 24 + linkId) : sNLinks;
+    mCounters[link * sNErrors + static_cast<int>(error)].fetch_add(1, std::memory_order_relaxed);
+    if (mFreeSamples.load(std::memory_order_relaxed) > 0) {
+      addSample({ cruId, linkId, dsAddr, error, word });
+    }
+  }
+
+  /// Number of errors since the last reset, for the link, or for all the links with cruId < 0.
+  uint64_t get(DecodingError error, int cruId = -1, int linkId = -1) const;
+  void setMaxSamples(size_t maxSamples);
+  void reset();
+
+  static const char* getName(DecodingError error);
+
+  /// Creates a histogram of the number of errors for each link (x) and type (y).
+  static TH2F* createHistogram(const char* name);
+  void fillHistogram(TH2F* histogram) const;
+  /// Sends the number of errors of each type, summed over the links.
+  void sendMetrics(o2::monitoring::Monitoring& monitoring) const;
+  /// Logs the samples kept since the previous call, and the number of errors which could not be kept.
+  void logSamples();
+
+ private:
+  void addSample(const Sample& sample);
+  uint64_t getTotal() const;
+
+  std::unique_ptr<std::atomic<uint64_t>[]> mCounters; // [link][error], the last link gathers the unknown ones
+  size_t mMaxSamples;
+  std::atomic<int64_t> mFreeSamples;
+  std::mutex mSamplesMutex;
+  std::vector<Sample> mSamples;
+  uint64_t mTotalAtLastLog = 0;
+};
+
+} // namespace o2::quality_control_modules::muonchambers
+
+#endif // QC_MODULE_MUONCHAMBERS_DECODINGERRORS_H
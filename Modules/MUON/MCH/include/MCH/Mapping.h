@@ -7,6 +7,7 @@
 #define QC_MODULE_MUONCHAMBERS_MAPPING_H
 
 #include "MCHMappingInterface/Segmentation.h"
+#include "MCH/PadTable.h"
 
 #include "QualityControl/TaskInterface.h"
 
@@ -78,10 +79,16 @@ class MapFEC
 {
 
   MapDualSampa mDsMap[LINKID_MAX + 1][40];
+  PadTable mPadTable;
+
+  bool getPadBySegmentation(uint32_t de, uint32_t dsid, uint32_t dsch, MapPad& pad);
 
  public:
   MapFEC();
   bool readDSMapping(std::string mapFile);
+  /// Prepares the pad lookups of the DS in the map, loading the table from cacheFile if it matches the map,
+  /// or building it from the segmentation and saving it there otherwise. No file is used if cacheFile is empty.
+  void initPadTable(std::string cacheFile = "");
   bool getDSMapping(uint32_t link_id, uint32_t ds_addr, uint32_t& de, uint32_t& dsid);
   bool getPadByLinkID(uint32_t link_id, uint32_t ds_addr, uint32_t dsch, MapPad& pad);
   bool getPadByDE(uint32_t de, uint32_t dsis, uint32_t dsch, MapPad& pad);
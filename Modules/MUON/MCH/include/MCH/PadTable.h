@@ -0,0 +1,92 @@
+///
+/// \file   PadTable.h
+///
+
+#ifndef QC_MODULE_MUONCHAMBERS_PADTABLE_H
+#define QC_MODULE_MUONCHAMBERS_PADTABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace o2::quality_control_modules::muonchambers
+{
+
+/// \brief Dense (DE, DS ID, channel) -> pad lookup table
+///
+/// The table is filled once from the segmentation, after which the lookups need neither exceptions nor allocations.
+/// It is stored in a single buffer with the same layout as its file, so that a saved table can be memory-mapped
+/// instead of being built again. The file is identified by a key computed from the list of dual SAMPAs, and it holds a
+/// fingerprint of the mapping it was built with, so that a file made with another mapping is not used.
+class PadTable
+{
+ public:
+  struct Pad {
+    int32_t padId;   // pad ID in the segmentation of the DE, or one of the codes below
+    float x;         // x coordinate (cm)
+    float y;         // y coordinate (cm)
+    float sizeX;     // dimension along x (cm)
+    float sizeY;     // dimension along y (cm)
+    int32_t cathode; // 0 for bending, 1 for non-bending
+  };
+
+  static constexpr int32_t sNoPad = -1;              // the channel is not connected to a pad
+  static constexpr int32_t sUnknownDualSampa = -2;   // the segmentation does not know the DE or the DS ID
+  static constexpr uint32_t sChannelsPerDualSampa = 64;
+
+  PadTable() = default;
+  ~PadTable();
+  PadTable(const PadTable&) = delete;
+  PadTable& operator=(const PadTable&) = delete;
+
+  /// Identifies a list of (DE, DS ID) pairs, whatever their order and duplicates.
+  static uint64_t computeKey(std::vector<std::pair<uint32_t, uint32_t>> dualSampas);
+
+  /// Fills the table with the 64 channels of each (DE, DS ID) pair.
+  void build(const std::vector<std::pair<uint32_t, uint32_t>>& dualSampas);
+  /// Writes the table to a file which can be loaded back with load().
+  bool save(const std::string& path) const;
+  /// Memory-maps a table saved with the given key, returns false if the file is missing, corrupted or stale,
+  /// including when it was built with another mapping.
+  bool load(const std::string& path, uint64_t key);
+  void clear();
+
+  bool empty() const { return mNumberOfDEs == 0; }
+  bool isMapped() const { return mMapped != nullptr; }
+  uint64_t getKey() const { return mKey; }
+
+  /// Returns the entry of the channel, or nullptr if the (DE, DS ID) pair is not in the table.
+  const Pad* find(uint32_t de, uint32_t dsid, uint32_t channel) const
+  {
+    if (de >= mNumberOfDEs || dsid >= mDualSampaCount[de] || channel >= sChannelsPerDualSampa) {
+      return nullptr;
+    }
+    int32_t block = mBlocks[mFirstDualSampa[de] + dsid];
+    return block < 0 ? nullptr : &mPads[block * sChannelsPerDualSampa + channel];
+  }
+
+ private:
+  // sets the pointers to the arrays of a buffer with the file layout, which is expected to be valid
+  void attach(const char* buffer);
+  // checks the consistency of a buffer with the file layout and with the current mapping
+  static bool validate(const char* buffer, size_t size, uint64_t key);
+  // identifies the mapping library and summarizes its content for the DEs with a non-zero count
+  static uint64_t computeMappingFingerprint(const uint32_t* dualSampaCount, uint32_t numberOfDEs);
+
+  std::vector<char> mBuffer; // when built
+  void* mMapped = nullptr;   // when loaded
+  size_t mMappedSize = 0;
+
+  uint64_t mKey = 0;
+  uint32_t mNumberOfDEs = 0;
+  const uint32_t* mFirstDualSampa = nullptr; // first slot of each DE in mBlocks
+  const uint32_t* mDualSampaCount = nullptr; // number of slots of each DE, i.e. its largest DS ID + 1
+  const int32_t* mBlocks = nullptr;          // block of 64 pads of each slot, -1 if the DS is not in the table
+  const Pad* mPads = nullptr;
+};
+
+} // namespace o2::quality_control_modules::muonchambers
+
+#endif // QC_MODULE_MUONCHAMBERS_PADTABLE_H
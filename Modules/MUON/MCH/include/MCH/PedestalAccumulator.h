@@ -0,0 +1,98 @@
+///
+/// \file   PedestalAccumulator.h
+///
+
+#ifndef QC_MODULE_MUONCHAMBERS_PEDESTALACCUMULATOR_H
+#define QC_MODULE_MUONCHAMBERS_PEDESTALACCUMULATOR_H
+
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace o2::quality_control_modules::muonchambers
+{
+
+/// \brief Mean and RMS of the samples of the channels which received data
+///
+/// The channels are identified by a 32-bit key and stored only once they receive their first sample. The statistics
+/// are updated with the Welford algorithm, in a form which keeps the stored values of the order of the samples, so
+/// that single precision is enough. The channels updated since the last call to takeChanged() are remembered,
+/// so that the histograms can be refreshed only for them.
+class PedestalAccumulator
+{
+ public:
+  struct Channel {
+    uint32_t key;
+    uint32_t entries = 0;
+    float mean = 0;
+    float variance = 0;   // of the population
+    float lastNoise = -1; // noise given to the histograms by the user, negative if none
+    bool changed = false;
+
+    float pedestal() const { return mean; }
+    float noise() const { return std::sqrt(variance); }
+  };
+
+  /// Returns the channel, creating it if it did not receive data yet. The reference is valid until a channel is created.
+  Channel& get(uint32_t key)
+  {
+    auto [it, inserted] = mIndex.try_emplace(key, mChannels.size());
+    if (inserted) {
+      mChannels.push_back(Channel{ key });
+    }
+    return mChannels[it->second];
+  }
+
+  /// Adds one sample to the channel.
+  void add(Channel& channel, float sample)
+  {
+    if (!channel.changed) {
+      channel.changed = true;
+      mChanged.push_back(&channel - mChannels.data());
+    }
+    channel.entries++;
+    float delta = sample - channel.mean;
+    channel.mean += delta / channel.entries;
+    channel.variance += (delta * (sample - channel.mean) - channel.variance) / channel.entries;
+  }
+
+  void add(uint32_t key, float sample) { add(get(key), sample); }
+
+  /// Calls function(Channel&) for each channel updated since the previous call, and forgets them.
+  template <typename Function>
+  void takeChanged(Function&& function)
+  {
+    for (uint32_t index : mChanged) {
+      Channel& channel = mChannels[index];
+      channel.changed = false;
+      function(channel);
+    }
+    mChanged.clear();
+  }
+
+  const Channel* find(uint32_t key) const
+  {
+    auto it = mIndex.find(key);
+    return it == mIndex.end() ? nullptr : &mChannels[it->second];
+  }
+
+  size_t size() const { return mChannels.size(); }
+  size_t getNumberOfChanged() const { return mChanged.size(); }
+
+  void clear()
+  {
+    mIndex.clear();
+    mChannels.clear();
+    mChanged.clear();
+  }
+
+ private:
+  std::unordered_map<uint32_t, uint32_t> mIndex; // key -> position in mChannels
+  std::vector<Channel> mChannels;
+  std::vector<uint32_t> mChanged; // positions of the channels changed since the last takeChanged()
+};
+
+} // namespace o2::quality_control_modules::muonchambers
+
+#endif // QC_MODULE_MUONCHAMBERS_PEDESTALACCUMULATOR_H
@@ -9,6 +9,7 @@
 #include "QualityControl/TaskInterface.h"
 #include "MCH/Mapping.h"
 #include "MCH/Decoding.h"
+#include "MCH/PedestalAccumulator.h"
 #include "MCHBase/Digit.h"
 
 class TH1F;
@@ -43,19 +44,14 @@ class PedestalsTask final : public TaskInterface
 
  private:
   Decoder mDecoder;
-  uint64_t nhits[MCH_MAX_CRU_IN_FLP][24][40][64];
-  double pedestal[MCH_MAX_CRU_IN_FLP][24][40][64];
-  double noise[MCH_MAX_CRU_IN_FLP][24][40][64];
-
-  //Matrices [de][padid], stated an upper value for de# and padid#
-
-  uint64_t nhitsDigits[1100][1500];
-  double pedestalDigits[1100][1500];
-  double noiseDigits[1100][1500];
+  // pedestal statistics of the channels which received data, the histograms are updated at the end of each cycle
+  PedestalAccumulator mElectronicsPedestals; // keyed by CRU, link, DS address and channel address
+  PedestalAccumulator mDigitPedestals;       // keyed by DE and pad ID
 
   MapCRU mMapCRU[MCH_MAX_CRU_IN_FLP];
   TH2F* mHistogramPedestals[MCH_MAX_CRU_IN_FLP * 24];
   TH2F* mHistogramNoise[MCH_MAX_CRU_IN_FLP * 24];
+  TH2F* mHistogramDecodingErrors;
 
   std::vector<int> DEs;
   //MapFEC mMapFEC;
@@ -68,8 +64,9 @@ class PedestalsTask final : public TaskInterface
 
   int mPrintLevel;
 
-  void fill_noise_distributions();
-  void save_histograms();
+  void updateElectronicsHistograms();
+  void updateDigitHistograms();
+  void updateNoiseDistribution(int de, const MapPad& pad, PedestalAccumulator::Channel& channel);
 };
 
 } // namespace o2
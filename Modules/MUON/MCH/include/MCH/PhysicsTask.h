@@ -49,7 +49,6 @@ class PhysicsTask /*final*/ : public TaskInterface // todo add back the "final"
   void storeDigits(void* bufferPtr);
 
  private:
-  int count;
   Decoder mDecoder;
   uint64_t nhits[24][40][64];
 
@@ -58,6 +57,7 @@ class PhysicsTask /*final*/ : public TaskInterface // todo add back the "final"
   int nDigits;
 
   TH2F* mHistogramNhits[72];
+  TH2F* mHistogramDecodingErrors;
   TH1F* mHistogramADCamplitude[72];
   std::vector<int> DEs;
   std::map<int, TH1F*> mHistogramADCamplitudeDE;
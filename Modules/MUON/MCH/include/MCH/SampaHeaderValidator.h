@@ -0,0 +1,38 @@
+///
+/// \file   SampaHeaderValidator.h
+///
+
+#ifndef QC_MODULE_MUONCHAMBERS_SAMPAHEADERVALIDATOR_H
+#define QC_MODULE_MUONCHAMBERS_SAMPAHEADERVALIDATOR_H
+
+#include <cstdint>
+
+namespace o2::quality_control_modules::muonchambers
+{
+
+/// \brief Validation of the SAMPA headers, packed in the 50 lowest bits of an integer.
+///
+/// The 6 Hamming bits of the header protect its 43 data bits (bits 7 to 49), bit 6 being the parity of the other ones.
+/// The syndrome is computed with one table lookup per byte of the header and the parity with a popcount.
+class SampaHeaderValidator
+{
+ public:
+  struct HammingResult {
+    bool error = false;         ///< wrong Hamming code or parity
+    bool uncorrectable = false; ///< more than one wrong bit
+  };
+
+  static constexpr uint64_t headerMask = 0x3FFFFFFFFFFFF;
+
+  /// XOR of the 50 bits of the header, 0 for a valid header.
+  static int parity(uint64_t header) { return __builtin_popcountll(header & headerMask) & 0x1; }
+  /// 0 if the Hamming code matches the data, otherwise the position of a wrong bit in the interleaved code word.
+  static uint8_t syndrome(uint64_t header);
+  static HammingResult check(uint64_t header);
+  /// Returns the header with its wrong bit corrected if there is only one, the bits above the header are kept.
+  static uint64_t correct(uint64_t header);
+};
+
+} // namespace o2::quality_control_modules::muonchambers
+
+#endif // QC_MODULE_MUONCHAMBERS_SAMPAHEADERVALIDATOR_H
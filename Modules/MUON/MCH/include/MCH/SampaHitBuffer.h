@@ -0,0 +1,69 @@
+///
+/// \file   SampaHitBuffer.h
+///
+
+#ifndef QC_MODULE_MUONCHAMBERS_SAMPAHITBUFFER_H
+#define QC_MODULE_MUONCHAMBERS_SAMPAHITBUFFER_H
+
+#include "MCH/Mapping.h"
+
+#include <gsl/span>
+#include <cstdint>
+#include <vector>
+
+namespace o2::quality_control_modules::muonchambers
+{
+
+struct SampaHit {
+  uint8_t cru_id, link_id, ds_addr, chan_addr;
+  int64_t bxc;
+  uint32_t size, time;
+  uint32_t firstSample; // position of the samples in the pool of the buffer
+  uint32_t nSamples;
+  uint64_t csum;
+  MapPad pad;
+};
+
+/// \brief Hits decoded from a buffer, with their samples stored one after the other in a single pool
+///
+/// Clearing the buffer keeps its memory, so that the decoding of the next buffer does not allocate
+/// once the largest one has been seen.
+class SampaHitBuffer
+{
+ public:
+  void clear()
+  {
+    mHits.clear();
+    mSamples.clear();
+  }
+
+  /// Appends a hit and copies its samples to the pool.
+  void add(const SampaHit& hit, gsl::span<const uint16_t> samples)
+  {
+    SampaHit& added = mHits.emplace_back(hit);
+    added.firstSample = mSamples.size();
+    added.nSamples = samples.size();
+    mSamples.insert(mSamples.end(), samples.begin(), samples.end());
+  }
+
+  size_t size() const { return mHits.size(); }
+  bool empty() const { return mHits.empty(); }
+
+  gsl::span<SampaHit> hits() { return mHits; }
+  gsl::span<const SampaHit> hits() const { return mHits; }
+  /// Hits added since the buffer had the given size.
+  gsl::span<SampaHit> hitsFrom(size_t first) { return hits().subspan(first); }
+
+  gsl::span<const uint16_t> samples(const SampaHit& hit) const
+  {
+    return gsl::span<const uint16_t>(mSamples.data() + hit.firstSample, hit.nSamples);
+  }
+
+ private:
+  std::vector<SampaHit> mHits;
+  std::vector<uint16_t> mSamples;
+};
+
+} // namespace o2::quality_control_modules::muonchambers
+
+#endif // QC_MODULE_MUONCHAMBERS_SAMPAHITBUFFER_H
@@ -10,19 +10,16 @@
 #include "Headers/RAWDataHeader.h"
 #include "QualityControl/QcInfoLogger.h"
 #include "MCH/Decoding.h"
+#include "MCH/SampaHeaderValidator.h"
 #include "MCHBase/Digit.h"
 #define __STDC_FORMAT_MACROS
 #include <cinttypes>
+#include <algorithm>
+#include <array>
+#include <unordered_map>
 
 using namespace std;
 
-static int gPrintLevel;
-static int gPattern;
-static int gNbErrors;
-static int gNbWarnings;
-
-static FILE* flog = NULL;
-
 struct CRUheader {
   uint8_t header_version;
   uint8_t header_size;
@@ -60,6 +57,21 @@ namespace quality_control_modules
 namespace muonchambers
 {
 
+/// Errors found on the e-links of one CRU link
+struct LinkErrors {
+  DecodingErrors& errors;
+  int cruId, linkId;
+
+  void add(const DualSampa& ds, DecodingError error, uint64_t word) const { errors.add(cruId, linkId, ds.id, error, word); }
+  /// Adds an error of the packet being read, reported with its header.
+  void addInPacket(const DualSampa& ds, DecodingError error) const
+  {
+    uint64_t header = 0;
+    memcpy(&header, &(ds.header), sizeof(ds.header));
+    add(ds, error, header);
+  }
+};
+
 bool BXCNT_compare(long int c1, long int c2)
 {
   const int64_t MAX = 0xFFFFF;
@@ -79,8 +91,6 @@ bool BXCNT_compare(long int c1, long int c2)
 
 void DualSampaInit(DualSampa* ds)
 {
-  if (gPrintLevel >= 4)
-    fprintf(flog, "DualSampaInit() called\n");
   ds->status = notSynchronized;
   ds->data = 0;
   ds->bit = 0;
@@ -101,8 +111,6 @@ void DualSampaInit(DualSampa* ds)
 
 void DualSampaReset(DualSampa* ds)
 {
-  if (gPrintLevel >= 4)
-    fprintf(flog, "DualSampaReset() called\n");
   ds->status = notSynchronized;
   ds->data = 0;
   ds->bit = 0;
@@ -123,327 +131,57 @@ void DualSampaGroupReset(DualSampaGroup* dsg)
   dsg->bxc = -1;
 }
 
-int CheckDataParity(uint64_t data)
+/// Number of bits of the next field expected on an e-link: 50 for the headers, 10 for the words of the payload.
+int FieldWidth(const DualSampa& ds)
 {
-  //    int parity,bit;
-  //    parity = data&0x1;
-  //    for (int i = 1; i <= 50; i++)
-  //    {
-  //        bit = (data>>i)&0x1;
-  //        //        parity = (parity || bit) && (!(parity && bit));
-  //        parity += bit; // Count the number of bits = 1
-  //    }
-  int parity, bit;
-  parity = data & 0x1;
-  for (int i = 1; i < 50; i++) {
-    bit = (data >> i) & 0x1;
-    parity = (parity || bit) && (!(parity && bit)); // XOR of all bits
-  }
-  return parity;
+  return (ds.status == notSynchronized || ds.status == headerToRead) ? 50 : 10;
 }
 
-void HammingDecode(unsigned int buffer[2], bool& error, bool& uncorrectable, bool fix_data)
-//
-// From Arild Velure code
-//
+/// Looks for the sync word in the bits received on a not synchronized e-link, the oldest bit being the least significant.
+/// The last 50 bits are kept in ds.data. Returns the number of bits consumed, which is less than nbits when the sync
+/// word is found.
+int FindSyncWord(uint64_t bits, int nbits, DualSampa& ds, decode_state_t& result)
 {
-
-  // header split
-  bool parityreceived[6];
-  bool data_in[43];
-  bool overallparity;
-
-  for (int i = 0; i < 6; i++)
-    parityreceived[i] = (buffer[0] >> i) & 0x1;
-  overallparity = (buffer[0] >> 6) & 0x1;
-  //for (int i = 0; i < 43; i++)
-  //  data_in[i] = (header_in >> (i + 7)) & 0x1;
-  for (int i = 7; i < 30; i++)
-    data_in[i - 7] = (buffer[0] >> i) & 0x1;
-  for (int i = 30; i < 50; i++)
-    data_in[i - 7] = (buffer[1] >> (i - 30)) & 0x1;
-
-  //calculated values
-  bool corrected_out[43];
-  bool overallparitycalc = 0;
-  bool overallparity_out = 0;
-  bool paritycalc[6];
-  bool paritycorreced_out[6];
-
-  ////////////////////////////////////////////////////////////////////////////////////////////////
-  // calculate parity
-  paritycalc[0] = data_in[0] ^ data_in[1] ^ data_in[3] ^ data_in[4] ^ data_in[6] ^
-                  data_in[8] ^ data_in[10] ^ data_in[11] ^ data_in[13] ^ data_in[15] ^
-                  data_in[17] ^ data_in[19] ^ data_in[21] ^ data_in[23] ^ data_in[25] ^
-                  data_in[26] ^ data_in[28] ^ data_in[30] ^ data_in[32] ^ data_in[34] ^
-                  data_in[36] ^ data_in[38] ^ data_in[40] ^ data_in[42];
-
-  paritycalc[1] = data_in[0] ^ data_in[2] ^ data_in[3] ^ data_in[5] ^ data_in[6] ^
-                  data_in[9] ^ data_in[10] ^ data_in[12] ^ data_in[13] ^ data_in[16] ^
-                  data_in[17] ^ data_in[20] ^ data_in[21] ^ data_in[24] ^ data_in[25] ^
-                  data_in[27] ^ data_in[28] ^ data_in[31] ^ data_in[32] ^ data_in[35] ^
-                  data_in[36] ^ data_in[39] ^ data_in[40];
-
-  paritycalc[2] = data_in[1] ^ data_in[2] ^ data_in[3] ^ data_in[7] ^ data_in[8] ^
-                  data_in[9] ^ data_in[10] ^ data_in[14] ^ data_in[15] ^ data_in[16] ^
-                  data_in[17] ^ data_in[22] ^ data_in[23] ^ data_in[24] ^ data_in[25] ^
-                  data_in[29] ^ data_in[30] ^ data_in[31] ^ data_in[32] ^ data_in[37] ^
-                  data_in[38] ^ data_in[39] ^ data_in[40];
-
-  paritycalc[3] = data_in[4] ^ data_in[5] ^ data_in[6] ^ data_in[7] ^ data_in[8] ^
-                  data_in[9] ^ data_in[10] ^ data_in[18] ^ data_in[19] ^ data_in[20] ^
-                  data_in[21] ^ data_in[22] ^ data_in[23] ^ data_in[24] ^ data_in[25] ^
-                  data_in[33] ^ data_in[34] ^ data_in[35] ^ data_in[36] ^ data_in[37] ^
-                  data_in[38] ^ data_in[39] ^ data_in[40];
-
-  paritycalc[4] = data_in[11] ^ data_in[12] ^ data_in[13] ^ data_in[14] ^ data_in[15] ^
-                  data_in[16] ^ data_in[17] ^ data_in[18] ^ data_in[19] ^ data_in[20] ^
-                  data_in[21] ^ data_in[22] ^ data_in[23] ^ data_in[24] ^ data_in[25] ^
-                  data_in[41] ^ data_in[42];
-
-  paritycalc[5] = data_in[26] ^ data_in[27] ^ data_in[28] ^ data_in[29] ^ data_in[30] ^
-                  data_in[31] ^ data_in[32] ^ data_in[33] ^ data_in[34] ^ data_in[35] ^
-                  data_in[36] ^ data_in[37] ^ data_in[38] ^ data_in[39] ^ data_in[40] ^
-                  data_in[41] ^ data_in[42];
-  ////////////////////////////////////////////////////////////////////////////////////////////////
-
-  //    uint8_t syndrome = 0;
-  unsigned char syndrome = 0;
-
-  for (int i = 0; i < 6; i++)
-    syndrome |= (paritycalc[i] ^ parityreceived[i]) << i;
-
-  bool data_parity_interleaved[64];
-  bool syndromeerror;
-
-  //data_parity_interleaved[0]          =  0;
-  data_parity_interleaved[1] = parityreceived[0];
-  data_parity_interleaved[2] = parityreceived[1];
-  data_parity_interleaved[3] = data_in[0];
-  data_parity_interleaved[4] = parityreceived[2];
-  for (int i = 1; i <= 3; i++)
-    data_parity_interleaved[i + 5 - 1] = data_in[i];
-  data_parity_interleaved[8] = parityreceived[3];
-  for (int i = 4; i <= 10; i++)
-    data_parity_interleaved[i + 9 - 4] = data_in[i];
-  data_parity_interleaved[16] = parityreceived[4];
-  for (int i = 11; i <= 25; i++)
-    data_parity_interleaved[i + 17 - 11] = data_in[i];
-  data_parity_interleaved[32] = parityreceived[5];
-  for (int i = 26; i <= 42; i++)
-    data_parity_interleaved[i + 33 - 26] = data_in[i];
-  //for (int i = 50; i <= 63; i++)
-  //  data_parity_interleaved[i]        =  0;
-
-  data_parity_interleaved[syndrome] = !data_parity_interleaved[syndrome]; // correct the interleaved
-
-  paritycorreced_out[0] = data_parity_interleaved[1];
-  paritycorreced_out[1] = data_parity_interleaved[2];
-  corrected_out[0] = data_parity_interleaved[3];
-  paritycorreced_out[2] = data_parity_interleaved[4];
-  for (int i = 1; i <= 3; i++)
-    corrected_out[i] = data_parity_interleaved[i + 5 - 1];
-  paritycorreced_out[3] = data_parity_interleaved[8];
-  for (int i = 4; i <= 10; i++)
-    corrected_out[i] = data_parity_interleaved[i + 9 - 4];
-  paritycorreced_out[4] = data_parity_interleaved[16];
-  for (int i = 11; i <= 25; i++)
-    corrected_out[i] = data_parity_interleaved[i + 17 - 11];
-  paritycorreced_out[5] = data_parity_interleaved[32];
-  for (int i = 26; i <= 42; i++)
-    corrected_out[i] = data_parity_interleaved[i + 33 - 26];
-
-  // now we have the "corrected" data -> update the flags
-
-  bool wrongparity;
-  for (int i = 0; i < 43; i++)
-    overallparitycalc ^= data_in[i];
-  for (int i = 0; i < 6; i++)
-    overallparitycalc ^= parityreceived[i];
-  syndromeerror = (syndrome > 0) ? 1 : 0; // error if syndrome larger than 0
-  wrongparity = (overallparitycalc != overallparity);
-  overallparity_out = !syndromeerror && wrongparity ? overallparitycalc : overallparity; // If error was in parity fix parity
-  error = syndromeerror | wrongparity;
-  uncorrectable = (syndromeerror && (!wrongparity));
-
-  //header_out = 0;
-  //for (int i = 0; i < 43; i++)
-  //  header_out |= corrected_out[i] << (i + 7);
-  //header_out |= overallparity_out << 6;
-  //for (int i = 0; i < 6; i++)
-  //  header_out |= paritycorreced_out[i] << i;
-  if (fix_data) {
-    for (int i = 0; i < 6; i++)
-      buffer[0] = (buffer[0] & ~(1 << i)) | (paritycorreced_out[i] << i);
-    buffer[0] = (buffer[0] & ~(1 << 6)) | (overallparity_out << 6);
-    for (int i = 7; i < 30; i++)
-      buffer[0] = (buffer[0] & ~(1 << i)) | (corrected_out[i - 7] << i);
-    for (int i = 30; i < 50; i++)
-      buffer[1] = (buffer[1] & ~(1 << (i - 30))) | (corrected_out[i - 7] << (i - 30));
+  result = DECODE_STATE_UNKNOWN;
+  for (int k = 0; k < nbits; k++) {
+    uint64_t bit = (bits >> k) & 0x1;
+    if (ds.bit < 50) { // Fill the word
+      ds.data += bit << ds.bit;
+      ds.powerMultiplier *= 2;
+    } else {
+      ds.data = ((ds.data >> 1) & 0x1FFFFFFFFFFFF) + (bit << 49); // Take out the bit 0, fill bit 49
+      ds.powerMultiplier = static_cast<uint64_t>(1) << 49;
+    }
+    ds.bit++;
+
+    if (ds.data == 0x1555540f00113 && ds.bit >= 50) {
+      ds.bit = 0;
+      ds.data = 0;
+      ds.powerMultiplier = 1;
+      ds.status = headerToRead;
+      ds.chan_addr[0] = 0;
+      ds.chan_addr[1] = 0;
+      result = DECODE_STATE_SYNC_FOUND;
+      return k + 1;
+    }
   }
+  return nbits;
 }
 
-void DecodeGBTWord(uint32_t* bufpt, uint32_t* data)
-{
-  uint32_t word = *(bufpt + 3);
-  data[0] = (((word) >> 0) & 0x1) << 1;
-  data[0] += (((word) >> 1) & 0x1);
-
-  data[1] = (((word) >> 2) & 0x1) << 1;
-  data[1] += (((word) >> 3) & 0x1);
-  data[2] = (((word) >> 4) & 0x1) << 1;
-  data[2] += (((word) >> 5) & 0x1);
-  data[3] = (((word) >> 6) & 0x1) << 1;
-  data[3] += (((word) >> 7) & 0x1);
-
-  data[4] = (((word) >> 8) & 0x1) << 1;
-  data[4] += (((word) >> 9) & 0x1);
-
-  data[5] = (((word) >> 10) & 0x1) << 1;
-  data[5] += (((word) >> 11) & 0x1);
-  data[6] = (((word) >> 12) & 0x1) << 1;
-  data[6] += (((word) >> 13) & 0x1);
-  data[7] = (((word) >> 14) & 0x1) << 1;
-  data[7] += (((word) >> 15) & 0x1);
-  data[8] = (((word) >> 16) & 0x1) << 1;
-  data[8] += (((word) >> 17) & 0x1);
-  data[9] = (((word) >> 18) & 0x1) << 1;
-  data[9] += (((word) >> 19) & 0x1);
-
-  data[10] = (((word) >> 20) & 0x1) << 1;
-  data[10] += (((word) >> 21) & 0x1);
-  data[11] = (((word) >> 22) & 0x1) << 1;
-  data[11] += (((word) >> 23) & 0x1);
-  data[12] = (((word) >> 24) & 0x1) << 1;
-  data[12] += (((word) >> 25) & 0x1);
-  data[13] = (((word) >> 26) & 0x1) << 1;
-  data[13] += (((word) >> 27) & 0x1);
-  data[14] = (((word) >> 28) & 0x1) << 1;
-  data[14] += (((word) >> 29) & 0x1);
-
-  data[15] = (((word) >> 30) & 0x1) << 1;
-  data[15] += (((word) >> 31) & 0x1);
-
-  word = *(bufpt + 2);
-  data[16] = (((word) >> 0) & 0x1) << 1;
-  data[16] += (((word) >> 1) & 0x1);
-  data[17] = (((word) >> 2) & 0x1) << 1;
-  data[17] += (((word) >> 3) & 0x1);
-  data[18] = (((word) >> 4) & 0x1) << 1;
-  data[18] += (((word) >> 5) & 0x1);
-  data[19] = (((word) >> 6) & 0x1) << 1;
-  data[19] += (((word) >> 7) & 0x1);
-
-  data[20] = (((word) >> 8) & 0x1) << 1;
-  data[20] += (((word) >> 9) & 0x1);
-  data[21] = (((word) >> 10) & 0x1) << 1;
-  data[21] += (((word) >> 11) & 0x1);
-  data[22] = (((word) >> 12) & 0x1) << 1;
-  data[22] += (((word) >> 13) & 0x1);
-  data[23] = (((word) >> 14) & 0x1) << 1;
-  data[23] += (((word) >> 15) & 0x1);
-  data[24] = (((word) >> 16) & 0x1) << 1;
-  data[24] += (((word) >> 17) & 0x1);
-
-  data[25] = (((word) >> 18) & 0x1) << 1;
-  data[25] += (((word) >> 19) & 0x1);
-  data[26] = (((word) >> 20) & 0x1) << 1;
-  data[26] += (((word) >> 21) & 0x1);
-  data[27] = (((word) >> 22) & 0x1) << 1;
-  data[27] += (((word) >> 23) & 0x1);
-  data[28] = (((word) >> 24) & 0x1) << 1;
-  data[28] += (((word) >> 25) & 0x1);
-  data[29] = (((word) >> 26) & 0x1) << 1;
-  data[29] += (((word) >> 27) & 0x1);
-
-  data[30] = (((word) >> 28) & 0x1) << 1;
-  data[30] += (((word) >> 29) & 0x1);
-  data[31] = (((word) >> 30) & 0x1) << 1;
-  data[31] += (((word) >> 31) & 0x1);
-
-  word = *(bufpt + 1);
-  data[32] = (((word) >> 0) & 0x1) << 1;
-  data[32] += (((word) >> 1) & 0x1);
-  data[33] = (((word) >> 2) & 0x1) << 1;
-  data[33] += (((word) >> 3) & 0x1);
-  data[34] = (((word) >> 4) & 0x1) << 1;
-  data[34] += (((word) >> 5) & 0x1);
-
-  data[35] = (((word) >> 6) & 0x1) << 1;
-  data[35] += (((word) >> 7) & 0x1);
-  data[36] = (((word) >> 8) & 0x1) << 1;
-  data[36] += (((word) >> 9) & 0x1);
-  data[37] = (((word) >> 10) & 0x1) << 1;
-  data[37] += (((word) >> 11) & 0x1);
-  data[38] = (((word) >> 12) & 0x1) << 1;
-  data[38] += (((word) >> 13) & 0x1);
-  data[39] = (((word) >> 14) & 0x1) << 1;
-  data[39] += (((word) >> 15) & 0x1);
-}
-
-decode_state_t Add1BitOfData(uint32_t gbtdata, DualSampa& dsr, DualSampaGroup* dsg)
+/// Processes the field accumulated in ds.data once it has all the bits given by FieldWidth().
+decode_state_t ProcessField(DualSampa& dsr, DualSampaGroup* dsg, const LinkErrors& errors)
 {
   decode_state_t result = DECODE_STATE_UNKNOWN;
-  if (gPrintLevel >= 2)
-    fprintf(flog, "ds->status=%d\n", dsr.status);
-  if (!(dsr.status == notSynchronized)) { // data is synchronized => build the data word
-    dsr.data += (gbtdata & 0x1) * dsr.powerMultiplier;
-    dsr.powerMultiplier *= 2;
-    dsr.bit++;
-  }
 
   DualSampa* ds = &dsr;
 
   switch (ds->status) {
-    case notSynchronized: {
-      // Looking for Sync word (2 packets)
-      // Look for 10 consecutives 01 (sent 10 from the GBT)
-      if (gPrintLevel >= 2)
-        fprintf(flog, "  ds[%d]->bit=%d\n  ->powerMultiplier=%" PRIu64 "\n  (gbtdata&0x1)=%d\n",
-                ds->id, ds->bit, ds->powerMultiplier, (int)(gbtdata & 0x1));
-      if (ds->bit < 50) { // Fill the word
-        ds->data += (gbtdata & 0x1) * ds->powerMultiplier;
-        //if( gPrintLevel >= 2 ) fprintf(flog,"Add1BitOfData()\n  ds[%d]->data=%lX\n", ds->id, ds->data);
-        ds->powerMultiplier *= 2;
-        ds->bit++;
-      } else {
-        if (ds->bit == 50)
-          ds->powerMultiplier /= 2; // We want to fill the bit 49
-        ds->data /= 2;              // Take out the bit 0
-        ds->data &= 0x1FFFFFFFFFFFF;
-        ds->data += (gbtdata & 0x1) * ds->powerMultiplier; // Fill bit 49
-        //if( gPrintLevel >= 2 ) fprintf(flog,"Add1BitOfData()\n  ds[%d]->data=%lX\n", ds->data);
-        ds->bit++;
-      }
-
-      if (gPrintLevel >= 2)
-        fprintf(flog, "  ==> ds[%d]->data: %.16" PRIu64 "\n", ds->id, ds->data);
-      if (ds->data == 0x1555540f00113 && ds->bit >= 50) {
-        if (gPrintLevel >= 1)
-          fprintf(flog, "SAMPA #%d: Synchronizing... (Sync word found)\n", ds->id); // Next word of 50 bits should be a Sync Word
-        ds->bit = 0;
-        ds->data = 0;
-        ds->powerMultiplier = 1;
-        ds->status = headerToRead;
-        ds->chan_addr[0] = 0;
-        ds->chan_addr[1] = 0;
-        result = DECODE_STATE_SYNC_FOUND;
-      }
-      break;
-    }
     case headerToRead: {
       // We are waiting for a Sampa header
       // It can be preceded by an undefined number os Sync words
-      if (gPrintLevel >= 2)
-        fprintf(flog, "  ds[%d]->bit=%d\n  ->powerMultiplier=%" PRIu64 "\n  (gbtdata&0x1)=%d\n",
-                dsr.id, dsr.bit, dsr.powerMultiplier, (int)(gbtdata & 0x1));
-      if (gPrintLevel >= 2)
-        fprintf(flog, "  ==> ds[%d]->data: %.16" PRIu64 "\n", dsr.id, dsr.data);
       if (dsr.bit < 50)
         break;
       if (dsr.data == 0x1555540f00113) {
-        if (gPrintLevel >= 2)
-          fprintf(flog, "SAMPA #%d: Sync word found\n", dsr.id); // Next word of 50 bits should be a Sync Word
         result = DECODE_STATE_SYNC_FOUND;
       } else {
         result = DECODE_STATE_HEADER_FOUND;
@@ -457,50 +195,29 @@ decode_state_t Add1BitOfData(uint32_t gbtdata, DualSampa& dsr, DualSampaGroup* d
           //fprintf(flog,"%.2d %.2d\n",ds->header.fChipAddress,(ds->header.fChipAddress%2));
           ds->nbHitChan[ds->header.fChannelAddress + 32 * (ds->header.fChipAddress % 2)]++;
         }
-        if (gPrintLevel >= 1 || (false && ds->id == 0 && ds->header.fChipAddress == 0 && ds->header.fChannelAddress >= 30))
-          fprintf(flog, "SAMPA [%2d]: Header 0x%014" PRIu64 " HCode %2lu HPar %lu PkgType %lu 10BitWords %lu ChipAdd %lu ChAdd %2lu BX %lu PPar %d\n",
-                  ds->id, ds->data, (unsigned long)ds->header.fHammingCode, (unsigned long)ds->header.fHeaderParity, (unsigned long)ds->header.fPkgType,
-                  (unsigned long)ds->header.fNbOf10BitWords, (unsigned long)ds->header.fChipAddress, (unsigned long)ds->header.fChannelAddress,
-                  (unsigned long)ds->header.fBunchCrossingCounter, (int)ds->header.fPayloadParity);
-        int parity = CheckDataParity(ds->data);
+        int parity = SampaHeaderValidator::parity(ds->data);
         if (parity)
-          fprintf(flog, "===> SAMPA [%2d]: WARNING Parity %d\n", ds->id, parity);
+          errors.add(*ds, DecodingError::HeaderParity, ds->data);
 
         //fprintf(flog,"SAMPA [%2d]: ChipAdd %d ChAdd %2d BX %d, expected %d\n",
         //              ds->id, ds->header.fChipAddress,ds->header.fChannelAddress,
         //              ds->header.fBunchCrossingCounter, ds->bxc);
-        int link = ds->id / 5;
-        if (gPrintLevel >= 1)
-          fprintf(flog, "SAMPA [%2d]: BX counter for link %d is %ld\n", ds->id, link, dsg->bxc);
         if (dsg && dsg->bxc >= 0) {
           if (!BXCNT_compare(dsg->bxc, static_cast<long int>(ds->header.fBunchCrossingCounter))) {
-            gNbErrors++;
-            fprintf(flog, "===> ERROR SAMPA [%2d]: ChipAdd %lu ChAdd %2lu BX %lu, expected %ld, diff %ld\n",
-                    ds->id, (unsigned long)ds->header.fChipAddress, (unsigned long)ds->header.fChannelAddress,
-                    (unsigned long)ds->header.fBunchCrossingCounter, dsg->bxc,
-                    (unsigned long)ds->header.fBunchCrossingCounter - dsg->bxc);
+            errors.add(*ds, DecodingError::BunchCrossing, ds->data);
           }
         } else {
           if (dsg && ds->header.fPkgType == 4) { // physics trigger
             dsg->bxc = ds->header.fBunchCrossingCounter;
-            if (gPrintLevel >= 1)
-              fprintf(flog, "SAMPA [%2d]: BX counter for link %d set to %ld\n", ds->id, link, dsg->bxc);
           }
         }
-        //if( gPrintLevel >= 1 ) fprintf(flog,"SAMPA [%2d]: BX counter for link %d is %d (2)\n", ds->id, link, dsg->bxc);
 
         ds->packetsize = 0;
 
-        unsigned int buf[2];
-        buf[0] = ds->data & 0x3FFFFFFF;
-        buf[1] = ds->data >> 30;
-        bool hamming_error = false;  // Is there an hamming error?
-        bool hamming_uncorr = false; // Is the data correctable?
-        bool hamming_enable = false; // Correct the data?
-        HammingDecode(buf, hamming_error, hamming_uncorr, hamming_enable);
+        auto hamming = SampaHeaderValidator::check(ds->data);
+        bool hamming_error = hamming.error; // Is there an hamming error?
         if (hamming_error) {
-          gNbErrors++;
-          fprintf(flog, "SAMPA [%2d]: Hamming ERROR -> Correctable: %s\n", ds->id, hamming_uncorr ? "NO" : "YES");
+          errors.add(*ds, DecodingError::HammingError, ds->data);
           ds->status = notSynchronized;
           result = DECODE_STATE_UNKNOWN;
         } else {                          // No Hamming error
@@ -509,34 +226,28 @@ decode_state_t Add1BitOfData(uint32_t gbtdata, DualSampa& dsr, DualSampaGroup* d
             ds->bxc[ds->header.fChipAddress % 2] = ds->header.fBunchCrossingCounter;
           } else {
             if (ds->header.fPkgType == 1 || ds->header.fPkgType == 3) { // Data truncated
-              gNbErrors++;
-              fprintf(flog, "ERROR: Truncated data found -> skip the data\n");
+              errors.addInPacket(*ds, DecodingError::TruncatedPacket);
               if (ds->header.fNbOf10BitWords)
                 ds->status = dataToRead;
               else
                 ds->status = headerToRead;
             }
             if (ds->header.fPkgType == 0) { // Heartbeat: Pkg 0, NbOfWords 0 ?, ChAdd 21
-              gNbErrors++;
-              fprintf(flog, "ERROR: Hearbeat word found\n");
+              errors.add(*ds, DecodingError::Heartbeat, ds->data);
               ds->status = headerToRead;
               ds->bxc[ds->header.fChipAddress % 2] = ds->header.fBunchCrossingCounter;
             }
             if (ds->header.fPkgType == 5) { //
-              gNbErrors++;
-              fprintf(flog, "ERROR: Data word (?) type 5 found\n");
+              errors.add(*ds, DecodingError::UnexpectedPacket, ds->data);
               ds->status = headerToRead;
             }
             if (ds->header.fPkgType == 6) { //
-              if (gPrintLevel >= 1)
-                fprintf(flog, "INFO: Trigger too early word found\n");
               //ds->status = headerToRead;
               ds->status = sizeToRead;
             }
             if (ds->header.fPkgType == 2) { //
-              gNbErrors++;
-              fprintf(flog, "ERROR: Supposed to be a SYNC!!!\n");
-              fprintf(flog, "Trying to re-synchronise...\n");
+              // supposed to be a sync word, try to re-synchronise
+              errors.add(*ds, DecodingError::UnexpectedSync, ds->data);
               ds->status = notSynchronized;
               result = DECODE_STATE_UNKNOWN;
             }
@@ -560,33 +271,18 @@ decode_state_t Add1BitOfData(uint32_t gbtdata, DualSampa& dsr, DualSampaGroup* d
       int chip0 = (ds->id % 5) * 2;
       int chip1 = chip0 + 1;
 
-      if (gPrintLevel >= 5)
-        fprintf(flog, "SAMPA: chip addresses: %lu\n", (unsigned long)ds->header.fChipAddress);
-      if (gPrintLevel >= 5)
-        fprintf(flog, "SAMPA: channel addresses: %d, %d\n",
-                ds->chan_addr[0], ds->chan_addr[1]);
       if (ds->header.fChipAddress < chip0 || ds->header.fChipAddress > chip1) {
-        gNbWarnings++;
-        if (gPrintLevel >= 1)
-          fprintf(flog, "===> WARNING SAMPA [%2d]: chip address = %lu, expected = [%d,%d]\n", ds->id,
-                  (unsigned long)ds->header.fChipAddress, chip0, chip1);
-      }
-      if (ds->chan_addr[ds->header.fChipAddress - chip0] != ds->header.fChannelAddress) {
-        gNbWarnings++;
-        if (gPrintLevel >= 1)
-          fprintf(flog, "===> WARNING SAMPA [%2d]: channel address = %lu, expected = %d\n", ds->id,
-                  (unsigned long)ds->header.fChannelAddress, ds->chan_addr[ds->header.fChipAddress - chip0]);
-      }
-      ds->chan_addr[ds->header.fChipAddress - chip0] += 1;
-      if (ds->chan_addr[ds->header.fChipAddress - chip0] > 31) {
-        ds->chan_addr[ds->header.fChipAddress - chip0] = 0;
+        // the sequence of the channel addresses is only known for the chips of the board
+        errors.addInPacket(*ds, DecodingError::ChipAddress);
+      } else {
+        if (ds->chan_addr[ds->header.fChipAddress - chip0] != ds->header.fChannelAddress) {
+          errors.addInPacket(*ds, DecodingError::ChannelAddress);
+        }
+        ds->chan_addr[ds->header.fChipAddress - chip0] += 1;
+        if (ds->chan_addr[ds->header.fChipAddress - chip0] > 31) {
+          ds->chan_addr[ds->header.fChipAddress - chip0] = 0;
+        }
       }
-      if (gPrintLevel >= 5)
-        fprintf(flog, "SAMPA: next channel addresses: %d, %d\n",
-                ds->chan_addr[0], ds->chan_addr[1]);
-
-      if (gPrintLevel >= 1)
-        fprintf(flog, "SAMPA [%2d]: Cluster Size 0x%" PRIu64 " (%" PRIu64 ")\n", ds->id, ds->data, ds->data);
 
       ds->csize = ds->data;
       ds->cid = 0;
@@ -605,8 +301,6 @@ decode_state_t Add1BitOfData(uint32_t gbtdata, DualSampa& dsr, DualSampaGroup* d
       if (ds->bit < 10)
         break;
       result = DECODE_STATE_CTIME_FOUND;
-      if (gPrintLevel >= 1)
-        fprintf(flog, "SAMPA [%2d]: Cluster Time 0x%" PRIu64 " (%" PRIu64 ")\n", ds->id, ds->data, ds->data);
 
       ds->ctime = ds->data;
       ds->packetsize += 1;
@@ -624,22 +318,11 @@ decode_state_t Add1BitOfData(uint32_t gbtdata, DualSampa& dsr, DualSampaGroup* d
     case dataToRead: { // Read ADC data words (10 bits)
       if (ds->bit < 10)
         break;
-      if (gPrintLevel >= 2)
-        fprintf(flog, "SAMPA #%d Data word: 0x%" PRIu64 " (%" PRIu64 ")\n", ds->id, ds->data, ds->data);
 
       if (1 /*ds->header.fPkgType == 4*/) {
         if (ds->header.fPkgType == 4) { // Good data
           result = DECODE_STATE_SAMPLE_FOUND;
           ds->sample = ds->data;
-
-          if (gPattern > 0) {
-            int patt = (gPattern & 0xFF) + (gPattern << 8 & 0xFF00);
-            if ((ds->data & 0x2FF) != (patt & 0x2FF)) {
-              gNbWarnings++;
-              fprintf(flog, "===> WARNING SAMPA [%2d]: wrong data pattern 0x%" PRIu64 ", expected 0x%X\n", ds->id,
-                      ds->data & 0x2FF, (patt & 0x2FF));
-            }
-          }
         }
         ds->cid += 1;
         ds->packetsize += 1;
@@ -647,24 +330,12 @@ decode_state_t Add1BitOfData(uint32_t gbtdata, DualSampa& dsr, DualSampaGroup* d
         bool end_of_cluster = (ds->cid == ds->csize);
         if (end_of_packet && !end_of_cluster) {
           // That's the end of the packet, but the cluster is still being read... that's not normal
-          gNbErrors++;
-          //fprintf(flog,"===> ERROR SAMPA [%2d]: End-of-packet without End-of-cluster. packet size = %lu, cluster size = %d\n",
-          //    ds->id, ds->header.fNbOf10BitWords, ds->csize);
+          errors.addInPacket(*ds, DecodingError::PacketEnd);
           ds->status = headerToRead;
         } else if (end_of_cluster) {
-          if (gPrintLevel >= 1)
-            fprintf(flog, "SAMPA #%d : End of cluster found\n", ds->id);
           if (ds->header.fPkgType == 4) { // Good data
             ds->nclus[ds->header.fChipAddress % 2][ds->header.fChannelAddress] += 1;
             result = DECODE_STATE_END_OF_CLUSTER;
-            if (ds->id == 0 && ds->header.fChipAddress == 0 && ds->header.fChannelAddress >= 30) {
-              if (false) {
-                if (ds->header.fChannelAddress == 31)
-                  fprintf(flog, "    ");
-                fprintf(flog, "%d %lu %lu: End of cluster found (%d)\n", ds->id, (unsigned long)ds->header.fChipAddress, (unsigned long)ds->header.fChannelAddress,
-                        ds->nclus[ds->header.fChipAddress % 2][ds->header.fChannelAddress]);
-              }
-            }
           }
           if (ds->header.fNbOf10BitWords > ds->packetsize)
             ds->status = sizeToRead;
@@ -675,8 +346,7 @@ decode_state_t Add1BitOfData(uint32_t gbtdata, DualSampa& dsr, DualSampaGroup* d
         }
       } else {
         if (ds->header.fPkgType == 1 || ds->header.fPkgType == 3) { // Data truncated
-          gNbWarnings++;
-          fprintf(flog, "WARNING: SAMPA PkgType = 1 or 3 (data truncated)  found\n");
+          errors.addInPacket(*ds, DecodingError::TruncatedPacket);
           if (ds->header.fNbOf10BitWords - 1)
             ds->header.fNbOf10BitWords--;
           else
@@ -699,21 +369,13 @@ decode_state_t Add1BitOfData(uint32_t gbtdata, DualSampa& dsr, DualSampaGroup* d
   return result;
 }
 
-decode_state_t Add10BitsOfData(uint64_t data, DualSampa& dsr, DualSampaGroup* /*dsg*/)
+decode_state_t Add10BitsOfData(uint64_t data, DualSampa& dsr, DualSampaGroup* /*dsg*/, const LinkErrors& errors)
 {
   decode_state_t result = DECODE_STATE_UNKNOWN;
   switch (dsr.status) {
     case notSynchronized:
       dsr.data += data << dsr.bit;
 
-      if (gPrintLevel >= 1)
-        fprintf(flog, "notSynchronized[%d]: bit=%02d  data=%013" PRIu64 "  %03X %03X %03X %03X %03X\n",
-                dsr.id, dsr.bit, dsr.data,
-                (int)((dsr.data >> 40) & 0x3FF),
-                (int)((dsr.data >> 30) & 0x3FF),
-                (int)((dsr.data >> 20) & 0x3FF),
-                (int)((dsr.data >> 10) & 0x3FF),
-                (int)(dsr.data & 0x3FF));
 
       dsr.bit += 10;
 
@@ -724,8 +386,6 @@ decode_state_t Add10BitsOfData(uint64_t data, DualSampa& dsr, DualSampaGroup* /*
           dsr.bit = 0;
           dsr.data = 0;
           dsr.packetsize = 0;
-          if (gPrintLevel >= 1)
-            fprintf(flog, "notSynchronized[%d]: SYNC word found\n", dsr.id);
         } else {
           dsr.data = dsr.data >> 10;
           dsr.bit -= 10;
@@ -736,14 +396,6 @@ decode_state_t Add10BitsOfData(uint64_t data, DualSampa& dsr, DualSampaGroup* /*
     case headerToRead:
       dsr.data += data << dsr.bit;
 
-      if (gPrintLevel >= 1)
-        fprintf(flog, "headerToRead[%d]: bit=%02d  data=%013" PRIu64 "  %03X %03X %03X %03X %03X\n",
-                dsr.id, dsr.bit, dsr.data,
-                (int)((dsr.data >> 40) & 0x3FF),
-                (int)((dsr.data >> 30) & 0x3FF),
-                (int)((dsr.data >> 20) & 0x3FF),
-                (int)((dsr.data >> 10) & 0x3FF),
-                (int)(dsr.data & 0x3FF));
 
       dsr.bit += 10;
 
@@ -754,8 +406,6 @@ decode_state_t Add10BitsOfData(uint64_t data, DualSampa& dsr, DualSampaGroup* /*
           dsr.bit = 0;
           dsr.data = 0;
           dsr.packetsize = 0;
-          if (gPrintLevel >= 1)
-            fprintf(flog, "headerToRead[%d]: SYNC word found\n", dsr.id);
         } else {
           result = DECODE_STATE_HEADER_FOUND;
           memcpy(&(dsr.header), &(dsr.data), sizeof(Sampa::SampaHeaderStruct));
@@ -763,12 +413,6 @@ decode_state_t Add10BitsOfData(uint64_t data, DualSampa& dsr, DualSampaGroup* /*
           dsr.bit = 0;
           dsr.data = 0;
           dsr.packetsize = 0;
-          Sampa::SampaHeaderStruct* header = (Sampa::SampaHeaderStruct*)&(dsr.header);
-          if (gPrintLevel >= 1)
-            fprintf(flog, "SAMPA Header: HCode %2lu HPar %lu PkgType %lu 10BitWords %lu ChipAdd %lu ChAdd %2lu BX %lu PPar %lu\n",
-                    (unsigned long)header->fHammingCode, (unsigned long)header->fHeaderParity, (unsigned long)header->fPkgType,
-                    (unsigned long)header->fNbOf10BitWords, (unsigned long)header->fChipAddress, (unsigned long)header->fChannelAddress,
-                    (unsigned long)header->fBunchCrossingCounter, (unsigned long)header->fPayloadParity);
         }
       }
       break;
@@ -777,17 +421,15 @@ decode_state_t Add10BitsOfData(uint64_t data, DualSampa& dsr, DualSampaGroup* /*
       dsr.csize = data;
       dsr.cid = 0;
       dsr.packetsize += 1;
-      if (gPrintLevel >= 1)
-        fprintf(flog, "sizeToRead[%d]: SAMPA cluster size: %d\n", dsr.id, dsr.csize);
       if ((dsr.csize + 2) > dsr.header.fNbOf10BitWords) {
-        //fprintf(flog,"ERROR: cluster size bigger than SAMPA payload\n");
+        errors.addInPacket(dsr, DecodingError::ClusterSize);
         dsr.status = notSynchronized;
         dsr.bit = 0;
         dsr.data = 0;
         dsr.packetsize = 0;
       } else {
         if (dsr.packetsize == dsr.header.fNbOf10BitWords) {
-          ///fprintf(flog,"sizeToRead[%d]: ERROR: end-of-packet found while reading cluster size\n", dsr.id);
+          errors.addInPacket(dsr, DecodingError::PacketEnd);
           dsr.status = notSynchronized;
           dsr.bit = 0;
           dsr.data = 0;
@@ -803,7 +445,7 @@ decode_state_t Add10BitsOfData(uint64_t data, DualSampa& dsr, DualSampaGroup* /*
       dsr.ctime = data;
       dsr.packetsize += 1;
       if (dsr.packetsize == dsr.header.fNbOf10BitWords) {
-        //fprintf(flog,"timeToRead[%d]: ERROR: end-of-packet found while reading cluster time\n", dsr.id);
+        errors.addInPacket(dsr, DecodingError::PacketEnd);
         dsr.status = notSynchronized;
         dsr.bit = 0;
         dsr.data = 0;
@@ -811,8 +453,6 @@ decode_state_t Add10BitsOfData(uint64_t data, DualSampa& dsr, DualSampaGroup* /*
       } else {
         dsr.status = dataToRead;
         result = DECODE_STATE_CTIME_FOUND;
-        if (gPrintLevel >= 1)
-          fprintf(flog, "timeToRead[%d]: SAMPA cluster time: %d\n", dsr.id, dsr.ctime);
       }
       break;
 
@@ -825,7 +465,7 @@ decode_state_t Add10BitsOfData(uint64_t data, DualSampa& dsr, DualSampaGroup* /*
       //printf("dataToRead: cid=%d  packetsize=%d  end_of_packet=%d  end_of_cluster=%d\n",
       //    dsr.cid, dsr.packetsize, (int)end_of_packet, (int)end_of_cluster);
       if (end_of_packet && !end_of_cluster) {
-        //fprintf(flog,"dataToRead[%d]: ERROR: end-of-packet found while reading cluster data\n", dsr.id);
+        errors.addInPacket(dsr, DecodingError::PacketEnd);
         dsr.bit = 0;
         dsr.data = 0;
         dsr.packetsize = 0;
@@ -833,8 +473,6 @@ decode_state_t Add10BitsOfData(uint64_t data, DualSampa& dsr, DualSampaGroup* /*
       } else {
         result = DECODE_STATE_SAMPLE_FOUND;
         dsr.status = dataToRead;
-        if (gPrintLevel >= 1)
-          fprintf(flog, "dataToRead[%d]: SAMPA sample: %d\n", dsr.id, dsr.sample);
         if (end_of_cluster) {
           result = DECODE_STATE_END_OF_CLUSTER;
           if (end_of_packet) {
@@ -856,9 +494,9 @@ decode_state_t Add10BitsOfData(uint64_t data, DualSampa& dsr, DualSampaGroup* /*
 
 Decoder::Decoder() {}
 
-Decoder::~Decoder() { fclose(flog); }
+Decoder::~Decoder() {}
 
-void Decoder::initialize()
+void Decoder::initialize(std::string padTableFile)
 {
   QcInfoLogger::GetInstance() << "initialize Decoder" << AliceO2::InfoLogger::InfoLogger::endm;
   fprintf(stdout, "initialize Decoder\n");
@@ -908,107 +546,128 @@ void Decoder::initialize()
 
   mMapCRU.readMapping("cru.map");
   mMapFEC.readDSMapping("fec.map");
+  mMapFEC.initPadTable(padTableFile);
 
-  gPrintLevel = 0;
-
-  //if( gPrintLevel > 0 ) flog = fopen("/home/flp/qc.log", "w");
-  //else
-  flog = stdout;
   fprintf(stdout, "Decoder initialization finished\n");
 }
 
+void Decoder::setNumberOfThreads(size_t threads)
+{
+  if (threads < 2) {
+    mWorkers.reset();
+  } else if (!mWorkers || mWorkers->size() != threads) {
+    mWorkers = std::make_unique<o2::quality_control::core::WorkerPool>(threads);
+  }
+  QcInfoLogger::GetInstance() << "[Decoder] Decoding in " << (mWorkers ? threads : 1) << " thread(s)" << AliceO2::InfoLogger::InfoLogger::endm;
+}
+
 void Decoder::decodeRaw(uint32_t* payload_buf, size_t nGBTwords, int cru_id, int link_id)
 {
-  uint32_t hhvalue, hlvalue, lhvalue, llvalue;
-  for (size_t wi = 0; wi < nGBTwords; wi++) {
-    uint32_t* ptr = payload_buf + wi * 4;
-    hhvalue = ptr[3];
-    hlvalue = ptr[2];
-    lhvalue = ptr[1];
-    llvalue = ptr[0];
-    //fprintf(stdout,"wi=%d  %.8X %.8X %.8X %.8X\n", wi,
-    //    hhvalue, hlvalue, lhvalue, llvalue);
-
-    uint32_t bufpt[4] = { hhvalue, hlvalue, lhvalue, llvalue };
-    uint32_t data2bits[40] = { 0 };
-    DecodeGBTWord(bufpt, data2bits);
+  decodeRaw(payload_buf, nGBTwords, cru_id, link_id, mHits);
+}
+
+void Decoder::decodeRaw(uint32_t* payload_buf, size_t nGBTwords, int cru_id, int link_id, SampaHitBuffer& hits)
+{
+  // Each 80-bit GBT word carries 2 bits of each of the 40 e-links. The GBT words are de-interleaved by blocks of 32,
+  // giving 64 consecutive bits per e-link, which are then decoded field by field rather than bit by bit.
+  const size_t wordsPerBlock = 32;
+  for (size_t first = 0; first < nGBTwords; first += wordsPerBlock) {
+    size_t nWords = std::min(wordsPerBlock, nGBTwords - first);
+    uint64_t elinkBits[40] = { 0 };
+    for (size_t wi = 0; wi < nWords; wi++) {
+      uint32_t* ptr = payload_buf + (first + wi) * 4;
+      // e-links 0-15 are in the lowest 32 bits, 16-31 in the next ones, 32-39 in the following 16 bits
+      uint32_t words[3] = { ptr[0], ptr[1], ptr[2] & 0xFFFF };
+      for (int w = 0; w < 3; w++) {
+        // the odd bit of each pair is received first, swapping the bits of the pairs puts them in order
+        uint32_t swapped = ((words[w] >> 1) & 0x55555555) | ((words[w] & 0x55555555) << 1);
+        int nLinks = (w < 2) ? 16 : 8;
+        for (int j = 0; j < nLinks; j++) {
+          elinkBits[16 * w + j] |= static_cast<uint64_t>((swapped >> (2 * j)) & 0x3) << (2 * wi);
+        }
+      }
+    }
 
     for (int i = 0; i < 40; i++) {
       if (ds_enable[cru_id][link_id][i] == 0)
         continue;
       //fprintf(stdout,"processing board %d %d %d\n", cru_id, link_id, i);
+      decodeELink(elinkBits[i], 2 * nWords, cru_id, link_id, i, hits);
+    }
+  }
+}
 
-      uint32_t group = ds[cru_id][link_id][i].id / 5;
-      uint32_t bits[2] = { data2bits[i] & 0x1, (data2bits[i] >> 1) & 0x1 };
-      for (int k = 0; k < 2; k++) {
-        decode_state_t state = Add1BitOfData(bits[k], (ds[cru_id][link_id][i]), &(dsg[cru_id][link_id][group]));
-        switch (state) {
-          case DECODE_STATE_SYNC_FOUND:
-            if (gPrintLevel >= 1)
-              fprintf(flog, "SYNC found\n");
-            break;
-          case DECODE_STATE_HEADER_FOUND:
-            uint64_t _h;
-            memcpy(&_h, &(ds[cru_id][link_id][i].header), sizeof(ds[cru_id][link_id][i].header));
-            if (gPrintLevel >= 1)
-              fprintf(flog, "board %d %d %d -> HEADER: %05" PRIu64 ", %lu, %lu\n",
-                      cru_id, link_id, i, _h,
-                      (unsigned long)ds[cru_id][link_id][i].header.fChipAddress,
-                      (unsigned long)ds[cru_id][link_id][i].header.fChannelAddress);
-            break;
-          case DECODE_STATE_CSIZE_FOUND: {
-            if (gPrintLevel >= 2)
-              fprintf(flog, "CLUSTER SIZE: %" PRIu32 "\n", ds[cru_id][link_id][i].csize);
-            Sampa::SampaHeaderStruct& header = ds[cru_id][link_id][i].header;
-            SampaHit& hit = ds[cru_id][link_id][i].hit;
-            hit.cru_id = cru_id;
-            hit.link_id = link_id;
-            hit.ds_addr = ds[cru_id][link_id][i].id;
-            int chip_id = ds[cru_id][link_id][i].header.fChipAddress % 2;
-            hit.chan_addr = header.fChannelAddress + 32 * chip_id;
-            hit.bxc = header.fBunchCrossingCounter;
-            hit.size = ds[cru_id][link_id][i].csize;
-            hit.samples.clear();
-            hit.csum = 0;
-            hit.time = 0;
-            break;
-          }
-          case DECODE_STATE_CTIME_FOUND:
-            if (gPrintLevel >= 2)
-              fprintf(flog, "CLUSTER TIME: %d\n", ds[cru_id][link_id][i].ctime);
-            ds[cru_id][link_id][i].hit.time = ds[cru_id][link_id][i].ctime;
-            break;
-          case DECODE_STATE_SAMPLE_FOUND:
-          case DECODE_STATE_END_OF_CLUSTER: {
-            SampaHit& hit = ds[cru_id][link_id][i].hit;
-            if (gPrintLevel >= 2)
-              fprintf(flog, "SAMPLE: %X\n", ds[cru_id][link_id][i].sample);
-            hit.samples.push_back(ds[cru_id][link_id][i].sample);
-            hit.csum += ds[cru_id][link_id][i].sample;
-
-            if (state == DECODE_STATE_END_OF_CLUSTER) {
-              mHits.push_back(hit);
-              if (hit.link_id >= 24) {
-                fprintf(stdout, "hit: link_id=%d, ds_addr=%d, chan_addr=%d\n",
-                        hit.link_id, hit.ds_addr, hit.chan_addr);
-                getchar();
-              }
-              hit.size = 0;
-              hit.samples.clear();
-              hit.csum = 0;
-              hit.time = 0;
-            }
-            break;
-          }
-          default:
-            break;
+void Decoder::decodeELink(uint64_t bits, int nbits, int cru_id, int link_id, int i, SampaHitBuffer& hits)
+{
+  DualSampa& dsr = ds[cru_id][link_id][i];
+  DualSampaGroup* group = &(dsg[cru_id][link_id][dsr.id / 5]);
+  const LinkErrors errors{ mErrors, cru_id, link_id };
+  while (nbits > 0) {
+    decode_state_t state;
+    int consumed;
+    if (dsr.status == notSynchronized) {
+      consumed = FindSyncWord(bits, nbits, dsr, state);
+    } else {
+      // all the available bits of the current field are added at once
+      consumed = std::min(FieldWidth(dsr) - dsr.bit, nbits);
+      dsr.data += (bits & ((static_cast<uint64_t>(1) << consumed) - 1)) << dsr.bit;
+      dsr.powerMultiplier <<= consumed;
+      dsr.bit += consumed;
+      state = (dsr.bit < FieldWidth(dsr)) ? DECODE_STATE_UNKNOWN : ProcessField(dsr, group, errors);
+    }
+    bits = (consumed < 64) ? (bits >> consumed) : 0;
+    nbits -= consumed;
+
+    switch (state) {
+      case DECODE_STATE_SYNC_FOUND:
+        break;
+      case DECODE_STATE_HEADER_FOUND:
+        break;
+      case DECODE_STATE_CSIZE_FOUND: {
+        Sampa::SampaHeaderStruct& header = dsr.header;
+        SampaHit& hit = dsr.hit;
+        hit.cru_id = cru_id;
+        hit.link_id = link_id;
+        hit.ds_addr = dsr.id;
+        int chip_id = dsr.header.fChipAddress % 2;
+        hit.chan_addr = header.fChannelAddress + 32 * chip_id;
+        hit.bxc = header.fBunchCrossingCounter;
+        hit.size = dsr.csize;
+        dsr.samples.clear();
+        hit.csum = 0;
+        hit.time = 0;
+        break;
+      }
+      case DECODE_STATE_CTIME_FOUND:
+        dsr.hit.time = dsr.ctime;
+        break;
+      case DECODE_STATE_SAMPLE_FOUND:
+      case DECODE_STATE_END_OF_CLUSTER: {
+        SampaHit& hit = dsr.hit;
+        dsr.samples.push_back(dsr.sample);
+        hit.csum += dsr.sample;
+
+        if (state == DECODE_STATE_END_OF_CLUSTER) {
+          hits.add(hit, dsr.samples);
+          hit.size = 0;
+          dsr.samples.clear();
+          hit.csum = 0;
+          hit.time = 0;
         }
+        break;
       }
+      default:
+        break;
     }
   }
 }
 
 void Decoder::decodeUL(uint32_t* payload_buf_32, size_t nWords, int cru_id, int dpw_id)
+{
+  decodeUL(payload_buf_32, nWords, cru_id, dpw_id, mHits);
+}
+
+void Decoder::decodeUL(uint32_t* payload_buf_32, size_t nWords, int cru_id, int dpw_id, SampaHitBuffer& hits)
 {
   uint64_t* payload_buf = (uint64_t*)payload_buf_32;
   for (size_t wi = 0; wi < nWords; wi += 1) {
@@ -1018,9 +677,9 @@ void Decoder::decodeUL(uint32_t* payload_buf_32, size_t nWords, int cru_id, int
 
     int link_id = (value >> 59) & 0x1F;
     int ds_id = (value >> 53) & 0x3F;
+    // each DPW reads 12 links, a higher number would use the state of the links of the other DPW
+    bool wrong_link = (link_id >= 12);
     link_id += 12 * dpw_id;
-    if (gPrintLevel >= 1)
-      fprintf(flog, "64 bits: %016" PRIu64 "\n", value);
 
     if (value == 0xFFFFFFFFFFFFFFFF)
       continue;
@@ -1028,43 +687,22 @@ void Decoder::decodeUL(uint32_t* payload_buf_32, size_t nWords, int cru_id, int
       continue;
 
     int is_incomplete = (value >> 52) & 0x1;
-    int err_code = (value >> 50) & 0x3;
-    if (gPrintLevel >= 1) {
-      fprintf(flog, "cru: %d  dpw: %d  link: %d  ds: %d  incomplete: %d  err: %d\n",
-              cru_id, dpw_id, link_id, ds_id, is_incomplete, err_code);
-      fprintf(flog, "14 bits: %016" PRIu64 "\n", (value >> 50) & 0xFFF);
-      fprintf(flog, "50 bits: %016" PRIu64 "\n", value & 0x3FFFFFFFFFFFF);
-
-      fprintf(flog, "10 bits:\n");
-      fprintf(flog, "    %" PRIu64 "\n", value & 0x3FF);
-      fprintf(flog, "    %" PRIu64 "\n", (value >> 10) & 0x3FF);
-      fprintf(flog, "    %" PRIu64 "\n", (value >> 20) & 0x3FF);
-      fprintf(flog, "    %" PRIu64 "\n", (value >> 30) & 0x3FF);
-      fprintf(flog, "    %" PRIu64 "\n", (value >> 40) & 0x3FF);
-      fprintf(flog, "DS status: %d\n", ds[cru_id][link_id][ds_id].status);
-    }
-    if (link_id < 0 || link_id >= 24 || ds_id < 0 || ds_id >= 40) {
-      fprintf(flog, "ERROR: wrong DS board address    cru: %d  dpw: %d  link: %d  ds: %d\n",
-              cru_id, dpw_id, link_id, ds_id);
+    if (wrong_link || link_id < 0 || link_id >= 24 || ds_id < 0 || ds_id >= 40) {
+      mErrors.add(cru_id, wrong_link ? -1 : link_id, ds_id, DecodingError::WrongLink, value);
       continue;
     }
+    const LinkErrors errors{ mErrors, cru_id, link_id };
 
     bool skip = false;
     for (int b = 0; b < 50; b += 10) {
 
-      decode_state_t state = Add10BitsOfData((value >> b) & 0x3FF, ds[cru_id][link_id][ds_id], &dsg[cru_id][link_id][ds_id / 8]);
+      decode_state_t state = Add10BitsOfData((value >> b) & 0x3FF, ds[cru_id][link_id][ds_id], &dsg[cru_id][link_id][ds_id / 8], errors);
       switch (state) {
         case DECODE_STATE_SYNC_FOUND:
           break;
         case DECODE_STATE_HEADER_FOUND:
-          uint64_t _h;
-          memcpy(&_h, &(ds[cru_id][link_id][ds_id].header), sizeof(ds[cru_id][link_id][ds_id].header));
-          if (gPrintLevel >= 1)
-            fprintf(flog, "HEADER: %05" PRIu64 "\n", _h);
           break;
         case DECODE_STATE_CSIZE_FOUND: {
-          if (gPrintLevel >= 1)
-            fprintf(flog, "CLUSTER SIZE: %d\n", ds[cru_id][link_id][ds_id].csize);
           Sampa::SampaHeaderStruct& header = ds[cru_id][link_id][ds_id].header;
           SampaHit& hit = ds[cru_id][link_id][ds_id].hit;
           hit.cru_id = cru_id;
@@ -1074,35 +712,26 @@ void Decoder::decodeUL(uint32_t* payload_buf_32, size_t nWords, int cru_id, int
           hit.chan_addr = header.fChannelAddress + 32 * chip_id;
           hit.bxc = header.fBunchCrossingCounter;
           hit.size = ds[cru_id][link_id][ds_id].csize;
-          hit.samples.clear();
+          ds[cru_id][link_id][ds_id].samples.clear();
           hit.csum = 0;
           hit.time = 0;
           break;
         }
         case DECODE_STATE_CTIME_FOUND:
-          if (gPrintLevel >= 1)
-            fprintf(flog, "CLUSTER TIME: %d\n", ds[cru_id][link_id][ds_id].ctime);
           ds[cru_id][link_id][ds_id].hit.time = ds[cru_id][link_id][ds_id].ctime;
           break;
         case DECODE_STATE_SAMPLE_FOUND:
         case DECODE_STATE_END_OF_CLUSTER:
         case DECODE_STATE_END_OF_PACKET: {
           SampaHit& hit = ds[cru_id][link_id][ds_id].hit;
-          if (gPrintLevel >= 1)
-            fprintf(flog, "SAMPLE: %X\n", ds[cru_id][link_id][ds_id].sample);
-          hit.samples.push_back(ds[cru_id][link_id][ds_id].sample);
+          ds[cru_id][link_id][ds_id].samples.push_back(ds[cru_id][link_id][ds_id].sample);
           hit.csum += ds[cru_id][link_id][ds_id].sample;
 
           if (state == DECODE_STATE_END_OF_CLUSTER ||
               state == DECODE_STATE_END_OF_PACKET) {
-            mHits.push_back(hit);
-            if (hit.link_id >= 24) {
-              fprintf(stdout, "hit: link_id=%d, ds_addr=%d, chan_addr=%d\n",
-                      hit.link_id, hit.ds_addr, hit.chan_addr);
-              getchar();
-            }
+            hits.add(hit, ds[cru_id][link_id][ds_id].samples);
             hit.size = 0;
-            hit.samples.clear();
+            ds[cru_id][link_id][ds_id].samples.clear();
             hit.csum = 0;
             hit.time = 0;
           }
@@ -1120,55 +749,80 @@ void Decoder::decodeUL(uint32_t* payload_buf_32, size_t nWords, int cru_id, int
   }
 }
 
-void Decoder::processData(const char* buf, size_t size)
+void Decoder::resetLinks(int cruId, int linkMin, int linkMax)
 {
-  int RDH_BLOCK_SIZE = 8192;
-
-  int manu2ds[64] = { 62, 61, 63, 60, 59, 55, 58, 57, 56, 54, 50, 46, 42, 39, 37, 41,
-                      35, 36, 33, 34, 32, 38, 43, 40, 45, 44, 47, 48, 49, 52, 51, 53,
-                      7, 6, 5, 4, 2, 3, 1, 0, 9, 11, 13, 15, 17, 19, 21, 23,
-                      31, 30, 29, 28, 27, 26, 25, 24, 22, 20, 18, 16, 14, 12, 10, 8 };
+  for (int l = linkMin; l <= linkMax; l++) {
+    for (int i = 0; i < 40; i++) {
+      DualSampaReset(&(ds[cruId][l][i]));
+      ds[cruId][l][i].id = i;
+      ds[cruId][l][i].nbHit = -1;
+      for (int j = 0; j < 64; j++) {
+        ds[cruId][l][i].nbHitChan[j] = 0;
+      }
+    }
+    for (int i = 0; i < 8; i++) {
+      DualSampaGroupReset(&(dsg[cruId][l][i]));
+    }
+  }
+}
 
-  int ds2manu[64];
-  for (int i = 0; i < 64; i++) {
+void Decoder::mapHits(gsl::span<SampaHit> hits)
+{
+  static const int manu2ds[64] = { 62, 61, 63, 60, 59, 55, 58, 57, 56, 54, 50, 46, 42, 39, 37, 41,
+                                   35, 36, 33, 34, 32, 38, 43, 40, 45, 44, 47, 48, 49, 52, 51, 53,
+                                   7, 6, 5, 4, 2, 3, 1, 0, 9, 11, 13, 15, 17, 19, 21, 23,
+                                   31, 30, 29, 28, 27, 26, 25, 24, 22, 20, 18, 16, 14, 12, 10, 8 };
+  static const auto ds2manu = []() {
+    std::array<int, 64> result{};
     for (int j = 0; j < 64; j++) {
-      if (manu2ds[j] != i)
-        continue;
-      ds2manu[i] = j;
-      break;
+      result[manu2ds[j]] = j;
     }
+    return result;
+  }();
+
+  for (SampaHit& hit : hits) {
+    hit.pad.fDE = -1;
+    hit.pad.fCathode = 0;
+    int manuch = ds2manu[hit.chan_addr];
+    hit.chan_addr = manuch;
+
+    int32_t link_id = mMapCRU.getLink(hit.cru_id, hit.link_id);
+    if (link_id < 0)
+      continue;
+    //printf("cru_id=%d link_id=%d  LID=%d\n", (int)hit.cru_id, (int)hit.link_id, (int)link_id);
+
+    if (!mMapFEC.getPadByLinkID(link_id, hit.ds_addr, hit.chan_addr, hit.pad))
+      continue;
   }
+}
+
+void Decoder::processData(const char* buf, size_t size)
+{
+  int RDH_BLOCK_SIZE = 8192;
 
   const char* rdh = buf;
   uint32_t payload_offset = 0;
   uint32_t CRUbuf[4 * 4];
   CRUheader CRUh;
+  mHits.clear();
+  mSteps.clear();
   if (size < sizeof(CRUbuf))
     return;
 
+  // Find the pages of the buffer, and the resets of the links which must happen between them
   while (payload_offset < size) {
 
-    if (gPrintLevel >= 1)
-      fprintf(flog, "CRU payload_offset: %d, size: %d\n", (int)payload_offset, (int)size);
 
     memcpy(CRUbuf, rdh, sizeof(CRUbuf));
     memcpy(&CRUh, CRUbuf, sizeof(CRUheader));
 
     uint32_t* payload_buf = (uint32_t*)(rdh + 16 * 4);
 
-    if (gPrintLevel >= 1)
-      fprintf(flog, "%d:  header_version: %X, header_size: %d, memory_size: %d, next_packet_offset: %d, block_length: %d, packet: %d, cru_id: %d, link_id: %d, orbit: %d\n",
-              nFrames, (int)CRUh.header_version, (int)CRUh.header_size, (int)CRUh.memory_size, (int)CRUh.next_packet_offset, (int)CRUh.block_length,
-              (int)CRUh.packet_counter, (int)CRUh.cru_id, (int)CRUh.link_id, (int)CRUh.hb_orbit);
 
     // Check RDH version and size
-    if (((int)CRUh.header_version) != 4) {
-      QcInfoLogger::GetInstance() << "[Decoder::processData] Wrong CRU header version: " << (int)CRUh.header_version << AliceO2::InfoLogger::InfoLogger::endm;
-      return;
-    }
-    if (((int)CRUh.header_size) != 64) {
-      QcInfoLogger::GetInstance() << "[Decoder::processData] Wrong CRU header size: " << (int)CRUh.header_size << AliceO2::InfoLogger::InfoLogger::endm;
-      return;
+    if (((int)CRUh.header_version) != 4 || ((int)CRUh.header_size) != 64) {
+      mErrors.add(-1, -1, -1, DecodingError::WrongRdh, (static_cast<uint64_t>(CRUbuf[1]) << 32) | CRUbuf[0]);
+      break;
     }
     // Compute size of payload inside 8kB block
     CRUh.block_length = CRUh.memory_size - CRUh.header_size;
@@ -1187,22 +841,21 @@ void Decoder::processData(const char* buf, size_t size)
     //fprintf(flog, "CRU header version: %d\n", (int)CRUh.header_version);
     //fprintf(flog, "CRU header size: %d\n", (int)CRUh.header_size);
     //fprintf(flog, "CRU header block length: %d\n", (int)CRUh.block_length);
-    if (gPrintLevel >= 3)
-      fprintf(flog, "CRU packet counter: %d\n", (int)CRUh.packet_counter);
-    if (gPrintLevel >= 3)
-      fprintf(flog, "CRU orbit id: %d\n", (int)CRUh.hb_orbit);
-    if (gPrintLevel >= 1)
-      fprintf(flog, "CRU link ID: %d\n", (int)CRUh.link_id);
-    if (gPrintLevel >= 1)
-      fprintf(flog, "CRU ID: %d\n", (int)cruId);
-    if (gPrintLevel >= 1)
-      fprintf(flog, "DPW ID: %d\n", (int)dpwId);
 
     nFrames += 1;
 
+    if (cruId >= MCH_MAX_CRU_ID) {
+      mErrors.add(cruId, -1, -1, DecodingError::WrongLink, (static_cast<uint64_t>(CRUbuf[3]) << 32) | CRUbuf[2]);
+      continue;
+    }
+
     int rdh_lid = CRUh.link_id;
     int cru_lid = (rdh_lid == 15) ? rdh_lid : rdh_lid + 12 * dpwId;
     bool is_raw = (rdh_lid != 15);
+    if (is_raw ? (cru_lid >= 24) : (dpwId >= 2)) {
+      mErrors.add(cruId, -1, -1, DecodingError::WrongLink, (static_cast<uint64_t>(CRUbuf[3]) << 32) | CRUbuf[2]);
+      continue;
+    }
 
     bool orbit_jump = true;
     int Dorbit1 = CRUh.hb_orbit - hb_orbit;
@@ -1214,55 +867,126 @@ void Decoder::processData(const char* buf, size_t size)
     if (true && orbit_jump) {
       int lid_min = (rdh_lid == 15) ? dpwId * 12 : 0;
       int lid_max = (rdh_lid == 15) ? 11 + dpwId * 12 : 23;
-      if (gPrintLevel >= 1)
-        fprintf(flog, "Resetting decoding FSM: orbit=%d, previous=%d, links=%d-%d\n",
-                CRUh.hb_orbit, hb_orbit, lid_min, lid_max);
-      for (int l = lid_min; l <= lid_max; l++) {
-        for (int i = 0; i < 40; i++) {
-          DualSampaReset(&(ds[cruId][l][i]));
-          ds[cruId][l][i].id = i;
-          ds[cruId][l][i].nbHit = -1;
-          for (int j = 0; j < 64; j++) {
-            ds[cruId][l][i].nbHitChan[j] = 0;
-          }
-        }
-        for (int i = 0; i < 8; i++) {
-          DualSampaGroupReset(&(dsg[cruId][l][i]));
-        }
-      }
+      mSteps.push_back({ DecodingStep::ResetLinks, cruId, lid_min, lid_max, nullptr, 0, 0, nullptr, 0, 0 });
     }
     hb_orbit = CRUh.hb_orbit;
 
-    int nGBTwords = CRUh.block_length / 16;
-    int n64bitWords = CRUh.block_length / 8;
-
-    if (gPrintLevel >= 1)
-      fprintf(flog, "Starting to decode buffer...\n");
-    if (is_raw)
-      decodeRaw(payload_buf, nGBTwords, cruId, cru_lid);
-    else
-      decodeUL(payload_buf, n64bitWords, cruId, dpwId);
-
-    if (gPrintLevel >= 1)
-      fprintf(flog, "mHits.size(): %d\n", (int)mHits.size());
-    for (size_t ih = 0; ih < mHits.size(); ih++) {
-      SampaHit& hit = mHits[ih];
-      hit.pad.fDE = -1;
-      hit.pad.fCathode = 0;
-      int manuch = ds2manu[hit.chan_addr];
-      hit.chan_addr = manuch;
-
-      int32_t link_id = mMapCRU.getLink(hit.cru_id, hit.link_id);
-      if (link_id < 0)
-        continue;
-      //printf("cru_id=%d link_id=%d  LID=%d\n", (int)hit.cru_id, (int)hit.link_id, (int)link_id);
+    if (is_raw) {
+      mSteps.push_back({ DecodingStep::RawPage, cruId, cru_lid, cru_lid, payload_buf, (size_t)(CRUh.block_length / 16), cru_lid, nullptr, 0, 0 });
+    } else {
+      mSteps.push_back({ DecodingStep::ULPage, cruId, dpwId * 12, dpwId * 12 + 11, payload_buf, (size_t)(CRUh.block_length / 8), dpwId, nullptr, 0, 0 });
+    }
+  }
 
-      if (!mMapFEC.getPadByLinkID(link_id, hit.ds_addr, hit.chan_addr, hit.pad))
-        continue;
+  if (!mWorkers || !decodeInParallel()) {
+    for (auto& step : mSteps) {
+      executeStep(step, mHits, 0, 23);
+    }
+  }
+
+  mapHits(mHits.hits());
+}
+
+void Decoder::executeStep(DecodingStep& step, SampaHitBuffer& hits, int linkMin, int linkMax)
+{
+  switch (step.type) {
+    case DecodingStep::ResetLinks:
+      resetLinks(step.cruId, std::max(step.linkMin, linkMin), std::min(step.linkMax, linkMax));
+      break;
+    case DecodingStep::RawPage:
+    case DecodingStep::ULPage:
+      step.hits = &hits;
+      step.firstHit = hits.size();
+      if (step.type == DecodingStep::RawPage)
+        decodeRaw(step.payload, step.nWords, step.cruId, step.linkId, hits);
+      else
+        decodeUL(step.payload, step.nWords, step.cruId, step.linkId, hits);
+      step.lastHit = hits.size();
+      break;
+  }
+}
+
+bool Decoder::decodeInParallel()
+{
+  // Group the pages by the links whose state they use
+  std::unordered_map<int, size_t> linkOwner; // CRU link -> group
+  mNGroups = 0;
+  for (size_t si = 0; si < mSteps.size(); si++) {
+    const DecodingStep& step = mSteps[si];
+    if (step.type == DecodingStep::ResetLinks)
+      continue;
+    auto owner = linkOwner.find(step.cruId * 24 + step.linkMin);
+    size_t group = (owner != linkOwner.end()) ? owner->second : mNGroups;
+    if (group == mNGroups) {
+      if (mGroups.size() == mNGroups)
+        mGroups.emplace_back();
+      LinkGroup& added = mGroups[mNGroups++];
+      added.cruId = step.cruId;
+      added.linkMin = step.linkMin;
+      added.linkMax = step.linkMax;
+      added.steps.clear();
+      added.hits.clear();
+    }
+    mGroups[group].linkMin = std::min(mGroups[group].linkMin, step.linkMin);
+    mGroups[group].linkMax = std::max(mGroups[group].linkMax, step.linkMax);
+    for (int l = step.linkMin; l <= step.linkMax; l++) {
+      // the raw and UL pages of the same links cannot be decoded separately
+      if (linkOwner.try_emplace(step.cruId * 24 + l, group).first->second != group) {
+        return false;
+      }
+    }
+    mGroups[group].steps.push_back(si);
+  }
+  if (mNGroups < 2)
+    return false;
+
+  // The resets are executed in order with the pages of each group, or immediately for the links without pages
+  for (size_t si = 0; si < mSteps.size(); si++) {
+    DecodingStep& step = mSteps[si];
+    if (step.type != DecodingStep::ResetLinks)
+      continue;
+    std::vector<size_t> groups;
+    for (int l = step.linkMin; l <= step.linkMax; l++) {
+      auto owner = linkOwner.find(step.cruId * 24 + l);
+      if (owner == linkOwner.end()) {
+        resetLinks(step.cruId, l, l);
+      } else if (std::find(groups.begin(), groups.end(), owner->second) == groups.end()) {
+        groups.push_back(owner->second);
+      }
+    }
+    for (size_t group : groups) {
+      auto& steps = mGroups[group].steps;
+      steps.insert(std::upper_bound(steps.begin(), steps.end(), si), si);
+    }
+  }
+
+  std::vector<std::future<void>> results;
+  for (size_t gi = 0; gi < mNGroups; gi++) {
+    results.push_back(mWorkers->submit([this, gi]() {
+      LinkGroup& group = mGroups[gi];
+      for (size_t si : group.steps) {
+        executeStep(mSteps[si], group.hits, group.linkMin, group.linkMax);
+      }
+    }));
+  }
+  // all the jobs must be finished before their exceptions are thrown
+  for (auto& result : results) {
+    result.wait();
+  }
+  for (auto& result : results) {
+    result.get();
+  }
+
+  // Merge the hits in the order of the pages
+  for (const auto& step : mSteps) {
+    if (step.type == DecodingStep::ResetLinks)
+      continue;
+    for (size_t hi = step.firstHit; hi < step.lastHit; hi++) {
+      const SampaHit& hit = step.hits->hits()[hi];
+      mHits.add(hit, step.hits->samples(hit));
     }
-    if (gPrintLevel >= 1)
-      fprintf(flog, "Finished processing hits\n");
   }
+  return true;
 }
 
 void Decoder::clearHits()
@@ -0,0 +1,170 @@
+///
+/// \file   DecodingErrors.cxx
+///
+
+#include "MCH/DecodingErrors.h"
+#include "QualityControl/QcInfoLogger.h"
+
+#include <Monitoring/Monitoring.h>
+#include <TH2.h>
+
+#include <cinttypes>
+#include <cstdio>
+
+using namespace o2::quality_control::core;
+using o2::monitoring::Metric;
+
+namespace o2::quality_control_modules::muonchambers
+{
+
+DecodingErrors::DecodingErrors(size_t maxSamples)
+  : mCounters(new std::atomic<uint64_t>[(sNLinks + 1) * sNErrors]),
+    mMaxSamples(maxSamples),
+    mFreeSamples(maxSamples)
+{
+  for (int i = 0; i < (sNLinks + 1) * sNErrors; i++) {
+    mCounters[i] = 0;
+  }
+}
+
+const char* DecodingErrors::getName(DecodingError error)
+{
+  switch (error) {
+    case DecodingError::WrongRdh:
+      return "WrongRdh";
+    case DecodingError::WrongLink:
+      return "WrongLink";
+    case DecodingError::HeaderParity:
+      return "HeaderParity";
+    case DecodingError::HammingError:
+      return "HammingError";
+    case DecodingError::BunchCrossing:
+      return "BunchCrossing";
+    case DecodingError::TruncatedPacket:
+      return "TruncatedPacket";
+    case DecodingError::Heartbeat:
+      return "Heartbeat";
+    case DecodingError::UnexpectedPacket:
+      return "UnexpectedPacket";
+    case DecodingError::UnexpectedSync:
+      return "UnexpectedSync";
+    case DecodingError::ChipAddress:
+      return "ChipAddress";
+    case DecodingError::ChannelAddress:
+      return "ChannelAddress";
+    case DecodingError::ClusterSize:
+      return "ClusterSize";
+    case DecodingError::PacketEnd:
+      return "PacketEnd";
+    default:
+      return "Unknown";
+  }
+}
+
+uint64_t DecodingErrors::get(DecodingError error, int cruId, int linkId) const
+{
+  if (cruId >= 0) {
+    return mCounters[(cruId * 24 + linkId) * sNErrors + static_cast<int>(error)].load(std::memory_order_relaxed);
+  }
+  uint64_t total = 0;
+  for (int link = 0; link <= sNLinks; link++) {
+    total += mCounters[link * sNErrors + static_cast<int>(error)].load(std::memory_order_relaxed);
+  }
+  return total;
+}
+
+uint64_t DecodingErrors::getTotal() const
+{
+  uint64_t total = 0;
+  for (int i = 0; i < (sNLinks + 1) * sNErrors; i++) {
+    total += mCounters[i].load(std::memory_order_relaxed);
+  }
+  return total;
+}
+
+void DecodingErrors::setMaxSamples(size_t maxSamples)
+{
+  std::lock_guard<std::mutex> lock(mSamplesMutex);
+  mMaxSamples = maxSamples;
+  mFreeSamples = static_cast<int64_t>(mMaxSamples) - static_cast<int64_t>(mSamples.size());
+}
+
+void DecodingErrors::reset()
+{
+  for (int i = 0; i < (sNLinks + 1) * sNErrors; i++) {
+    mCounters[i] = 0;
+  }
+  std::lock_guard<std::mutex> lock(mSamplesMutex);
+  mSamples.clear();
+  mFreeSamples = mMaxSamples;
+  mTotalAtLastLog = 0;
+}
+
+void DecodingErrors::addSample(const Sample& sample)
+{
+  std::lock_guard<std::mutex> lock(mSamplesMutex);
+  if (mSamples.size() < mMaxSamples) {
+    mSamples.push_back(sample);
+  }
+  mFreeSamples = static_cast<int64_t>(mMaxSamples) - static_cast<int64_t>(mSamples.size());
+}
+
+TH2F* DecodingErrors::createHistogram(const char* name)
+{
+  auto histogram = new TH2F(name, "QcMuonChambers - Decoding errors;CRU * 24 + link;", sNLinks + 1, 0, sNLinks + 1, sNErrors, 0, sNErrors);
+  histogram->GetXaxis()->SetBinLabel(sNLinks + 1, "unknown");
+  for (int e = 0; e < sNErrors; e++) {
+    histogram->GetYaxis()->SetBinLabel(e + 1, getName(static_cast<DecodingError>(e)));
+  }
+  return histogram;
+}
+
+void DecodingErrors::fillHistogram(TH2F* histogram) const
+{
+  for (int link = 0; link <= sNLinks; link++) {
+    for (int e = 0; e < sNErrors; e++) {
+      histogram->SetBinContent(link + 1, e + 1, mCounters[link * sNErrors + e].load(std::memory_order_relaxed));
+    }
+  }
+  histogram->SetEntries(getTotal());
+}
+
+void DecodingErrors::sendMetrics(o2::monitoring::Monitoring& monitoring) const
+{
+  Metric metric{ "mch_decoding_errors" };
+  for (int e = 0; e < sNErrors; e++) {
+    auto error = static_cast<DecodingError>(e);
+    metric.addValue(get(error), getName(error));
+  }
+  monitoring.send(std::move(metric));
+}
+
+void DecodingErrors::logSamples()
+{
+  std::vector<Sample> samples;
+  {
+    std::lock_guard<std::mutex> lock(mSamplesMutex);
+    samples.swap(mSamples);
+    mFreeSamples = mMaxSamples;
+  }
+  uint64_t total = getTotal();
+  uint64_t errors = total - mTotalAtLastLog;
+  mTotalAtLastLog = total;
+  if (errors == 0) {
+    return;
+  }
+
+  for (const auto& sample : samples) {
+    char word[32];
+    snprintf(word, sizeof(word), "0x%013" PRIX64, sample.word);
+    QcInfoLogger::GetInstance() << "[MCH] Decoding error " << getName(sample.error) << " in CRU " << sample.cruId
+                                << " link " << sample.linkId << " DS " << sample.dsAddr << ", word " << word
+                                << AliceO2::InfoLogger::InfoLogger::endm;
+  }
+  if (errors > samples.size()) {
+    QcInfoLogger::GetInstance() << "[MCH] " << errors - samples.size() << " other decoding errors since the previous report"
+                                << AliceO2::InfoLogger::InfoLogger::endm;
+  }
+}
+
+} // namespace o2::quality_control_modules::muonchambers
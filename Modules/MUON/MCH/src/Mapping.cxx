@@ -161,7 +161,58 @@ bool MapFEC::getPadByLinkID(uint32_t link_id, uint32_t ds_addr, uint32_t dsch, M
   return getPadByDE(de, dsid, dsch, pad);
 }
 
+void MapFEC::initPadTable(std::string cacheFile)
+{
+  std::vector<std::pair<uint32_t, uint32_t>> dualSampas;
+  for (int link_id = 0; link_id <= LINKID_MAX; link_id++) {
+    for (int ds_addr = 0; ds_addr < 40; ds_addr++) {
+      const MapDualSampa& ds = mDsMap[link_id][ds_addr];
+      if (ds.mBad == 0 && ds.mDE >= 0 && ds.mIndex >= 0) {
+        dualSampas.emplace_back(ds.mDE, ds.mIndex);
+      }
+    }
+  }
+
+  uint64_t key = PadTable::computeKey(dualSampas);
+  if (!cacheFile.empty() && mPadTable.load(cacheFile, key)) {
+    QcInfoLogger::GetInstance() << "[MapFEC::initPadTable] pad table loaded from " << cacheFile << AliceO2::InfoLogger::InfoLogger::endm;
+    return;
+  }
+  mPadTable.build(dualSampas);
+  QcInfoLogger::GetInstance() << "[MapFEC::initPadTable] pad table built for " << dualSampas.size() << " DS" << AliceO2::InfoLogger::InfoLogger::endm;
+  if (!cacheFile.empty() && !mPadTable.empty() && !mPadTable.save(cacheFile)) {
+    QcInfoLogger::GetInstance() << "[MapFEC::initPadTable] can't write file " << cacheFile << AliceO2::InfoLogger::InfoLogger::endm;
+  }
+}
+
 bool MapFEC::getPadByDE(uint32_t de, uint32_t dsid, uint32_t dsch, MapPad& pad)
+{
+  const PadTable::Pad* entry = mPadTable.find(de, dsid, dsch);
+  if (entry == nullptr) {
+    // not in the electronics mapping
+    return getPadBySegmentation(de, dsid, dsch, pad);
+  }
+  if (entry->padId == PadTable::sUnknownDualSampa) {
+    return false;
+  }
+  if (entry->padId < 0) {
+    pad.fDE = -1;
+    return false;
+  }
+
+  pad.fDE = de;
+  pad.fDsID = dsid;
+  pad.fAddress = entry->padId;
+  pad.fX = entry->x;
+  pad.fY = entry->y;
+  pad.fSizeX = entry->sizeX;
+  pad.fSizeY = entry->sizeY;
+  pad.fCathode = entry->cathode;
+  pad.fBad = 0;
+  return true;
+}
+
+bool MapFEC::getPadBySegmentation(uint32_t de, uint32_t dsid, uint32_t dsch, MapPad& pad)
 {
   try {
     const o2::mch::mapping::Segmentation& segment = o2::mch::mapping::segmentation(de);
@@ -187,7 +238,7 @@ bool MapFEC::getPadByDE(uint32_t de, uint32_t dsid, uint32_t dsch, MapPad& pad)
     pad.fSizeY = padSizeY;
     pad.fCathode = segment.isBendingPad(padid) ? 0 : 1;
     pad.fBad = 0;
-  } catch (const std::exception& e) {
+  } catch (const std::exception&) {
     return false;
   }
 
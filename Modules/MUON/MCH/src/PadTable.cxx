@@ -0,0 +1,300 @@
+///
+/// \file   PadTable.cxx
+///
+
+#include "MCH/PadTable.h"
+#ifdef MCH_HAS_MAPPING_FACTORY
+#include "MCHMappingFactory/CreateSegmentation.h"
+#else
+#include "MCHMappingInterface/Segmentation.h"
+#endif
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace o2::quality_control_modules::muonchambers
+{
+
+namespace
+{
+
+// The file is the header followed by the arrays deFirst[nDEs], deCount[nDEs], blocks[nSlots] and pads[64 * nBlocks].
+struct Header {
+  char magic[8];
+  uint32_t version;
+  uint32_t nDEs;
+  uint64_t key;
+  uint64_t mapping; // fingerprint of the mapping the table was built with
+  uint32_t nSlots;
+  uint32_t nBlocks;
+};
+
+constexpr char sMagic[8] = { 'M', 'C', 'H', 'P', 'A', 'D', 'S', '\0' };
+constexpr uint32_t sVersion = 2;
+
+// FNV-1a
+constexpr uint64_t sHashBasis = 0xcbf29ce484222325ULL;
+void hashBytes(uint64_t& hash, const void* data, size_t size)
+{
+  for (size_t i = 0; i < size; i++) {
+    hash ^= static_cast<const unsigned char*>(data)[i];
+    hash *= 0x100000001b3ULL;
+  }
+}
+template <typename T>
+void hashValue(uint64_t& hash, T value)
+{
+  hashBytes(hash, &value, sizeof(T));
+}
+
+size_t bufferSize(const Header& header)
+{
+  return sizeof(Header) + 2 * sizeof(uint32_t) * header.nDEs + sizeof(int32_t) * header.nSlots +
+         sizeof(PadTable::Pad) * PadTable::sChannelsPerDualSampa * header.nBlocks;
+}
+
+} // namespace
+
+PadTable::~PadTable()
+{
+  clear();
+}
+
+uint64_t PadTable::computeKey(std::vector<std::pair<uint32_t, uint32_t>> dualSampas)
+{
+  std::sort(dualSampas.begin(), dualSampas.end());
+  dualSampas.erase(std::unique(dualSampas.begin(), dualSampas.end()), dualSampas.end());
+
+  // with the format version, so that a new layout invalidates the old files
+  uint64_t hash = sHashBasis;
+  hashValue(hash, sVersion);
+  for (const auto& [de, dsid] : dualSampas) {
+    hashValue(hash, de);
+    hashValue(hash, dsid);
+  }
+  return hash;
+}
+
+uint64_t PadTable::computeMappingFingerprint(const uint32_t* dualSampaCount, uint32_t numberOfDEs)
+{
+  uint64_t hash = sHashBasis;
+
+  // the library providing the segmentation, which changes with any new version of the mapping
+  Dl_info info;
+  struct stat status;
+  if (dladdr(reinterpret_cast<void*>(&o2::mch::mapping::segmentation), &info) != 0 && info.dli_fname != nullptr &&
+      stat(info.dli_fname, &status) == 0) {
+    hashBytes(hash, info.dli_fname, std::strlen(info.dli_fname));
+    hashValue(hash, static_cast<int64_t>(status.st_size));
+    hashValue(hash, static_cast<int64_t>(status.st_mtime));
+  }
+
+  // a summary of the content for the DEs of the table, in case the library could not be identified
+  for (uint32_t de = 0; de < numberOfDEs; de++) {
+    if (dualSampaCount[de] == 0) {
+      continue;
+    }
+    hashValue(hash, de);
+    try {
+      const o2::mch::mapping::Segmentation& segment = o2::mch::mapping::segmentation(de);
+      int nofPads = segment.nofPads();
+      hashValue(hash, nofPads);
+      hashValue(hash, segment.nofDualSampas());
+      for (int padid : { 0, nofPads / 2, nofPads - 1 }) {
+        if (padid >= 0 && padid < nofPads) {
+          hashValue(hash, segment.padPositionX(padid));
+          hashValue(hash, segment.padPositionY(padid));
+          hashValue(hash, segment.padSizeX(padid));
+          hashValue(hash, segment.padSizeY(padid));
+        }
+      }
+    } catch (const std::exception&) {
+      hashValue(hash, -1);
+    }
+  }
+  return hash;
+}
+
+void PadTable::build(const std::vector<std::pair<uint32_t, uint32_t>>& dualSampas)
+{
+  clear();
+
+  std::vector<std::pair<uint32_t, uint32_t>> sorted(dualSampas);
+  std::sort(sorted.begin(), sorted.end());
+  sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+  if (sorted.empty()) {
+    return;
+  }
+
+  Header header{};
+  std::memcpy(header.magic, sMagic, sizeof(sMagic));
+  header.version = sVersion;
+  header.key = computeKey(sorted);
+  header.nDEs = sorted.back().first + 1;
+  header.nBlocks = sorted.size();
+  std::vector<uint32_t> first(header.nDEs, 0);
+  std::vector<uint32_t> count(header.nDEs, 0);
+  for (const auto& [de, dsid] : sorted) {
+    count[de] = dsid + 1; // the pairs are sorted, the last one of the DE has the largest ID
+  }
+  for (uint32_t de = 0; de < header.nDEs; de++) {
+    first[de] = header.nSlots;
+    header.nSlots += count[de];
+  }
+  header.mapping = computeMappingFingerprint(count.data(), header.nDEs);
+
+  mBuffer.assign(bufferSize(header), 0);
+  char* buffer = mBuffer.data();
+  std::memcpy(buffer, &header, sizeof(Header));
+  auto* deFirst = reinterpret_cast<uint32_t*>(buffer + sizeof(Header));
+  auto* deCount = deFirst + header.nDEs;
+  auto* blocks = reinterpret_cast<int32_t*>(deCount + header.nDEs);
+  auto* pads = reinterpret_cast<Pad*>(blocks + header.nSlots);
+  std::copy(first.begin(), first.end(), deFirst);
+  std::copy(count.begin(), count.end(), deCount);
+  std::fill(blocks, blocks + header.nSlots, -1);
+
+  int32_t block = 0;
+  for (const auto& [de, dsid] : sorted) {
+    blocks[first[de] + dsid] = block;
+    Pad* dsPads = pads + block * sChannelsPerDualSampa;
+    block++;
+    try {
+      const o2::mch::mapping::Segmentation& segment = o2::mch::mapping::segmentation(de);
+      for (uint32_t channel = 0; channel < sChannelsPerDualSampa; channel++) {
+        Pad& pad = dsPads[channel];
+        int padid = segment.findPadByFEE(dsid, channel);
+        if (padid < 0) {
+          pad = Pad{ sNoPad, 0, 0, 0, 0, 0 };
+          continue;
+        }
+        pad.padId = padid;
+        pad.x = segment.padPositionX(padid);
+        pad.y = segment.padPositionY(padid);
+        pad.sizeX = segment.padSizeX(padid);
+        pad.sizeY = segment.padSizeY(padid);
+        pad.cathode = segment.isBendingPad(padid) ? 0 : 1;
+      }
+    } catch (const std::exception&) {
+      std::fill(dsPads, dsPads + sChannelsPerDualSampa, Pad{ sUnknownDualSampa, 0, 0, 0, 0, 0 });
+    }
+  }
+
+  attach(buffer);
+}
+
+bool PadTable::save(const std::string& path) const
+{
+  if (mBuffer.empty() && mMapped == nullptr) {
+    return false;
+  }
+  const char* buffer = mMapped ? static_cast<const char*>(mMapped) : mBuffer.data();
+  size_t size = mMapped ? mMappedSize : mBuffer.size();
+
+  // written aside and renamed, so that a concurrent load never sees a partial file
+  std::string temporaryPath = path + ".tmp" + std::to_string(getpid());
+  std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+  if (!file.write(buffer, size) || !file.flush()) {
+    file.close();
+    unlink(temporaryPath.c_str());
+    return false;
+  }
+  file.close();
+  return rename(temporaryPath.c_str(), path.c_str()) == 0;
+}
+
+bool PadTable::load(const std::string& path, uint64_t key)
+{
+  clear();
+
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat status;
+  if (fstat(fd, &status) != 0 || static_cast<size_t>(status.st_size) < sizeof(Header)) {
+    close(fd);
+    return false;
+  }
+  size_t size = status.st_size;
+  void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (mapped == MAP_FAILED) {
+    return false;
+  }
+  if (!validate(static_cast<const char*>(mapped), size, key)) {
+    munmap(mapped, size);
+    return false;
+  }
+
+  mMapped = mapped;
+  mMappedSize = size;
+  attach(static_cast<const char*>(mapped));
+  return true;
+}
+
+void PadTable::clear()
+{
+  if (mMapped) {
+    munmap(mMapped, mMappedSize);
+    mMapped = nullptr;
+    mMappedSize = 0;
+  }
+  mBuffer.clear();
+  mBuffer.shrink_to_fit();
+  mKey = 0;
+  mNumberOfDEs = 0;
+  mFirstDualSampa = mDualSampaCount = nullptr;
+  mBlocks = nullptr;
+  mPads = nullptr;
+}
+
+void PadTable::attach(const char* buffer)
+{
+  const auto* header = reinterpret_cast<const Header*>(buffer);
+  mKey = header->key;
+  mFirstDualSampa = reinterpret_cast<const uint32_t*>(buffer + sizeof(Header));
+  mDualSampaCount = mFirstDualSampa + header->nDEs;
+  mBlocks = reinterpret_cast<const int32_t*>(mDualSampaCount + header->nDEs);
+  mPads = reinterpret_cast<const Pad*>(mBlocks + header->nSlots);
+  mNumberOfDEs = header->nDEs;
+}
+
+bool PadTable::validate(const char* buffer, size_t size, uint64_t key)
+{
+  Header header;
+  std::memcpy(&header, buffer, sizeof(Header));
+  if (std::memcmp(header.magic, sMagic, sizeof(sMagic)) != 0 || header.version != sVersion || header.key != key) {
+    return false;
+  }
+  if (header.nDEs == 0 || bufferSize(header) != size) {
+    return false;
+  }
+
+  // the lookups do not check the indices any further
+  const auto* deFirst = reinterpret_cast<const uint32_t*>(buffer + sizeof(Header));
+  const auto* deCount = deFirst + header.nDEs;
+  const auto* blocks = reinterpret_cast<const int32_t*>(deCount + header.nDEs);
+  for (uint32_t de = 0; de < header.nDEs; de++) {
+    if (static_cast<uint64_t>(deFirst[de]) + deCount[de] > header.nSlots) {
+      return false;
+    }
+  }
+  for (uint32_t slot = 0; slot < header.nSlots; slot++) {
+    if (blocks[slot] >= static_cast<int64_t>(header.nBlocks)) {
+      return false;
+    }
+  }
+
+  // a table built with another mapping is rebuilt
+  return header.mapping == computeMappingFingerprint(deCount, header.nDEs);
+}
+
+} // namespace o2::quality_control_modules::muonchambers
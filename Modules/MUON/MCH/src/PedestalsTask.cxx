@@ -6,7 +6,7 @@
 #include <TCanvas.h>
 #include <TH1.h>
 #include <TH2.h>
-#include <TFile.h>
+#include <algorithm>
 
 #include "Headers/RAWDataHeader.h"
 #include "Framework/CallbackService.h"
@@ -22,7 +22,6 @@
 #ifdef MCH_HAS_MAPPING_FACTORY
 #include "MCHMappingFactory/CreateSegmentation.h"
 #endif
-//#define QC_MCH_SAVE_TEMP_ROOTFILE
 
 using namespace std;
 using namespace o2::framework;
@@ -56,6 +55,30 @@ enum decode_state_t {
   DECODE_STATE_SAMPLE_FOUND
 };
 
+static uint32_t electronicsKey(uint32_t cru_id, uint32_t link_id, uint32_t ds_addr, uint32_t chan_addr)
+{
+  return ((cru_id * 24 + link_id) * 40 + ds_addr) * 64 + chan_addr;
+}
+
+static uint32_t digitKey(uint32_t de, uint32_t padid)
+{
+  return (de << 16) | padid;
+}
+
+// Sets the content of the bins covered by the pad
+static void setPadContent(TH2F* histo, float padX, float padY, float padSizeX, float padSizeY, double value)
+{
+  int binx_min = histo->GetXaxis()->FindBin(padX - padSizeX / 2 + 0.1);
+  int binx_max = histo->GetXaxis()->FindBin(padX + padSizeX / 2 - 0.1);
+  int biny_min = histo->GetYaxis()->FindBin(padY - padSizeY / 2 + 0.1);
+  int biny_max = histo->GetYaxis()->FindBin(padY + padSizeY / 2 - 0.1);
+  for (int by = biny_min; by <= biny_max; by++) {
+    for (int bx = binx_min; bx <= binx_max; bx++) {
+      histo->SetBinContent(bx, by, value);
+    }
+  }
+}
+
 namespace o2
 {
 namespace quality_control_modules
@@ -79,25 +102,19 @@ void PedestalsTask::initialize(o2::framework::InitContext& /*ctx*/)
   QcInfoLogger::GetInstance() << "initialize PedestalsTask" << AliceO2::InfoLogger::InfoLogger::endm;
   if (true) {
 
-    for (int c = 0; c < MCH_MAX_CRU_IN_FLP; c++) {
-      for (int l = 0; l < 24; l++) {
-        for (int i = 0; i < 40; i++) {
-          for (int j = 0; j < 64; j++) {
-            nhits[c][l][i][j] = 0;
-            pedestal[c][l][i][j] = noise[c][l][i][j] = 0;
-          }
-        }
-      }
+    std::string padTableFile;
+    if (auto param = mCustomParameters.find("padTableFile"); param != mCustomParameters.end()) {
+      padTableFile = param->second;
     }
-
-    for (int de = 0; de < 1100; de++) {
-      for (int padid = 0; padid < 1500; padid++) {
-        nhitsDigits[de][padid] = 0;
-        pedestalDigits[de][padid] = noiseDigits[de][padid] = 0;
-      }
+    mDecoder.initialize(padTableFile);
+    if (auto param = mCustomParameters.find("decodingThreads"); param != mCustomParameters.end()) {
+      mDecoder.setNumberOfThreads(std::max(1, std::stoi(param->second)));
     }
-
-    mDecoder.initialize();
+    if (auto param = mCustomParameters.find("errorSamplesPerCycle"); param != mCustomParameters.end()) {
+      mDecoder.getErrors().setMaxSamples(std::stoi(param->second));
+    }
+    mHistogramDecodingErrors = DecodingErrors::createHistogram("QcMuonChambers_DecodingErrors");
+    getObjectsManager()->startPublishing(mHistogramDecodingErrors);
 
     uint32_t dsid;
     std::vector<int> DEs;
@@ -193,122 +210,119 @@ void PedestalsTask::startOfCycle()
   QcInfoLogger::GetInstance() << "startOfCycle" << AliceO2::InfoLogger::InfoLogger::endm;
 }
 
-void PedestalsTask::fill_noise_distributions()
+void PedestalsTask::updateNoiseDistribution(int de, const MapPad& pad, PedestalAccumulator::Channel& channel)
 {
-  for (int pi = 0; pi < 5; pi++) {
-    for (int i = 0; i < 2; i++) {
-      auto ih = mHistogramNoiseDistributionDE[pi][i].begin();
-      while (ih != mHistogramNoiseDistributionDE[pi][i].end()) {
-        ih->second->Reset();
-        ih++;
-      }
-    }
+  float szmax = pad.fSizeX;
+  if (szmax < pad.fSizeY)
+    szmax = pad.fSizeY;
+
+  int szid = 0;
+  if (fabs(szmax - 2.5) < 0.001)
+    szid = 1;
+  else if (fabs(szmax - 5.0) < 0.001)
+    szid = 2;
+  else if (fabs(szmax - 10.0) < 0.001)
+    szid = 3;
+
+  auto hNoiseDE = mHistogramNoiseDistributionDE[szid][pad.fCathode].find(de);
+  if ((hNoiseDE == mHistogramNoiseDistributionDE[szid][pad.fCathode].end()) || (hNoiseDE->second == NULL)) {
+    return;
   }
-  auto ih = mHistogramNoiseDE.begin();
-  for (; ih != mHistogramNoiseDE.end(); ih++) {
-    int de = ih->first;
-    if (!ih->second)
-      continue;
-    if (ih->second->GetEntries() < 1)
-      continue;
 
-    for (int bi = 0; bi < ih->second->GetXaxis()->GetNbins(); bi++) {
-      for (int ci = 0; ci < ih->second->GetYaxis()->GetNbins(); ci++) {
-        float noise = ih->second->GetBinContent(bi + 1, ci + 1);
-        if (noise < 0.001)
-          continue;
-
-        int dsid = bi;
-        int chan_addr = ci;
-
-        MapPad pad;
-        mDecoder.getMapFEC().getPadByDE(de, dsid, chan_addr, pad);
-        float padSizeX = pad.fSizeX;
-        float padSizeY = pad.fSizeY;
-        int cathode = pad.fCathode;
-
-        /*
-        o2::mch::mapping::Segmentation segment(de);
-        int padid = segment.findPadByFEE(dsid, chan_addr);
-        if(padid < 0) {
-          //fprintf(flog,"Invalid pad: %d %d %d\n", link_id, dsid, hit.chan_addr);
-          continue;
-        }
-
-        float padSizeX = segment.padSizeX(padid);
-        float padSizeY = segment.padSizeY(padid);
-        int cathode = segment.isBendingPad(padid) ? 0 : 1;
-         */
-        float szmax = padSizeX;
-        if (szmax < padSizeY)
-          szmax = padSizeY;
-        //fprintf(flog,"%d %d %d -> %d %f %f\n", de, dsid, chan_addr, padid, padSizeX, padSizeY);
-
-        int szid = 0;
-        if (fabs(szmax - 2.5) < 0.001)
-          szid = 1;
-        else if (fabs(szmax - 5.0) < 0.001)
-          szid = 2;
-        else if (fabs(szmax - 10.0) < 0.001)
-          szid = 3;
-
-        auto hNoiseDE = mHistogramNoiseDistributionDE[szid][cathode].find(de);
-        if ((hNoiseDE != mHistogramNoiseDistributionDE[szid][cathode].end()) && (hNoiseDE->second != NULL)) {
-          hNoiseDE->second->Fill(noise);
-        }
-      }
-    }
+  // move the channel from the bin of its previous noise value to the bin of the new one
+  TH1F* histo = hNoiseDE->second;
+  double entries = histo->GetEntries();
+  if (channel.lastNoise >= 0) {
+    histo->AddBinContent(histo->FindBin(channel.lastNoise), -1);
+    entries -= 1;
   }
+  float noise = channel.noise();
+  if (noise < 0.001) {
+    channel.lastNoise = -1;
+  } else {
+    histo->AddBinContent(histo->FindBin(noise));
+    entries += 1;
+    channel.lastNoise = noise;
+  }
+  histo->SetEntries(entries);
 }
 
-void PedestalsTask::save_histograms()
+void PedestalsTask::updateElectronicsHistograms()
 {
-  TFile f("/tmp/qc.root", "RECREATE");
-  fill_noise_distributions();
-  for (int i = 0; i < MCH_MAX_CRU_IN_FLP * 24; i++) {
-    mHistogramNoise[i]->Write();
-    mHistogramPedestals[i]->Write();
-  }
-  for (int i = 0; i < 2; i++) {
-    auto ih = mHistogramPedestalsXY[i].begin();
-    while (ih != mHistogramPedestalsXY[i].end()) {
-      ih->second->Write();
-      ih++;
+  mElectronicsPedestals.takeChanged([this](PedestalAccumulator::Channel& channel) {
+    int chan_addr = channel.key % 64;
+    int ds_addr = (channel.key / 64) % 40;
+    int linkid = (channel.key / (64 * 40)) % 24;
+    int cruid = channel.key / (64 * 40 * 24);
+    float ped = channel.pedestal();
+    float rms = channel.noise();
+
+    // Fill the histograms for each CRU link
+    mHistogramPedestals[cruid * 24 + linkid]->SetBinContent(ds_addr + 1, chan_addr + 1, ped);
+    mHistogramNoise[cruid * 24 + linkid]->SetBinContent(ds_addr + 1, chan_addr + 1, rms);
+
+    int32_t link_id = mDecoder.getMapCRU(cruid, linkid);
+    if (link_id < 0)
+      return;
+    MapPad pad;
+    if (!mDecoder.getMapFEC().getPadByLinkID(link_id, ds_addr, chan_addr, pad) || pad.fDE < 0)
+      return;
+
+    // Fill the histograms for each detection element
+    int de = pad.fDE;
+    auto hPedDE = mHistogramPedestalsDE.find(de);
+    if ((hPedDE != mHistogramPedestalsDE.end()) && (hPedDE->second != NULL)) {
+      hPedDE->second->SetBinContent(pad.fDsID + 1, chan_addr + 1, ped);
     }
-  }
-  for (int i = 0; i < 2; i++) {
-    auto ih = mHistogramNoiseXY[i].begin();
-    while (ih != mHistogramNoiseXY[i].end()) {
-      ih->second->Write();
-      ih++;
+    auto hNoiseDE = mHistogramNoiseDE.find(de);
+    if ((hNoiseDE != mHistogramNoiseDE.end()) && (hNoiseDE->second != NULL)) {
+      hNoiseDE->second->SetBinContent(pad.fDsID + 1, chan_addr + 1, rms);
     }
-  }
-  {
-    auto ih = mHistogramPedestalsDE.begin();
-    while (ih != mHistogramPedestalsDE.end()) {
-      ih->second->Write();
-      ih++;
+
+    auto hPedXY = mHistogramPedestalsXY[pad.fCathode].find(de);
+    if ((hPedXY != mHistogramPedestalsXY[pad.fCathode].end()) && (hPedXY->second != NULL)) {
+      setPadContent(hPedXY->second, pad.fX, pad.fY, pad.fSizeX, pad.fSizeY, ped);
     }
-  }
-  {
-    auto ih = mHistogramNoiseDE.begin();
-    while (ih != mHistogramNoiseDE.end()) {
-      ih->second->Write();
-      ih++;
+    auto hNoiseXY = mHistogramNoiseXY[pad.fCathode].find(de);
+    if ((hNoiseXY != mHistogramNoiseXY[pad.fCathode].end()) && (hNoiseXY->second != NULL)) {
+      setPadContent(hNoiseXY->second, pad.fX, pad.fY, pad.fSizeX, pad.fSizeY, rms);
     }
-  }
-  for (int pi = 0; pi < 5; pi++) {
-    for (int i = 0; i < 2; i++) {
-      auto ih = mHistogramNoiseDistributionDE[pi][i].begin();
-      while (ih != mHistogramNoiseDistributionDE[pi][i].end()) {
-        ih->second->Write();
-        ih++;
+
+    updateNoiseDistribution(de, pad, channel);
+  });
+}
+
+void PedestalsTask::updateDigitHistograms()
+{
+  int missingDE = -1;
+  mDigitPedestals.takeChanged([this, &missingDE](PedestalAccumulator::Channel& channel) {
+    int de = channel.key >> 16;
+    int padid = channel.key & 0xFFFF;
+    try {
+      const o2::mch::mapping::Segmentation& segment = o2::mch::mapping::segmentation(de);
+
+      double padX = segment.padPositionX(padid);
+      double padY = segment.padPositionY(padid);
+      float padSizeX = segment.padSizeX(padid);
+      float padSizeY = segment.padSizeY(padid);
+      int cathode = segment.isBendingPad(padid) ? 0 : 1;
+
+      // Fill the histograms for each detection element
+      auto hPedXY = mHistogramPedestalsXY[cathode].find(de);
+      if ((hPedXY != mHistogramPedestalsXY[cathode].end()) && (hPedXY->second != NULL)) {
+        setPadContent(hPedXY->second, padX, padY, padSizeX, padSizeY, channel.pedestal());
+      }
+      auto hNoiseXY = mHistogramNoiseXY[cathode].find(de);
+      if ((hNoiseXY != mHistogramNoiseXY[cathode].end()) && (hNoiseXY->second != NULL)) {
+        setPadContent(hNoiseXY->second, padX, padY, padSizeX, padSizeY, channel.noise());
+      }
+    } catch (const std::exception& e) {
+      if (de != missingDE) {
+        QcInfoLogger::GetInstance() << "[MCH] Detection Element " << de << " not found in mapping." << AliceO2::InfoLogger::InfoLogger::endm;
+        missingDE = de;
       }
     }
-  }
-
-  f.ls();
-  f.Close();
+  });
 }
 
 void PedestalsTask::monitorDataReadout(o2::framework::ProcessingContext& ctx)
@@ -316,14 +330,6 @@ void PedestalsTask::monitorDataReadout(o2::framework::ProcessingContext& ctx)
   //QcInfoLogger::GetInstance() << "monitorDataReadout" << AliceO2::InfoLogger::InfoLogger::endm;
   fprintf(flog, "\n================\nmonitorDataReadout\n================\n");
 
-#ifdef QC_MCH_SAVE_TEMP_ROOTFILE
-  if (count > 0 && (count % 1) == 0 /*&& count <= 5000*/) {
-    save_histograms();
-  }
-  printf("count: %d\n", count);
-  count += 1;
-#endif
-
   // Reset the hits container
   mDecoder.clearHits();
 
@@ -349,102 +355,21 @@ void PedestalsTask::monitorDataReadout(o2::framework::ProcessingContext& ctx)
     // Run the decoder on the CRU buffer
     mDecoder.processData((const char*)raw, (size_t)(payloadSize + sizeof(o2::header::RAWDataHeaderV4)));
 
-    std::vector<SampaHit>& hits = mDecoder.getHits();
+    const SampaHitBuffer& hits = mDecoder.getHits();
     if (mPrintLevel >= 1)
       fprintf(flog, "hits size: %lu\n", hits.size());
     for (uint32_t i = 0; i < hits.size(); i++) {
-      SampaHit& hit = hits[i];
-      if (hit.link_id >= 24 || hit.ds_addr >= 40 || hit.chan_addr >= 64) {
-        fprintf(stdout, "hit[%d]: link_id=%d, ds_addr=%d, chan_addr=%d\n",
-                i, hit.link_id, hit.ds_addr, hit.chan_addr);
+      const SampaHit& hit = hits.hits()[i];
+      if (hit.cru_id >= MCH_MAX_CRU_IN_FLP || hit.link_id >= 24 || hit.ds_addr >= 40 || hit.chan_addr >= 64) {
+        fprintf(stdout, "hit[%d]: cru_id=%d, link_id=%d, ds_addr=%d, chan_addr=%d\n",
+                i, hit.cru_id, hit.link_id, hit.ds_addr, hit.chan_addr);
         continue;
       }
 
-      //int ds_group_id = hit.ds_addr / 5;
-      //int ds_id_in_group = hit.ds_addr % 5;
-      //int ds_chan_addr_in_group = hit.chan_addr + 64 * ds_id_in_group;
-
-      // Update the average and RMS of the pedestal values
-      for (uint32_t s = 0; s < hit.samples.size(); s++) {
-        int sample = hit.samples[s];
-
-        nhits[hit.cru_id][hit.link_id][hit.ds_addr][hit.chan_addr] += 1;
-        uint64_t N = nhits[hit.cru_id][hit.link_id][hit.ds_addr][hit.chan_addr];
-
-        double p0 = pedestal[hit.cru_id][hit.link_id][hit.ds_addr][hit.chan_addr];
-        double p = p0 + (sample - p0) / N;
-        pedestal[hit.cru_id][hit.link_id][hit.ds_addr][hit.chan_addr] = p;
-
-        double M0 = noise[hit.cru_id][hit.link_id][hit.ds_addr][hit.chan_addr];
-        double M = M0 + (sample - p0) * (sample - p);
-        noise[hit.cru_id][hit.link_id][hit.ds_addr][hit.chan_addr] = M;
-
-        /*if (false && hit.link_id == 2 && hit.ds_addr == 37 && hit.chan_addr == 30)
-        fprintf(stdout, "M0=%f  sample=%d  M=%f  nhits=%lu  rms=%f\n",
-            (float)M0, sample, (float)M, nhits[hit.cru_id][hit.link_id][hit.ds_addr][hit.chan_addr],
-            (float)std::sqrt(noise[hit.cru_id][hit.link_id][hit.ds_addr][hit.chan_addr] /
-                nhits[hit.cru_id][hit.link_id][hit.ds_addr][hit.chan_addr]));*/
-      }
-
-      // Fill the histograms for each CRU link
-      double rms = std::sqrt(noise[hit.cru_id][hit.link_id][hit.ds_addr][hit.chan_addr] /
-                             nhits[hit.cru_id][hit.link_id][hit.ds_addr][hit.chan_addr]);
-
-      /*if( false && hit.cru_id==0 && hit.link_id==0 && hit.ds_addr==0 && hit.chan_addr==0)
-      printf("%d %d %d %d -> %d %f %f\n", (int)hit.cru_id, (int)hit.link_id, (int)hit.ds_addr, (int)hit.chan_addr,
-          (int)nhits[hit.cru_id][hit.link_id][hit.ds_addr][hit.chan_addr],
-          pedestal[hit.cru_id][hit.link_id][hit.ds_addr][hit.chan_addr], rms);*/
-
-      mHistogramPedestals[hit.cru_id * 24 + hit.link_id]->SetBinContent(hit.ds_addr + 1, hit.chan_addr + 1,
-                                                                        pedestal[hit.cru_id][hit.link_id][hit.ds_addr][hit.chan_addr]);
-      mHistogramNoise[hit.cru_id * 24 + hit.link_id]->SetBinContent(hit.ds_addr + 1, hit.chan_addr + 1, rms);
-
-      if (hit.pad.fDE < 0)
-        continue;
-
-      // Fill the histograms for each detection element
-      int de = hit.pad.fDE;
-      int dsid = hit.pad.fDsID;
-      float padX = hit.pad.fX;
-      float padY = hit.pad.fY;
-      float padSizeX = hit.pad.fSizeX;
-      float padSizeY = hit.pad.fSizeY;
-
-      /*if (false) fprintf(flog, "mapping: link_id=%d ds_addr=%d chan_addr=%d  ==>  de=%d dsid=%d x=%f y=%f sx=%f sy=%f\n",
-        hit.link_id, hit.ds_addr, hit.chan_addr, de, dsid, padX, padY, padSizeX, padSizeY);*/
-
-      auto hPedDE = mHistogramPedestalsDE.find(de);
-      if ((hPedDE != mHistogramPedestalsDE.end()) && (hPedDE->second != NULL)) {
-        hPedDE->second->SetBinContent(dsid + 1, hit.chan_addr + 1, pedestal[hit.cru_id][hit.link_id][hit.ds_addr][hit.chan_addr]);
-      }
-      auto hNoiseDE = mHistogramNoiseDE.find(de);
-      if ((hNoiseDE != mHistogramNoiseDE.end()) && (hNoiseDE->second != NULL)) {
-        hNoiseDE->second->SetBinContent(dsid + 1, hit.chan_addr + 1, rms);
-      }
-
-      auto hPedXY = mHistogramPedestalsXY[hit.pad.fCathode].find(de);
-      if ((hPedXY != mHistogramPedestalsXY[hit.pad.fCathode].end()) && (hPedXY->second != NULL)) {
-        int binx_min = hPedXY->second->GetXaxis()->FindBin(padX - padSizeX / 2 + 0.1);
-        int binx_max = hPedXY->second->GetXaxis()->FindBin(padX + padSizeX / 2 - 0.1);
-        int biny_min = hPedXY->second->GetYaxis()->FindBin(padY - padSizeY / 2 + 0.1);
-        int biny_max = hPedXY->second->GetYaxis()->FindBin(padY + padSizeY / 2 - 0.1);
-        for (int by = biny_min; by <= biny_max; by++) {
-          for (int bx = binx_min; bx <= binx_max; bx++) {
-            hPedXY->second->SetBinContent(bx, by, pedestal[hit.cru_id][hit.link_id][hit.ds_addr][hit.chan_addr]);
-          }
-        }
-      }
-      auto hNoiseXY = mHistogramNoiseXY[hit.pad.fCathode].find(de);
-      if ((hNoiseXY != mHistogramNoiseXY[hit.pad.fCathode].end()) && (hNoiseXY->second != NULL)) {
-        int binx_min = hNoiseXY->second->GetXaxis()->FindBin(padX - padSizeX / 2 + 0.1);
-        int binx_max = hNoiseXY->second->GetXaxis()->FindBin(padX + padSizeX / 2 - 0.1);
-        int biny_min = hNoiseXY->second->GetYaxis()->FindBin(padY - padSizeY / 2 + 0.1);
-        int biny_max = hNoiseXY->second->GetYaxis()->FindBin(padY + padSizeY / 2 - 0.1);
-        for (int by = biny_min; by <= biny_max; by++) {
-          for (int bx = binx_min; bx <= binx_max; bx++) {
-            hNoiseXY->second->SetBinContent(bx, by, rms);
-          }
-        }
+      // Update the average and RMS of the pedestal values, the histograms are filled at the end of the cycle
+      auto& channel = mElectronicsPedestals.get(electronicsKey(hit.cru_id, hit.link_id, hit.ds_addr, hit.chan_addr));
+      for (int sample : hits.samples(hit)) {
+        mElectronicsPedestals.add(channel, sample);
       }
     }
   }
@@ -454,14 +379,6 @@ void PedestalsTask::monitorDataDigits(const o2::framework::DataRef& input)
 {
   //QcInfoLogger::GetInstance() << "monitorDataDigits" << AliceO2::InfoLogger::InfoLogger::endm;
 
-#ifdef QC_MCH_SAVE_TEMP_ROOTFILE
-  if ((count % 10) == 0 /*&& count <= 5000*/) {
-    save_histograms();
-    printf("count: %d\n", count);
-  }
-  count += 1;
-#endif
-
   if (input.spec->binding != "digits")
     return;
 
@@ -498,63 +415,12 @@ void PedestalsTask::monitorDataDigits(const o2::framework::DataRef& input)
 
     //fprintf(stdout, "digit[%d]: ADC=%d, DetId=%d, PadId=%d\n",
     //        i, ADC, de, padid);
-    if (ADC < 0 || de < 0 || padid < 0) {
+    if (ADC < 0 || de < 0 || padid < 0 || padid > 0xFFFF) {
       continue;
     }
 
-    try {
-      const o2::mch::mapping::Segmentation& segment = o2::mch::mapping::segmentation(de);
-
-      double padX = segment.padPositionX(padid);
-      double padY = segment.padPositionY(padid);
-      float padSizeX = segment.padSizeX(padid);
-      float padSizeY = segment.padSizeY(padid);
-      int cathode = segment.isBendingPad(padid) ? 0 : 1;
-
-      // Update the average and RMS of the pedestal values
-      nhitsDigits[de][padid] += 1;
-      uint64_t N = nhitsDigits[de][padid];
-
-      double p0 = pedestalDigits[de][padid];
-      double p = p0 + (ADC - p0) / N;
-      pedestalDigits[de][padid] = p;
-
-      double M0 = noiseDigits[de][padid];
-      double M = M0 + (ADC - p0) * (ADC - p);
-      noiseDigits[de][padid] = M;
-
-      double rms = std::sqrt(noiseDigits[de][padid] /
-                             nhitsDigits[de][padid]);
-
-      // Fill the histograms for each detection element
-      auto hPedXY = mHistogramPedestalsXY[cathode].find(de);
-      if ((hPedXY != mHistogramPedestalsXY[cathode].end()) && (hPedXY->second != NULL)) {
-        int binx_min = hPedXY->second->GetXaxis()->FindBin(padX - padSizeX / 2 + 0.1);
-        int binx_max = hPedXY->second->GetXaxis()->FindBin(padX + padSizeX / 2 - 0.1);
-        int biny_min = hPedXY->second->GetYaxis()->FindBin(padY - padSizeY / 2 + 0.1);
-        int biny_max = hPedXY->second->GetYaxis()->FindBin(padY + padSizeY / 2 - 0.1);
-        for (int by = biny_min; by <= biny_max; by++) {
-          for (int bx = binx_min; bx <= binx_max; bx++) {
-            hPedXY->second->SetBinContent(bx, by, pedestalDigits[de][padid]);
-          }
-        }
-      }
-      auto hNoiseXY = mHistogramNoiseXY[cathode].find(de);
-      if ((hNoiseXY != mHistogramNoiseXY[cathode].end()) && (hNoiseXY->second != NULL)) {
-        int binx_min = hNoiseXY->second->GetXaxis()->FindBin(padX - padSizeX / 2 + 0.1);
-        int binx_max = hNoiseXY->second->GetXaxis()->FindBin(padX + padSizeX / 2 - 0.1);
-        int biny_min = hNoiseXY->second->GetYaxis()->FindBin(padY - padSizeY / 2 + 0.1);
-        int biny_max = hNoiseXY->second->GetYaxis()->FindBin(padY + padSizeY / 2 - 0.1);
-        for (int by = biny_min; by <= biny_max; by++) {
-          for (int bx = binx_min; bx <= binx_max; bx++) {
-            hNoiseXY->second->SetBinContent(bx, by, rms);
-          }
-        }
-      }
-    } catch (const std::exception& e) {
-      QcInfoLogger::GetInstance() << "[MCH] Detection Element " << de << " not found in mapping." << AliceO2::InfoLogger::InfoLogger::endm;
-      return;
-    }
+    // Update the average and RMS of the pedestal values, the histograms are filled at the end of the cycle
+    mDigitPedestals.add(digitKey(de, padid), ADC);
   }
 }
 
@@ -571,6 +437,18 @@ void PedestalsTask::monitorData(o2::framework::ProcessingContext& ctx)
 void PedestalsTask::endOfCycle()
 {
   QcInfoLogger::GetInstance() << "endOfCycle" << AliceO2::InfoLogger::InfoLogger::endm;
+
+  // Report the errors found by the decoder
+  auto& errors = mDecoder.getErrors();
+  errors.fillHistogram(mHistogramDecodingErrors);
+  if (auto monitoring = getMonitoring()) {
+    errors.sendMetrics(*monitoring);
+  }
+  errors.logSamples();
+
+  // only the channels which received data during the cycle are updated
+  updateElectronicsHistograms();
+  updateDigitHistograms();
 }
 
 void PedestalsTask::endOfActivity(Activity& /*activity*/)
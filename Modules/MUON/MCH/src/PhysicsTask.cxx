@@ -8,7 +8,6 @@
 #include <TCanvas.h>
 #include <TH1.h>
 #include <TH2.h>
-#include <TFile.h>
 #include <algorithm>
 
 #include "Headers/RAWDataHeader.h"
@@ -55,7 +54,7 @@ namespace quality_control_modules
 {
 namespace muonchambers
 {
-PhysicsTask::PhysicsTask() : TaskInterface(), count(1) {}
+PhysicsTask::PhysicsTask() : TaskInterface() {}
 
 PhysicsTask::~PhysicsTask() { fclose(flog); }
 
@@ -64,7 +63,19 @@ void PhysicsTask::initialize(o2::framework::InitContext& /*ctx*/)
   QcInfoLogger::GetInstance() << "initialize PhysicsTask" << AliceO2::InfoLogger::InfoLogger::endm;
   fprintf(stdout, "initialize PhysicsTask\n");
 
-  mDecoder.initialize();
+  std::string padTableFile;
+  if (auto param = mCustomParameters.find("padTableFile"); param != mCustomParameters.end()) {
+    padTableFile = param->second;
+  }
+  mDecoder.initialize(padTableFile);
+  if (auto param = mCustomParameters.find("decodingThreads"); param != mCustomParameters.end()) {
+    mDecoder.setNumberOfThreads(std::max(1, std::stoi(param->second)));
+  }
+  if (auto param = mCustomParameters.find("errorSamplesPerCycle"); param != mCustomParameters.end()) {
+    mDecoder.getErrors().setMaxSamples(std::stoi(param->second));
+  }
+  mHistogramDecodingErrors = DecodingErrors::createHistogram("QcMuonChambers_DecodingErrors");
+  getObjectsManager()->startPublishing(mHistogramDecodingErrors);
 
   uint32_t dsid;
   std::vector<int> DEs;
@@ -142,31 +153,6 @@ void PhysicsTask::monitorData(o2::framework::ProcessingContext& ctx)
 
   //QcInfoLogger::GetInstance() << "PhysicsTask::monitorData" << AliceO2::InfoLogger::InfoLogger::endm;
 
-  printf("count: %d\n", count);
-  if ((count % 1) == 0) {
-
-    TFile f("/tmp/qc.root", "RECREATE");
-    for (int i = 0; i < 3 * 24; i++) {
-      mHistogramNhits[i]->Write();
-      mHistogramADCamplitude[i]->Write();
-    }
-    int nbDEs = DEs.size();
-    for (int elem = 0; elem < nbDEs; elem++) {
-      int de = DEs[elem];
-      auto h = mHistogramADCamplitudeDE.find(de);
-      if ((h != mHistogramADCamplitudeDE.end()) && (h->second != NULL)) {
-        h->second->Write();
-      }
-      auto h2 = mHistogramNhitsDE.find(de);
-      if ((h2 != mHistogramNhitsDE.end()) && (h2->second != NULL)) {
-        h2->second->Write();
-      }
-
-      f.ls();
-      f.Close();
-    }
-  }
-  count += 1;
 
   // exemplary ways of accessing inputs (incoming data), that were specified in the .ini file - e.g.:
   //  [readoutInput]
@@ -190,12 +176,12 @@ void PhysicsTask::monitorData(o2::framework::ProcessingContext& ctx)
 
     mDecoder.processData(input.payload, header->payloadSize);
 
-    std::vector<SampaHit>& hits = mDecoder.getHits();
+    const SampaHitBuffer& hits = mDecoder.getHits();
     if (gPrintLevel >= 1)
       fprintf(flog, "hits.size()=%d\n", (int)hits.size());
     for (uint32_t i = 0; i < hits.size(); i++) {
       //continue;
-      SampaHit& hit = hits[i];
+      const SampaHit& hit = hits.hits()[i];
       if (gPrintLevel >= 1)
         fprintf(stdout, "hit[%d]: link_id=%d, ds_addr=%d, chan_addr=%d\n",
                 i, hit.link_id, hit.ds_addr, hit.chan_addr);
@@ -270,6 +256,14 @@ void PhysicsTask::monitorData(o2::framework::ProcessingContext& ctx)
 void PhysicsTask::endOfCycle()
 {
   QcInfoLogger::GetInstance() << "endOfCycle" << AliceO2::InfoLogger::InfoLogger::endm;
+
+  // Report the errors found by the decoder
+  auto& errors = mDecoder.getErrors();
+  errors.fillHistogram(mHistogramDecodingErrors);
+  if (auto monitoring = getMonitoring()) {
+    errors.sendMetrics(*monitoring);
+  }
+  errors.logSamples();
 }
 
 void PhysicsTask::endOfActivity(Activity& /*activity*/)
@@ -0,0 +1,90 @@
+///
+/// \file   SampaHeaderValidator.cxx
+///
+
+#include "MCH/SampaHeaderValidator.h"
+
+#include <array>
+
+namespace o2::quality_control_modules::muonchambers
+{
+
+namespace
+{
+struct HammingTables {
+  /// position in the interleaved code word of each bit of the header, 0 for the parity bit
+  std::array<uint8_t, 50> positions{};
+  /// XOR of the positions of the bits set in each byte of the header
+  std::array<std::array<uint8_t, 256>, 7> syndromes{};
+  /// bit of the header at each position of the interleaved code word, -1 if none
+  std::array<int8_t, 64> bits{};
+
+  HammingTables()
+  {
+    // the Hamming bits are at the powers of 2, the data bits fill the other positions in order
+    int position = 1;
+    for (int bit = 7; bit < 50; bit++, position++) {
+      while ((position & (position - 1)) == 0) {
+        position++;
+      }
+      positions[bit] = position;
+    }
+    for (int bit = 0; bit < 6; bit++) {
+      positions[bit] = 1 << bit;
+    }
+    positions[6] = 0;
+
+    bits.fill(-1);
+    for (int bit = 0; bit < 50; bit++) {
+      if (positions[bit] != 0) {
+        bits[positions[bit]] = bit;
+      }
+    }
+
+    for (int byte = 0; byte < 7; byte++) {
+      for (int value = 0; value < 256; value++) {
+        uint8_t syndrome = 0;
+        for (int bit = 0; bit < 8 && 8 * byte + bit < 50; bit++) {
+          if ((value >> bit) & 0x1) {
+            syndrome ^= positions[8 * byte + bit];
+          }
+        }
+        syndromes[byte][value] = syndrome;
+      }
+    }
+  }
+};
+
+const HammingTables gTables;
+} // namespace
+
+uint8_t SampaHeaderValidator::syndrome(uint64_t header)
+{
+  uint8_t syndrome = 0;
+  for (int byte = 0; byte < 7; byte++) {
+    syndrome ^= gTables.syndromes[byte][(header >> (8 * byte)) & 0xFF];
+  }
+  return syndrome;
+}
+
+SampaHeaderValidator::HammingResult SampaHeaderValidator::check(uint64_t header)
+{
+  // the parity of the whole header is wrong if one bit is, including the parity bit itself
+  bool syndromeError = syndrome(header) != 0;
+  bool wrongParity = parity(header) != 0;
+  return { syndromeError || wrongParity, syndromeError && !wrongParity };
+}
+
+uint64_t SampaHeaderValidator::correct(uint64_t header)
+{
+  auto wrongPosition = syndrome(header);
+  bool wrongParity = parity(header) != 0;
+  if (wrongPosition == 0) {
+    // only the parity bit can be wrong
+    return wrongParity ? header ^ (static_cast<uint64_t>(1) << 6) : header;
+  }
+  auto wrongBit = gTables.bits[wrongPosition];
+  return wrongBit < 0 ? header : header ^ (static_cast<uint64_t>(1) << wrongBit);
+}
+
+} // namespace o2::quality_control_modules::muonchambers
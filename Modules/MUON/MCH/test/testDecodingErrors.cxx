@@ -0,0 +1,58 @@
+///
+/// \file   testDecodingErrors.cxx
+///
+
+#include "MCH/DecodingErrors.h"
+
+#define BOOST_TEST_MODULE DecodingErrors test
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <thread>
+
+namespace o2::quality_control_modules::muonchambers
+{
+
+BOOST_AUTO_TEST_CASE(counters)
+{
+  DecodingErrors errors;
+  errors.add(1, 2, 3, DecodingError::HammingError, 0x123);
+  errors.add(1, 2, 4, DecodingError::HammingError, 0x456);
+  errors.add(0, 5, 0, DecodingError::PacketEnd, 0);
+  // out of the decoder arrays
+  errors.add(MCH_MAX_CRU_ID, 0, 0, DecodingError::WrongLink, 0);
+  errors.add(0, -1, 0, DecodingError::WrongLink, 0);
+
+  BOOST_CHECK_EQUAL(errors.get(DecodingError::HammingError, 1, 2), 2);
+  BOOST_CHECK_EQUAL(errors.get(DecodingError::HammingError, 0, 5), 0);
+  BOOST_CHECK_EQUAL(errors.get(DecodingError::HammingError), 2);
+  BOOST_CHECK_EQUAL(errors.get(DecodingError::PacketEnd, 0, 5), 1);
+  BOOST_CHECK_EQUAL(errors.get(DecodingError::WrongLink), 2);
+
+  errors.reset();
+  BOOST_CHECK_EQUAL(errors.get(DecodingError::HammingError), 0);
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_links)
+{
+  DecodingErrors errors(5);
+  std::vector<std::thread> threads;
+  for (int link = 0; link < 4; link++) {
+    threads.emplace_back([&errors, link]() {
+      for (int i = 0; i < 100000; i++) {
+        errors.add(0, link, i % 40, DecodingError::BunchCrossing, i);
+        errors.add(-1, -1, -1, DecodingError::WrongRdh, i);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (int link = 0; link < 4; link++) {
+    BOOST_CHECK_EQUAL(errors.get(DecodingError::BunchCrossing, 0, link), 100000);
+  }
+  BOOST_CHECK_EQUAL(errors.get(DecodingError::WrongRdh), 400000);
+  errors.logSamples();
+}
+
+} // namespace o2::quality_control_modules::muonchambers
@@ -0,0 +1,121 @@
+///
+/// \file   testPadTable.cxx
+///
+
+#include "MCH/PadTable.h"
+#include "MCHMappingInterface/Segmentation.h"
+
+#define BOOST_TEST_MODULE PadTable test
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <cstdio>
+#include <fstream>
+#include <unistd.h>
+
+namespace o2::quality_control_modules::muonchambers
+{
+
+std::vector<std::pair<uint32_t, uint32_t>> dualSampas()
+{
+  std::vector<std::pair<uint32_t, uint32_t>> result;
+  for (uint32_t de : { 100, 501, 1025 }) {
+    for (uint32_t dsid = 0; dsid < 1400; dsid += 3) {
+      result.emplace_back(de, dsid);
+    }
+  }
+  // unknown DE
+  result.emplace_back(42, 1);
+  return result;
+}
+
+// the table has to give the same answers as the segmentation
+void checkAgainstSegmentation(const PadTable& table)
+{
+  for (const auto& [de, dsid] : dualSampas()) {
+    for (uint32_t channel = 0; channel < 64; channel++) {
+      const PadTable::Pad* pad = table.find(de, dsid, channel);
+      BOOST_REQUIRE(pad != nullptr);
+      try {
+        const auto& segment = o2::mch::mapping::segmentation(de);
+        int padid = segment.findPadByFEE(dsid, channel);
+        if (padid < 0) {
+          BOOST_CHECK_EQUAL(pad->padId, PadTable::sNoPad);
+          continue;
+        }
+        BOOST_CHECK_EQUAL(pad->padId, padid);
+        BOOST_CHECK_EQUAL(pad->x, static_cast<float>(segment.padPositionX(padid)));
+        BOOST_CHECK_EQUAL(pad->y, static_cast<float>(segment.padPositionY(padid)));
+        BOOST_CHECK_EQUAL(pad->sizeX, static_cast<float>(segment.padSizeX(padid)));
+        BOOST_CHECK_EQUAL(pad->sizeY, static_cast<float>(segment.padSizeY(padid)));
+        BOOST_CHECK_EQUAL(pad->cathode, segment.isBendingPad(padid) ? 0 : 1);
+      } catch (const std::exception&) {
+        BOOST_CHECK_EQUAL(pad->padId, PadTable::sUnknownDualSampa);
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(pad_table_build)
+{
+  PadTable table;
+  BOOST_CHECK(table.empty());
+  BOOST_CHECK(table.find(100, 1, 0) == nullptr);
+
+  table.build(dualSampas());
+  BOOST_CHECK(!table.empty());
+  BOOST_CHECK(!table.isMapped());
+  BOOST_CHECK_EQUAL(table.getKey(), PadTable::computeKey(dualSampas()));
+  checkAgainstSegmentation(table);
+
+  // the keys which were not requested
+  BOOST_CHECK(table.find(100, 2, 0) == nullptr);
+  BOOST_CHECK(table.find(100, 1, 64) == nullptr);
+  BOOST_CHECK(table.find(101, 1, 0) == nullptr);
+  BOOST_CHECK(table.find(5000, 1, 0) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(pad_table_file)
+{
+  std::string path = "/tmp/testPadTable_" + std::to_string(getpid()) + ".bin";
+  uint64_t key = PadTable::computeKey(dualSampas());
+  {
+    PadTable table;
+    table.build(dualSampas());
+    BOOST_REQUIRE(table.save(path));
+  }
+
+  PadTable table;
+  BOOST_REQUIRE(table.load(path, key));
+  BOOST_CHECK(table.isMapped());
+  checkAgainstSegmentation(table);
+
+  // a file made for another list of DS is stale
+  BOOST_CHECK(!table.load(path, key + 1));
+  BOOST_CHECK(table.empty());
+
+  // so is a file built with another mapping
+  {
+    // the fingerprint of the mapping follows the magic number, the version, the number of DEs and the key
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekg(24);
+    char byte = file.get() ^ 1;
+    file.seekp(24);
+    file.put(byte);
+  }
+  BOOST_CHECK(!table.load(path, key));
+
+  // a truncated file is rejected
+  {
+    std::ifstream in(path, std::ios::binary);
+    std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(content.data(), content.size() / 2);
+  }
+  BOOST_CHECK(!table.load(path, key));
+  BOOST_CHECK(!table.load(path + ".missing", key));
+
+  std::remove(path.c_str());
+}
+
+} // namespace o2::quality_control_modules::muonchambers
@@ -0,0 +1,72 @@
+///
+/// \file   testPedestalAccumulator.cxx
+///
+
+#include "MCH/PedestalAccumulator.h"
+
+#define BOOST_TEST_MODULE PedestalAccumulator test
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <random>
+#include <set>
+
+namespace o2::quality_control_modules::muonchambers
+{
+
+BOOST_AUTO_TEST_CASE(pedestal_and_noise)
+{
+  PedestalAccumulator accumulator;
+  std::mt19937 generator(12345);
+  std::normal_distribution<double> distribution(250., 1.2);
+
+  // reference computed in double precision with the two-pass formula
+  std::vector<double> samples;
+  for (int i = 0; i < 200000; i++) {
+    samples.push_back(std::round(distribution(generator)));
+    accumulator.add(7, samples.back());
+  }
+  double mean = 0;
+  for (double sample : samples) {
+    mean += sample;
+  }
+  mean /= samples.size();
+  double variance = 0;
+  for (double sample : samples) {
+    variance += (sample - mean) * (sample - mean);
+  }
+  variance /= samples.size();
+
+  auto channel = accumulator.find(7);
+  BOOST_REQUIRE(channel != nullptr);
+  BOOST_CHECK_EQUAL(channel->entries, samples.size());
+  BOOST_CHECK_CLOSE(channel->pedestal(), mean, 0.001);
+  BOOST_CHECK_CLOSE(channel->noise(), std::sqrt(variance), 0.5);
+  BOOST_CHECK(accumulator.find(8) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(changed_channels)
+{
+  PedestalAccumulator accumulator;
+  for (uint32_t key : { 3, 1, 3, 2 }) {
+    accumulator.add(key, 100);
+  }
+  BOOST_CHECK_EQUAL(accumulator.size(), 3);
+  BOOST_CHECK_EQUAL(accumulator.getNumberOfChanged(), 3);
+
+  std::set<uint32_t> changed;
+  accumulator.takeChanged([&changed](PedestalAccumulator::Channel& channel) { changed.insert(channel.key); });
+  BOOST_CHECK(changed == std::set<uint32_t>({ 1, 2, 3 }));
+  BOOST_CHECK_EQUAL(accumulator.getNumberOfChanged(), 0);
+
+  // only the channels which received data are given at the next call
+  accumulator.add(2, 102);
+  changed.clear();
+  accumulator.takeChanged([&changed](PedestalAccumulator::Channel& channel) { changed.insert(channel.key); });
+  BOOST_CHECK(changed == std::set<uint32_t>({ 2 }));
+  BOOST_CHECK_EQUAL(accumulator.find(2)->entries, 2);
+  BOOST_CHECK_CLOSE(accumulator.find(2)->pedestal(), 101, 1e-4);
+  BOOST_CHECK_CLOSE(accumulator.find(2)->noise(), 1, 1e-4);
+}
+
+} // namespace o2::quality_control_modules::muonchambers
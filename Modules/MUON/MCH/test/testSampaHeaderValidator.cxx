@@ -0,0 +1,224 @@
+///
+/// \file   testSampaHeaderValidator.cxx
+///
+
+#include "MCH/SampaHeaderValidator.h"
+
+#define BOOST_TEST_MODULE SampaHeaderValidator test
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <random>
+
+namespace o2::quality_control_modules::muonchambers
+{
+
+// The bit-by-bit implementation which was used by the decoder, as a reference.
+int referenceParity(uint64_t data)
+{
+  int parity, bit;
+  parity = data & 0x1;
+  for (int i = 1; i < 50; i++) {
+    bit = (data >> i) & 0x1;
+    parity = (parity || bit) && (!(parity && bit)); // XOR of all bits
+  }
+  return parity;
+}
+
+void referenceHammingDecode(unsigned int buffer[2], bool& error, bool& uncorrectable, bool fix_data)
+{
+
+  bool parityreceived[6];
+  bool data_in[43];
+  bool overallparity;
+
+  for (int i = 0; i < 6; i++)
+    parityreceived[i] = (buffer[0] >> i) & 0x1;
+  overallparity = (buffer[0] >> 6) & 0x1;
+  for (int i = 7; i < 30; i++)
+    data_in[i - 7] = (buffer[0] >> i) & 0x1;
+  for (int i = 30; i < 50; i++)
+    data_in[i - 7] = (buffer[1] >> (i - 30)) & 0x1;
+
+  bool corrected_out[43];
+  bool overallparitycalc = 0;
+  bool overallparity_out = 0;
+  bool paritycalc[6];
+  bool paritycorreced_out[6];
+
+  paritycalc[0] = data_in[0] ^ data_in[1] ^ data_in[3] ^ data_in[4] ^ data_in[6] ^
+                  data_in[8] ^ data_in[10] ^ data_in[11] ^ data_in[13] ^ data_in[15] ^
+                  data_in[17] ^ data_in[19] ^ data_in[21] ^ data_in[23] ^ data_in[25] ^
+                  data_in[26] ^ data_in[28] ^ data_in[30] ^ data_in[32] ^ data_in[34] ^
+                  data_in[36] ^ data_in[38] ^ data_in[40] ^ data_in[42];
+
+  paritycalc[1] = data_in[0] ^ data_in[2] ^ data_in[3] ^ data_in[5] ^ data_in[6] ^
+                  data_in[9] ^ data_in[10] ^ data_in[12] ^ data_in[13] ^ data_in[16] ^
+                  data_in[17] ^ data_in[20] ^ data_in[21] ^ data_in[24] ^ data_in[25] ^
+                  data_in[27] ^ data_in[28] ^ data_in[31] ^ data_in[32] ^ data_in[35] ^
+                  data_in[36] ^ data_in[39] ^ data_in[40];
+
+  paritycalc[2] = data_in[1] ^ data_in[2] ^ data_in[3] ^ data_in[7] ^ data_in[8] ^
+                  data_in[9] ^ data_in[10] ^ data_in[14] ^ data_in[15] ^ data_in[16] ^
+                  data_in[17] ^ data_in[22] ^ data_in[23] ^ data_in[24] ^ data_in[25] ^
+                  data_in[29] ^ data_in[30] ^ data_in[31] ^ data_in[32] ^ data_in[37] ^
+                  data_in[38] ^ data_in[39] ^ data_in[40];
+
+  paritycalc[3] = data_in[4] ^ data_in[5] ^ data_in[6] ^ data_in[7] ^ data_in[8] ^
+                  data_in[9] ^ data_in[10] ^ data_in[18] ^ data_in[19] ^ data_in[20] ^
+                  data_in[21] ^ data_in[22] ^ data_in[23] ^ data_in[24] ^ data_in[25] ^
+                  data_in[33] ^ data_in[34] ^ data_in[35] ^ data_in[36] ^ data_in[37] ^
+                  data_in[38] ^ data_in[39] ^ data_in[40];
+
+  paritycalc[4] = data_in[11] ^ data_in[12] ^ data_in[13] ^ data_in[14] ^ data_in[15] ^
+                  data_in[16] ^ data_in[17] ^ data_in[18] ^ data_in[19] ^ data_in[20] ^
+                  data_in[21] ^ data_in[22] ^ data_in[23] ^ data_in[24] ^ data_in[25] ^
+                  data_in[41] ^ data_in[42];
+
+  paritycalc[5] = data_in[26] ^ data_in[27] ^ data_in[28] ^ data_in[29] ^ data_in[30] ^
+                  data_in[31] ^ data_in[32] ^ data_in[33] ^ data_in[34] ^ data_in[35] ^
+                  data_in[36] ^ data_in[37] ^ data_in[38] ^ data_in[39] ^ data_in[40] ^
+                  data_in[41] ^ data_in[42];
+
+  unsigned char syndrome = 0;
+
+  for (int i = 0; i < 6; i++)
+    syndrome |= (paritycalc[i] ^ parityreceived[i]) << i;
+
+  bool data_parity_interleaved[64];
+  bool syndromeerror;
+
+  data_parity_interleaved[1] = parityreceived[0];
+  data_parity_interleaved[2] = parityreceived[1];
+  data_parity_interleaved[3] = data_in[0];
+  data_parity_interleaved[4] = parityreceived[2];
+  for (int i = 1; i <= 3; i++)
+    data_parity_interleaved[i + 5 - 1] = data_in[i];
+  data_parity_interleaved[8] = parityreceived[3];
+  for (int i = 4; i <= 10; i++)
+    data_parity_interleaved[i + 9 - 4] = data_in[i];
+  data_parity_interleaved[16] = parityreceived[4];
+  for (int i = 11; i <= 25; i++)
+    data_parity_interleaved[i + 17 - 11] = data_in[i];
+  data_parity_interleaved[32] = parityreceived[5];
+  for (int i = 26; i <= 42; i++)
+    data_parity_interleaved[i + 33 - 26] = data_in[i];
+
+  data_parity_interleaved[syndrome] = !data_parity_interleaved[syndrome]; // correct the interleaved
+
+  paritycorreced_out[0] = data_parity_interleaved[1];
+  paritycorreced_out[1] = data_parity_interleaved[2];
+  corrected_out[0] = data_parity_interleaved[3];
+  paritycorreced_out[2] = data_parity_interleaved[4];
+  for (int i = 1; i <= 3; i++)
+    corrected_out[i] = data_parity_interleaved[i + 5 - 1];
+  paritycorreced_out[3] = data_parity_interleaved[8];
+  for (int i = 4; i <= 10; i++)
+    corrected_out[i] = data_parity_interleaved[i + 9 - 4];
+  paritycorreced_out[4] = data_parity_interleaved[16];
+  for (int i = 11; i <= 25; i++)
+    corrected_out[i] = data_parity_interleaved[i + 17 - 11];
+  paritycorreced_out[5] = data_parity_interleaved[32];
+  for (int i = 26; i <= 42; i++)
+    corrected_out[i] = data_parity_interleaved[i + 33 - 26];
+
+
+  bool wrongparity;
+  for (int i = 0; i < 43; i++)
+    overallparitycalc ^= data_in[i];
+  for (int i = 0; i < 6; i++)
+    overallparitycalc ^= parityreceived[i];
+  syndromeerror = (syndrome > 0) ? 1 : 0; // error if syndrome larger than 0
+  wrongparity = (overallparitycalc != overallparity);
+  overallparity_out = !syndromeerror && wrongparity ? overallparitycalc : overallparity; // If error was in parity fix parity
+  error = syndromeerror | wrongparity;
+  uncorrectable = (syndromeerror && (!wrongparity));
+
+  if (fix_data) {
+    for (int i = 0; i < 6; i++)
+      buffer[0] = (buffer[0] & ~(1 << i)) | (paritycorreced_out[i] << i);
+    buffer[0] = (buffer[0] & ~(1 << 6)) | (overallparity_out << 6);
+    for (int i = 7; i < 30; i++)
+      buffer[0] = (buffer[0] & ~(1 << i)) | (corrected_out[i - 7] << i);
+    for (int i = 30; i < 50; i++)
+      buffer[1] = (buffer[1] & ~(1 << (i - 30))) | (corrected_out[i - 7] << (i - 30));
+  }
+}
+
+// Compares the validator with the reference implementation, returns false if they differ.
+bool matchesReference(uint64_t header)
+{
+  header &= SampaHeaderValidator::headerMask;
+  unsigned int buffer[2] = { static_cast<unsigned int>(header & 0x3FFFFFFF), static_cast<unsigned int>(header >> 30) };
+  bool error = false;
+  bool uncorrectable = false;
+  referenceHammingDecode(buffer, error, uncorrectable, true);
+  uint64_t corrected = buffer[0] + (static_cast<uint64_t>(buffer[1]) << 30);
+
+  auto result = SampaHeaderValidator::check(header);
+  return result.error == error && result.uncorrectable == uncorrectable &&
+         SampaHeaderValidator::correct(header) == corrected &&
+         SampaHeaderValidator::parity(header) == referenceParity(header);
+}
+
+// Returns the header with valid Hamming and parity bits.
+uint64_t encode(uint64_t header)
+{
+  header &= SampaHeaderValidator::headerMask & ~static_cast<uint64_t>(0x7F);
+  header |= SampaHeaderValidator::syndrome(header);
+  if (SampaHeaderValidator::parity(header)) {
+    header |= 0x40;
+  }
+  return header;
+}
+
+BOOST_AUTO_TEST_CASE(valid_headers)
+{
+  std::mt19937_64 generator(42);
+  for (int i = 0; i < 1000; i++) {
+    auto header = encode(generator());
+    BOOST_REQUIRE(!SampaHeaderValidator::check(header).error);
+    BOOST_REQUIRE_EQUAL(SampaHeaderValidator::parity(header), 0);
+    BOOST_REQUIRE(matchesReference(header));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(all_bytes)
+{
+  // every entry of the syndrome tables, on top of valid and random headers
+  std::mt19937_64 generator(43);
+  int mismatches = 0;
+  for (int byte = 0; byte < 7; byte++) {
+    for (uint64_t value = 0; value < 256; value++) {
+      for (auto background : { encode(generator()), generator(), static_cast<uint64_t>(0) }) {
+        uint64_t header = (background & ~(static_cast<uint64_t>(0xFF) << (8 * byte))) | (value << (8 * byte));
+        mismatches += !matchesReference(header);
+      }
+    }
+  }
+  BOOST_CHECK_EQUAL(mismatches, 0);
+}
+
+BOOST_AUTO_TEST_CASE(all_single_and_double_errors)
+{
+  std::mt19937_64 generator(44);
+  int mismatches = 0;
+  int corrected = 0;
+  for (int i = 0; i < 200; i++) {
+    auto header = encode(generator());
+    for (int first = 0; first < 50; first++) {
+      auto single = header ^ (static_cast<uint64_t>(1) << first);
+      mismatches += !matchesReference(single);
+      corrected += SampaHeaderValidator::correct(single) == header;
+      for (int second = first + 1; second < 50; second++) {
+        auto twice = single ^ (static_cast<uint64_t>(1) << second);
+        mismatches += !matchesReference(twice);
+        BOOST_REQUIRE(SampaHeaderValidator::check(twice).uncorrectable);
+      }
+    }
+  }
+  BOOST_CHECK_EQUAL(mismatches, 0);
+  BOOST_CHECK_EQUAL(corrected, 200 * 50);
+}
+
+} // namespace o2::quality_control_modules::muonchambers
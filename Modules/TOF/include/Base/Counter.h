@@ -18,6 +18,9 @@
 
 // #define ENABLE_COUNTER_DEBUG_MODE // Flag used to enable more printing and more debug
 
+#include <cstdint>
+#include <vector>
+
 // ROOT includes
 #include "TObject.h"
 #include "TH1.h"
@@ -29,6 +32,8 @@ namespace o2::quality_control_modules::tof
 {
 
 /// \brief Class to count events
+/// The counters are indexed by the position of their name in Tc::names, usually given by an enum.
+/// Counting does not log: the positions beyond Tc::size are counted apart, to be reported once per cycle.
 /// \author Nicolo' Jacazio
 template <typename Tc>
 class Counter
@@ -41,28 +46,41 @@ class Counter
   /// Function to increment a counter
   void Count(UInt_t v)
   {
-    if (v > Tc::size) {
-      ILOG(Error) << "Incrementing counter too far! " << v << "/" << Size() << ENDM;
+    if (v >= Tc::size) {
+      outOfRange++;
+      return;
     }
 #ifdef ENABLE_COUNTER_DEBUG_MODE
     ILOG(Info) << "Incrementing " << v << "/" << Size() << " to " << counter[v] << ENDM;
 #endif
     counter[v]++;
   }
+  /// Function to add the counts of another counter, e.g. of another thread
+  void Add(const Counter& other)
+  {
+    for (UInt_t i = 0; i < Tc::size; i++) {
+      counter[i] += other.counter[i];
+    }
+    outOfRange += other.outOfRange;
+  }
   /// Function to reset counters
   void Reset()
   {
-    ILOG(Info) << "Resetting Counter" << ENDM;
     for (UInt_t i = 0; i < Tc::size; i++) {
       counter[i] = 0;
     }
+    outOfRange = 0;
   }
   /// Function to get how many counts where observed
   uint32_t HowMany(UInt_t pos) const { return counter[pos]; }
+  /// Function to get how many counts were requested beyond the size of the counter
+  uint32_t HowManyOutOfRange() const { return outOfRange; }
   /// Function to make a histogram out of the counters
   void MakeHistogram(TH1* h) const
   {
+#ifdef ENABLE_COUNTER_DEBUG_MODE
     ILOG(Info) << "Making Histogram " << h->GetName() << " out of counter" << ENDM;
+#endif
     h->Reset();
     h->GetXaxis()->Set(Tc::size, 0, Tc::size);
     UInt_t binx = 1;
@@ -80,7 +98,9 @@ class Counter
   /// Function to fill a histogram with the counters
   void FillHistogram(TH1* h, UInt_t biny = 0, UInt_t binz = 0) const
   {
+#ifdef ENABLE_COUNTER_DEBUG_MODE
     ILOG(Info) << "Filling Histogram " << h->GetName() << " out of counter" << ENDM;
+#endif
     UInt_t binx = 1;
     for (UInt_t i = 0; i < Tc::size; i++) {
       if (Tc::names[i].IsNull()) {
@@ -112,6 +132,45 @@ class Counter
   static_assert(std::is_same<decltype(Tc::names), const TString[Tc::size]>::value, "names must be const TString arrays");
   /// Containers to fill
   uint32_t counter[Tc::size] = { 0 };
+  /// Counts beyond Tc::size
+  uint32_t outOfRange = 0;
+};
+
+/// \brief Counters shared by several threads, each thread counting in its own shard without synchronization.
+/// The shards are summed once they are not filled anymore, e.g. at the end of the cycle.
+/// Tcounters is a Counter, or any set of counters with the Add and Reset functions.
+template <typename Tcounters>
+class CounterShards
+{
+ public:
+  /// \brief Constructor
+  explicit CounterShards(UInt_t nshards = 1) : shards(nshards) {}
+  /// Function to get the shard of a thread, which must not be used by other threads at the same time
+  Tcounters& Shard(UInt_t i) { return shards[i].counters; }
+  /// Getter for the number of shards
+  UInt_t Size() const { return shards.size(); }
+  /// Function to add the counts of all the shards to total and reset the shards
+  void Collect(Tcounters& total)
+  {
+    for (auto& shard : shards) {
+      total.Add(shard.counters);
+      shard.counters.Reset();
+    }
+  }
+  /// Function to reset all the shards
+  void Reset()
+  {
+    for (auto& shard : shards) {
+      shard.counters.Reset();
+    }
+  }
+
+ private:
+  /// Shards are aligned on cache lines, so that the threads do not write in the same line
+  struct alignas(64) AlignedCounters {
+    Tcounters counters;
+  };
+  std::vector<AlignedCounters> shards;
 };
 
 } // namespace o2::quality_control_modules::tof
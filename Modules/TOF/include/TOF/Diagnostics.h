@@ -47,6 +47,14 @@ struct EDRMCounter_t {
   static const TString names[size];
 };
 
+/// Indices of the DRM counters, the diagnostic bits start at kDRM_HEADER_MISSING
+enum EDRMCounter : UInt_t {
+  kDRM_HAS_DATA = 0,
+  kDRM_HEADER_MISSING = 4,
+  kDRM_MAXDIAGNOSTIC_BIT = 13
+};
+static_assert(kDRM_MAXDIAGNOSTIC_BIT + 1 == EDRMCounter_t::size, "DRM counter indices and names differ");
+
 /// TRM counters: there will only be ten instance of such counters per crate
 struct ETRMCounter_t {
   /// Number of TRM counters
@@ -55,6 +63,14 @@ struct ETRMCounter_t {
   static const TString names[size];
 };
 
+/// Indices of the TRM counters, the diagnostic bits start at kTRM_HEADER_MISSING
+enum ETRMCounter : UInt_t {
+  kTRM_HAS_DATA = 0,
+  kTRM_HEADER_MISSING = 4,
+  kTRM_MAXDIAGNOSTIC_BIT = 12
+};
+static_assert(kTRM_MAXDIAGNOSTIC_BIT + 1 == ETRMCounter_t::size, "TRM counter indices and names differ");
+
 /// TRMChain: counters there will be 20 instances of such counters per crate
 struct ETRMChainCounter_t {
   /// Number of TRMChain counters
@@ -73,24 +89,38 @@ class Diagnostics final
   : public DecoderBase
 {
  public:
+  static const int ncrates = 72;    /// Number of crates
+  static const int ntrms = 10;      /// Number of TRMs per crate
+  static const int ntrmschains = 2; /// Number of TRMChains per TRM
+
+  /// \brief Counters filled by the decoding
+  struct Counters {
+    Counter<ERDHCounter_t> mRDHCounter[ncrates];                               /// RDH Counters
+    Counter<EDRMCounter_t> mDRMCounter[ncrates];                               /// DRM Counters
+    Counter<ETRMCounter_t> mTRMCounter[ncrates][ntrms];                        /// TRM Counters
+    Counter<ETRMChainCounter_t> mTRMChainCounter[ncrates][ntrms][ntrmschains]; /// TRMChain Counters
+    uint32_t mInvalidSlot = 0;                                                 /// Diagnostics of a crate or slot out of range
+
+    /// Function to add the counts of other counters
+    void Add(const Counters& other);
+    /// Function to reset all the counters
+    void Reset();
+    /// Function to get how many counts did not fit in the counters, e.g. of unknown diagnostic bits
+    uint64_t HowManyOutOfRange() const;
+  };
+
   /// \brief Constructor
-  Diagnostics() = default;
+  /// \param counters Counters filled by the decoding, which must not be filled by other threads at the same time
+  explicit Diagnostics(Counters& counters) : mCounters(counters) {}
   /// Destructor
   ~Diagnostics() = default;
 
   /// Function to run decoding
   void decode();
 
-  /// Counters to fill
-  static const int ncrates = 72;                                             /// Number of crates
-  static const int ntrms = 10;                                               /// Number of TRMs per crate
-  static const int ntrmschains = 2;                                          /// Number of TRMChains per TRM
-  Counter<ERDHCounter_t> mRDHCounter[ncrates];                               /// RDH Counters
-  Counter<EDRMCounter_t> mDRMCounter[ncrates];                               /// DRM Counters
-  Counter<ETRMCounter_t> mTRMCounter[ncrates][ntrms];                        /// TRM Counters
-  Counter<ETRMChainCounter_t> mTRMChainCounter[ncrates][ntrms][ntrmschains]; /// TRMChain Counters
-
  private:
+  Counters& mCounters; //! Counters to fill, not streamed
+
   /** decoding handlers **/
   // void rdhHandler(const o2::header::RAWDataHeader* rdh) override;
   void headerHandler(const CrateHeader_t* crateHeader, const CrateOrbit_t* crateOrbit) override;
@@ -18,6 +18,9 @@
 
 #include "TH1.h"
 
+// QC includes
+#include "QualityControl/HistogramRegistry.h"
+
 // O2 includes
 #include "TOFReconstruction/DecoderBase.h"
 #include "DataFormatsTOF/CompressedDataFormat.h"
@@ -38,11 +41,16 @@ class TOFDecoderCompressed final : public DecoderBase
   /// Destructor
   ~TOFDecoderCompressed() = default;
 
-  /// Function to run decoding
+  /// Function to run decoding, the histograms are filled at the end of the decoding of the buffer.
+  /// Throws if initHistograms() was not called.
   void decode();
 
+  /// Looks up the handles of the histograms, to be called once they are all registered in mHistos.
+  /// Throws if one of them is missing.
+  void initHistograms();
+
   /// Histograms to fill
-  std::map<std::string, std::shared_ptr<TH1>> mHistos;
+  HistogramRegistry mHistos; //!
 
   Int_t rdhread = 0; /// Number of times a RDH is read
 
@@ -55,6 +63,16 @@ class TOFDecoderCompressed final : public DecoderBase
   void trailerHandler(const CrateHeader_t* crateHeader, const CrateOrbit_t* crateOrbit,
                       const CrateTrailer_t* crateTrailer, const Diagnostic_t* diagnostics,
                       const Error_t* errors) override;
+
+  using Handle = HistogramRegistry::Handle;
+  std::unique_ptr<HistogramRegistry::Buffer> mBuffer; //! Fills of the buffer being decoded
+  Handle mHits = HistogramRegistry::InvalidHandle;
+  Handle mTime = HistogramRegistry::InvalidHandle;
+  Handle mTimeBC = HistogramRegistry::InvalidHandle;
+  Handle mTOT = HistogramRegistry::InvalidHandle;
+  Handle mIndexE = HistogramRegistry::InvalidHandle;
+  Handle mSlotPartMask = HistogramRegistry::InvalidHandle;
+  Handle mDiagnostic = HistogramRegistry::InvalidHandle;
 };
 
 } // namespace o2::quality_control_modules::tof
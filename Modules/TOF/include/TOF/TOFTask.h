@@ -17,6 +17,10 @@
 #define QC_MODULE_TOF_TOFTASK_H
 
 #include "QualityControl/TaskInterface.h"
+#include "QualityControl/HistogramRegistry.h"
+
+#include <array>
+#include <memory>
 
 class TH1F;
 class TH2F;
@@ -58,6 +62,21 @@ class TOFTask final : public TaskInterface
   static const Int_t fgkFiredMacropadLimit; /// Limit on cut on number of fired macropad
 
  private:
+  /// Sides of the detector, in the order of the histograms: I/A, O/A, I/C, O/C
+  static constexpr Int_t NSides = 4;
+
+  /// All the histograms, reset together
+  HistogramRegistry mHistos;
+  /// Fills of the digits of a message, applied at once at the end of monitorData
+  std::unique_ptr<HistogramRegistry::Buffer> mBuffer;
+  HistogramRegistry::Handle mHandleRawsMulti = HistogramRegistry::InvalidHandle;
+  HistogramRegistry::Handle mHandleRawsTime = HistogramRegistry::InvalidHandle;
+  HistogramRegistry::Handle mHandleRawsToT = HistogramRegistry::InvalidHandle;
+  HistogramRegistry::Handle mHandleRawHitMap = HistogramRegistry::InvalidHandle;
+  std::array<HistogramRegistry::Handle, NSides> mHandleRawsMultiSide; /// Per side handles of mTOFRawsMultiIA, ...
+  std::array<HistogramRegistry::Handle, NSides> mHandleRawsTimeSide;  /// Per side handles of mTOFRawsTimeIA, ...
+  std::array<HistogramRegistry::Handle, NSides> mHandleRawsToTSide;   /// Per side handles of mTOFRawsToTIA, ...
+
   std::shared_ptr<TH1I> mTOFRawsMulti;   /// TOF raw hit multiplicity per event
   std::shared_ptr<TH1I> mTOFRawsMultiIA; /// TOF raw hit multiplicity per event - I/A side
   std::shared_ptr<TH1I> mTOFRawsMultiOA; /// TOF raw hit multiplicity per event - O/A side
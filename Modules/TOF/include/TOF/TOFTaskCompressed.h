@@ -25,6 +25,11 @@ class TH2F;
 class TH1I;
 class TH2I;
 
+namespace o2::quality_control::core
+{
+class SparseHistogram;
+}
+
 using namespace o2::quality_control::core;
 
 namespace o2::quality_control_modules::tof
@@ -50,14 +55,14 @@ class TOFTaskCompressed final : public TaskInterface
   void reset() override;
 
  private:
-  TOFDecoderCompressed mDecoder;         /// Decoder for TOF Compressed data useful for the Task
-  std::shared_ptr<TH1F> mHits;           /// Number of TOF hits
-  std::shared_ptr<TH1F> mTime;           /// Time
-  std::shared_ptr<TH1F> mTimeBC;         /// Time in Bunch Crossing
-  std::shared_ptr<TH1F> mTOT;            /// Time-Over-Threshold
-  std::shared_ptr<TH1F> mIndexE;         /// Index in electronic
-  std::shared_ptr<TH2F> mSlotPartMask;   /// Participating slot
-  std::shared_ptr<TH2F> mDiagnostic;     /// Diagnostic histogram
+  TOFDecoderCompressed mDecoder;            /// Decoder for TOF Compressed data useful for the Task
+  std::shared_ptr<TH1F> mHits;              /// Number of TOF hits
+  std::shared_ptr<SparseHistogram> mTime;   /// Time, 2^21 bins of which only a few are filled
+  std::shared_ptr<TH1F> mTimeBC;            /// Time in Bunch Crossing
+  std::shared_ptr<TH1F> mTOT;               /// Time-Over-Threshold
+  std::shared_ptr<SparseHistogram> mIndexE; /// Index in electronic
+  std::shared_ptr<TH2F> mSlotPartMask;      /// Participating slot
+  std::shared_ptr<TH2F> mDiagnostic;        /// Diagnostic histogram
 };
 
 } // namespace o2::quality_control_modules::tof
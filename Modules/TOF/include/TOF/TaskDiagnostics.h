@@ -20,8 +20,12 @@
 
 // QC includes
 #include "QualityControl/TaskInterface.h"
+#include "QualityControl/WorkerPool.h"
 #include "TOF/Diagnostics.h"
 
+#include <memory>
+#include <vector>
+
 class TH1F;
 class TH2F;
 
@@ -64,7 +68,10 @@ class TaskDiagnostics    /*final*/
   std::shared_ptr<TH1F> mTRMChainCounterHisto[Diagnostics::ncrates][Diagnostics::ntrms][Diagnostics::ntrmschains]; /// Words per TRM Chain
 #endif
 
-  Diagnostics mCounter; /// Decoder and counter for TOF Compressed data useful for the Task
+  CounterShards<Diagnostics::Counters> mShards;        /// Counters filled by each decoder
+  std::vector<std::unique_ptr<Diagnostics>> mDecoders; /// Decoders for TOF Compressed data, one per shard
+  std::unique_ptr<WorkerPool> mWorkers;                /// Threads running the decoders, if more than one
+  Diagnostics::Counters mCounters;                     /// Sum of the shards since the last reset
 };
 
 } // namespace o2::quality_control_modules::tof
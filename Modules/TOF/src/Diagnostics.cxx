@@ -73,6 +73,52 @@ const TString ETRMChainCounter_t::names[ETRMChainCounter_t::size] = {
   "counterB"
 };
 } // namespace counters
+
+void Diagnostics::Counters::Add(const Counters& other)
+{
+  for (Int_t i = 0; i < ncrates; i++) {
+    mRDHCounter[i].Add(other.mRDHCounter[i]);
+    mDRMCounter[i].Add(other.mDRMCounter[i]);
+    for (Int_t j = 0; j < ntrms; j++) {
+      mTRMCounter[i][j].Add(other.mTRMCounter[i][j]);
+      for (Int_t k = 0; k < ntrmschains; k++) {
+        mTRMChainCounter[i][j][k].Add(other.mTRMChainCounter[i][j][k]);
+      }
+    }
+  }
+  mInvalidSlot += other.mInvalidSlot;
+}
+
+void Diagnostics::Counters::Reset()
+{
+  for (Int_t i = 0; i < ncrates; i++) {
+    mRDHCounter[i].Reset();
+    mDRMCounter[i].Reset();
+    for (Int_t j = 0; j < ntrms; j++) {
+      mTRMCounter[i][j].Reset();
+      for (Int_t k = 0; k < ntrmschains; k++) {
+        mTRMChainCounter[i][j][k].Reset();
+      }
+    }
+  }
+  mInvalidSlot = 0;
+}
+
+uint64_t Diagnostics::Counters::HowManyOutOfRange() const
+{
+  uint64_t count = mInvalidSlot;
+  for (Int_t i = 0; i < ncrates; i++) {
+    count += mRDHCounter[i].HowManyOutOfRange() + mDRMCounter[i].HowManyOutOfRange();
+    for (Int_t j = 0; j < ntrms; j++) {
+      count += mTRMCounter[i][j].HowManyOutOfRange();
+      for (Int_t k = 0; k < ntrmschains; k++) {
+        count += mTRMChainCounter[i][j][k].HowManyOutOfRange();
+      }
+    }
+  }
+  return count;
+}
+
 void Diagnostics::decode()
 {
   DecoderBase::run();
@@ -80,12 +126,15 @@ void Diagnostics::decode()
 
 void Diagnostics::headerHandler(const CrateHeader_t* crateHeader, const CrateOrbit_t* /*crateOrbit*/)
 {
-  // mDRMCounter[crateHeader->drmID].Count(counters::kDRM_HAS_DATA);
-  mDRMCounter[crateHeader->drmID].Count(0);
+  const Int_t drmID = crateHeader->drmID;
+  if (drmID >= ncrates) {
+    mCounters.mInvalidSlot++;
+    return;
+  }
+  mCounters.mDRMCounter[drmID].Count(kDRM_HAS_DATA);
   for (Int_t i = 1; i < 11; i++) {
     if (crateHeader->slotPartMask & 1 << i) { // Magari includere l'LTM come i==0
-      // mTRMCounter[crateHeader->drmID][i - 1].Count(counters::kTRM_HAS_DATA);
-      mTRMCounter[crateHeader->drmID][i - 1].Count(0);
+      mCounters.mTRMCounter[drmID][i - 1].Count(kTRM_HAS_DATA);
     }
   }
 }
@@ -94,25 +143,31 @@ void Diagnostics::trailerHandler(const CrateHeader_t* crateHeader, const CrateOr
                                  const CrateTrailer_t* crateTrailer, const Diagnostic_t* diagnostics,
                                  const Error_t* /*errors*/)
 {
-  LOG(INFO) << "DECODING!!!" << ENDM;
-  Int_t drmID = crateHeader->drmID;
-  // mDRMCounter[drmID].Count(counters::kDRM_HAS_DATA);
+  const Int_t drmID = crateHeader->drmID;
+  if (drmID >= ncrates) {
+    mCounters.mInvalidSlot++;
+    return;
+  }
   for (int i = 0; i < crateTrailer->numberOfDiagnostics; ++i) {
     auto diagnostic = diagnostics + i;
     const Int_t slotID = diagnostic->slotID;
     if (slotID == 1) { // Here we have a DRM
       for (Int_t j = 0; j < 28; j++) {
         if (diagnostic->faultBits & 1 << j) {
-          mDRMCounter[drmID].Count(j + 4);
+          mCounters.mDRMCounter[drmID].Count(kDRM_HEADER_MISSING + j);
         }
       }
     } else if (slotID == 2) { // Here we have a LTM
 
     } else { // Here we have a TRM
       Int_t trmID = slotID - 3;
+      if (trmID < 0 || trmID >= ntrms) {
+        mCounters.mInvalidSlot++;
+        continue;
+      }
       for (Int_t j = 0; j < 28; j++) {
         if (diagnostic->faultBits & 1 << j) {
-          mTRMCounter[drmID][trmID].Count(j + 4);
+          mCounters.mTRMCounter[drmID][trmID].Count(kTRM_HEADER_MISSING + j);
         }
       }
     }
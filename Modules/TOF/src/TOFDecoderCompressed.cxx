@@ -18,8 +18,10 @@
 #include <Framework/DataRefUtils.h>
 #include "Headers/RAWDataHeader.h"
 #include "DetectorsRaw/HBFUtils.h"
+#include <Common/Exceptions.h>
 
 using namespace o2::framework;
+using namespace AliceO2::Common;
 
 // QC includes
 #include "QualityControl/QcInfoLogger.h"
@@ -32,14 +34,38 @@ namespace o2::quality_control_modules::tof
 
 void TOFDecoderCompressed::decode()
 {
+  if (!mBuffer) {
+    BOOST_THROW_EXCEPTION(FatalException() << errinfo_details("TOFDecoderCompressed::initHistograms() must be called before decoding"));
+  }
   DecoderBase::run();
+  mBuffer->flush();
+}
+
+void TOFDecoderCompressed::initHistograms()
+{
+  // the handlers fill the histograms without checking their handles
+  auto find = [this](const std::string& name) {
+    auto handle = mHistos.find(name);
+    if (handle == HistogramRegistry::InvalidHandle) {
+      BOOST_THROW_EXCEPTION(FatalException() << errinfo_details("The histogram " + name + " is not registered in the TOF decoder"));
+    }
+    return handle;
+  };
+  mHits = find("hHits");
+  mTime = find("hTime");
+  mTimeBC = find("hTimeBC");
+  mTOT = find("hTOT");
+  mIndexE = find("hIndexE");
+  mSlotPartMask = find("hSlotPartMask");
+  mDiagnostic = find("hDiagnostic");
+  mBuffer = std::make_unique<HistogramRegistry::Buffer>(mHistos);
 }
 
 void TOFDecoderCompressed::headerHandler(const CrateHeader_t* crateHeader, const CrateOrbit_t* /*crateOrbit*/)
 {
   for (int ibit = 0; ibit < 11; ++ibit) {
     if (crateHeader->slotPartMask & (1 << ibit)) {
-      mHistos.at("hSlotPartMask")->Fill(crateHeader->drmID, ibit + 2);
+      mBuffer->fill(mSlotPartMask, crateHeader->drmID, ibit + 2);
     }
   }
 }
@@ -47,7 +73,7 @@ void TOFDecoderCompressed::headerHandler(const CrateHeader_t* crateHeader, const
 void TOFDecoderCompressed::frameHandler(const CrateHeader_t* crateHeader, const CrateOrbit_t* /*crateOrbit*/,
                                         const FrameHeader_t* frameHeader, const PackedHit_t* packedHits)
 {
-  mHistos.at("hHits")->Fill(frameHeader->numberOfHits);
+  mBuffer->fill(mHits, frameHeader->numberOfHits);
   for (int i = 0; i < frameHeader->numberOfHits; ++i) {
     auto packedHit = packedHits + i;
     auto indexE = packedHit->channel +
@@ -59,10 +85,10 @@ void TOFDecoderCompressed::frameHandler(const CrateHeader_t* crateHeader, const
     int timebc = time % 1024;
     time += (frameHeader->frameID << 13);
 
-    mHistos.at("hIndexE")->Fill(indexE);
-    mHistos.at("hTime")->Fill(time);
-    mHistos.at("hTimeBC")->Fill(timebc);
-    mHistos.at("hTOT")->Fill(packedHit->tot);
+    mBuffer->fill(mIndexE, indexE);
+    mBuffer->fill(mTime, time);
+    mBuffer->fill(mTimeBC, timebc);
+    mBuffer->fill(mTOT, packedHit->tot);
   }
 }
 
@@ -72,7 +98,7 @@ void TOFDecoderCompressed::trailerHandler(const CrateHeader_t* crateHeader, cons
 {
   for (int i = 0; i < crateTrailer->numberOfDiagnostics; ++i) {
     auto diagnostic = diagnostics + i;
-    mHistos.at("hDiagnostic")->Fill(crateHeader->drmID, diagnostic->slotID);
+    mBuffer->fill(mDiagnostic, crateHeader->drmID, diagnostic->slotID);
   }
 }
 
@@ -24,11 +24,14 @@
 // O2 includes
 #include "TOFBase/Digit.h"
 #include "TOFBase/Geo.h"
+#include <Common/Exceptions.h>
 
 // QC includes
 #include "QualityControl/QcInfoLogger.h"
 #include "TOF/TOFTask.h"
 
+using namespace AliceO2::Common;
+
 namespace o2::quality_control_modules::tof
 {
 
@@ -231,44 +234,44 @@ void TOFTask::initialize(o2::framework::InitContext& /*ctx*/)
 
   mNfiredMacropad.reset(new TH1I("NfiredMacropad", "Number of fired TOF macropads per event; number of fired macropads; Events ", 50, 0, 50));
   getObjectsManager()->startPublishing(mNfiredMacropad.get());
+
+  // The histograms are registered to be reset together
+  for (TH1* histogram : std::initializer_list<TH1*>{
+         mTOFRawsMulti.get(), mTOFRawsMultiIA.get(), mTOFRawsMultiOA.get(), mTOFRawsMultiIC.get(), mTOFRawsMultiOC.get(),
+         mTOFRawsTime.get(), mTOFRawsTimeIA.get(), mTOFRawsTimeOA.get(), mTOFRawsTimeIC.get(), mTOFRawsTimeOC.get(),
+         mTOFRawsToT.get(), mTOFRawsToTIA.get(), mTOFRawsToTOA.get(), mTOFRawsToTIC.get(), mTOFRawsToTOC.get(),
+         mTOFRawsLTMHits.get(), mTOFrefMap.get(), mTOFRawHitMap.get(), mTOFDecodingErrors.get(), mTOFOrphansTime.get(),
+         mTOFRawTimeVsTRM035.get(), mTOFRawTimeVsTRM3671.get(), mTOFTimeVsStrip.get(), mTOFtimeVsBCID.get(),
+         mTOFchannelEfficiencyMap.get(), mTOFhitsCTTM.get(), mTOFmacropadCTTM.get(), mTOFmacropadDeltaPhiTime.get(),
+         mBXVsCttmBit.get(), mTimeVsCttmBit.get(), mTOFRawHitMap24.get(), mHitMultiVsDDL.get(), mNfiredMacropad.get() }) {
+    mHistos.add(histogram);
+  }
+
+  // Handles of the histograms filled for each digit, which are not checked in monitorData
+  auto find = [this](const std::string& name) {
+    auto handle = mHistos.find(name);
+    if (handle == HistogramRegistry::InvalidHandle) {
+      BOOST_THROW_EXCEPTION(FatalException() << errinfo_details("The histogram " + name + " is not registered in TOFTask"));
+    }
+    return handle;
+  };
+  mHandleRawsMulti = find("TOFRawsMulti");
+  mHandleRawsTime = find("TOFRawsTime");
+  mHandleRawsToT = find("TOFRawsToT");
+  mHandleRawHitMap = find("TOFRawHitMap");
+  const std::array<std::string, NSides> sides = { "IA", "OA", "IC", "OC" };
+  for (Int_t side = 0; side < NSides; side++) {
+    mHandleRawsMultiSide[side] = find("TOFRawsMulti" + sides[side]);
+    mHandleRawsTimeSide[side] = find("TOFRawsTime" + sides[side]);
+    mHandleRawsToTSide[side] = find("TOFRawsToT" + sides[side]);
+  }
+  mBuffer = std::make_unique<HistogramRegistry::Buffer>(mHistos);
 }
 
 void TOFTask::startOfActivity(Activity& /*activity*/)
 {
   ILOG(Info) << "startOfActivity" << ENDM;
-  mTOFRawsMulti->Reset();
-  mTOFRawsMultiIA->Reset();
-  mTOFRawsMultiOA->Reset();
-  mTOFRawsMultiIC->Reset();
-  mTOFRawsMultiOC->Reset();
-  mTOFRawsTime->Reset();
-  mTOFRawsTimeIA->Reset();
-  mTOFRawsTimeOA->Reset();
-  mTOFRawsTimeIC->Reset();
-  mTOFRawsTimeOC->Reset();
-  mTOFRawsToT->Reset();
-  mTOFRawsToTIA->Reset();
-  mTOFRawsToTOA->Reset();
-  mTOFRawsToTIC->Reset();
-  mTOFRawsToTOC->Reset();
-  mTOFRawsLTMHits->Reset();
-  mTOFrefMap->Reset();
-  mTOFRawHitMap->Reset();
-  mTOFDecodingErrors->Reset();
-  mTOFOrphansTime->Reset();
-  mTOFRawTimeVsTRM035->Reset();
-  mTOFRawTimeVsTRM3671->Reset();
-  mTOFTimeVsStrip->Reset();
-  mTOFtimeVsBCID->Reset();
-  mTOFchannelEfficiencyMap->Reset();
-  mTOFhitsCTTM->Reset();
-  mTOFmacropadCTTM->Reset();
-  mTOFmacropadDeltaPhiTime->Reset();
-  mBXVsCttmBit->Reset();
-  mTimeVsCttmBit->Reset();
-  mTOFRawHitMap24->Reset();
-  mHitMultiVsDDL->Reset();
-  mNfiredMacropad->Reset();
+  mHistos.reset();
 }
 
 void TOFTask::startOfCycle()
@@ -310,12 +313,12 @@ void TOFTask::monitorData(o2::framework::ProcessingContext& ctx)
   // eta is counted every half strip starting from strip 0.
   // Halves strips in side A 0-90, in side C 91-181
   const Int_t half_eta = 91;
-  Bool_t isSectorI = kFALSE;
-  Int_t ndigits[4] = { 0 }; // Number of digits per side I/A,O/A,I/C,O/C
+  Int_t side = 0;                // Side index, I/A,O/A,I/C,O/C
+  Int_t ndigits[NSides] = { 0 }; // Number of digits per side I/A,O/A,I/C,O/C
 
-  // Loop on readout windows
+  // Loop on readout windows, the fills are collected in mBuffer and applied to the histograms at the end
   for (const auto& row : rows) {
-    mTOFRawsMulti->Fill(row.size());                      // Number of digits inside a readout window
+    mBuffer->fill(mHandleRawsMulti, row.size());          // Number of digits inside a readout window
     auto digits_in_row = row.getBunchChannelData(digits); // Digits inside a readout window
     // Loop on digits
     for (auto const& digit : digits_in_row) {
@@ -324,47 +327,26 @@ void TOFTask::monitorData(o2::framework::ProcessingContext& ctx)
       // LOG(INFO) << "Filling digit #" << ndigits << " in sector #" << det[0] << " and strip #" << strip;
       Int_t ech = o2::tof::Geo::getECHFromCH(digit.getChannel());
       // mTOFRawHitMap->Fill(det[0], strip);
-      mTOFRawHitMap->Fill(Float_t(o2::tof::Geo::getCrateFromECH(ech)) / 4.f, strip);
+      mBuffer->fill(mHandleRawHitMap, Float_t(o2::tof::Geo::getCrateFromECH(ech)) / 4.f, strip);
       // TDC time and ToT time
       tdc_time = digit.getTDC() * o2::tof::Geo::TDCBIN * 0.001;
       tot_time = digit.getTOT() * o2::tof::Geo::TOTBIN_NS;
-      mTOFRawsTime->Fill(tdc_time);
-      mTOFRawsToT->Fill(tot_time);
+      mBuffer->fill(mHandleRawsTime, tdc_time);
+      mBuffer->fill(mHandleRawsToT, tot_time);
       digit.getPhiAndEtaIndex(phi, eta);
-      isSectorI = phi < phi_I1 || phi > phi_I2;
-      if (eta < half_eta) { // Sector A
-        if (isSectorI) {    // Sector I/A
-          mTOFRawsTimeIA->Fill(tdc_time);
-          mTOFRawsToTIA->Fill(tot_time);
-          ndigits[0]++;
-        } else { // Sector O/A
-          mTOFRawsTimeOA->Fill(tdc_time);
-          mTOFRawsToTOA->Fill(tot_time);
-          ndigits[1]++;
-        }
-      } else {           // Sector C
-        if (isSectorI) { // Sector I/C
-          mTOFRawsTimeIC->Fill(tdc_time);
-          mTOFRawsToTIC->Fill(tot_time);
-          ndigits[2]++;
-        } else { // Sector O/C
-          mTOFRawsTimeOC->Fill(tdc_time);
-          mTOFRawsToTOC->Fill(tot_time);
-          ndigits[3]++;
-        }
-      }
+      // Sector A or C, then sector I or O
+      side = (eta < half_eta ? 0 : 2) + (phi < phi_I1 || phi > phi_I2 ? 0 : 1);
+      mBuffer->fill(mHandleRawsTimeSide[side], tdc_time);
+      mBuffer->fill(mHandleRawsToTSide[side], tot_time);
+      ndigits[side]++;
     }
     // Filling histograms of hit multiplicity
-    mTOFRawsMultiIA->Fill(ndigits[0]);
-    mTOFRawsMultiOA->Fill(ndigits[1]);
-    mTOFRawsMultiIC->Fill(ndigits[2]);
-    mTOFRawsMultiOC->Fill(ndigits[3]);
-    //
-    ndigits[0] = 0;
-    ndigits[1] = 0;
-    ndigits[2] = 0;
-    ndigits[3] = 0;
+    for (side = 0; side < NSides; side++) {
+      mBuffer->fill(mHandleRawsMultiSide[side], ndigits[side]);
+      ndigits[side] = 0;
+    }
   }
+  mBuffer->flush();
 
   // LOG(INFO) << "Digits counted:::::::: " << ndigits << "stop";
 
@@ -425,39 +407,7 @@ void TOFTask::reset()
   // clean all the monitor objects here
 
   ILOG(Info) << "Resetting the histogram" << ENDM;
-  mTOFRawsMulti->Reset();
-  mTOFRawsMultiIA->Reset();
-  mTOFRawsMultiOA->Reset();
-  mTOFRawsMultiIC->Reset();
-  mTOFRawsMultiOC->Reset();
-  mTOFRawsTime->Reset();
-  mTOFRawsTimeIA->Reset();
-  mTOFRawsTimeOA->Reset();
-  mTOFRawsTimeIC->Reset();
-  mTOFRawsTimeOC->Reset();
-  mTOFRawsToT->Reset();
-  mTOFRawsToTIA->Reset();
-  mTOFRawsToTOA->Reset();
-  mTOFRawsToTIC->Reset();
-  mTOFRawsToTOC->Reset();
-  mTOFRawsLTMHits->Reset();
-  mTOFrefMap->Reset();
-  mTOFRawHitMap->Reset();
-  mTOFDecodingErrors->Reset();
-  mTOFOrphansTime->Reset();
-  mTOFRawTimeVsTRM035->Reset();
-  mTOFRawTimeVsTRM3671->Reset();
-  mTOFTimeVsStrip->Reset();
-  mTOFtimeVsBCID->Reset();
-  mTOFchannelEfficiencyMap->Reset();
-  mTOFhitsCTTM->Reset();
-  mTOFmacropadCTTM->Reset();
-  mTOFmacropadDeltaPhiTime->Reset();
-  mBXVsCttmBit->Reset();
-  mTimeVsCttmBit->Reset();
-  mTOFRawHitMap24->Reset();
-  mHitMultiVsDDL->Reset();
-  mNfiredMacropad->Reset();
+  mHistos.reset();
 }
 
 } // namespace o2::quality_control_modules::tof
@@ -27,6 +27,7 @@
 
 // QC includes
 #include "QualityControl/QcInfoLogger.h"
+#include "QualityControl/SparseHistogram.h"
 #include "TOF/TOFTaskCompressed.h"
 
 namespace o2::quality_control_modules::tof
@@ -61,32 +62,33 @@ void TOFTaskCompressed::initialize(o2::framework::InitContext& /*ctx*/)
 
   mHits.reset(new TH1F("hHits", "hHits;Number of hits", 1000, 0., 1000.));
   getObjectsManager()->startPublishing(mHits.get());
-  mDecoder.mHistos[mHits->GetName()] = mHits;
+  mDecoder.mHistos.add(mHits.get());
   //
-  mTime.reset(new TH1F("hTime", "hTime;time (24.4 ps)", 2097152, 0., 2097152.));
+  mTime.reset(new SparseHistogram("hTime", "hTime;time (24.4 ps)", 2097152, 0., 2097152.));
   getObjectsManager()->startPublishing(mTime.get());
-  mDecoder.mHistos[mTime->GetName()] = mTime;
+  mDecoder.mHistos.add(mTime.get());
   //
   mTimeBC.reset(new TH1F("hTimeBC", "hTimeBC;time (24.4 ps)", 1024, 0., 1024.));
   getObjectsManager()->startPublishing(mTimeBC.get());
-  mDecoder.mHistos[mTimeBC->GetName()] = mTimeBC;
+  mDecoder.mHistos.add(mTimeBC.get());
   //
   mTOT.reset(new TH1F("hTOT", "hTOT;ToT (48.8 ps)", 2048, 0., 2048.));
   getObjectsManager()->startPublishing(mTOT.get());
-  mDecoder.mHistos[mTOT->GetName()] = mTOT;
+  mDecoder.mHistos.add(mTOT.get());
   //
-  mIndexE.reset(new TH1F("hIndexE", "hIndexE;index EO", 172800, 0., 172800.));
+  mIndexE.reset(new SparseHistogram("hIndexE", "hIndexE;index EO", 172800, 0., 172800.));
   getObjectsManager()->startPublishing(mIndexE.get());
-  mDecoder.mHistos[mIndexE->GetName()] = mIndexE;
+  mDecoder.mHistos.add(mIndexE.get());
   //
   mSlotPartMask.reset(new TH2F("hSlotPartMask", "hSlotPartMask;crate;slot", 72, 0., 72., 12, 1., 13.));
   getObjectsManager()->startPublishing(mSlotPartMask.get());
-  mDecoder.mHistos[mSlotPartMask->GetName()] = mSlotPartMask;
+  mDecoder.mHistos.add(mSlotPartMask.get());
   //
   mDiagnostic.reset(new TH2F("hDiagnostic", "hDiagnostic;crate;slot", 72, 0., 72., 12, 1., 13.));
   getObjectsManager()->startPublishing(mDiagnostic.get());
-  mDecoder.mHistos[mDiagnostic->GetName()] = mDiagnostic;
+  mDecoder.mHistos.add(mDiagnostic.get());
   //
+  mDecoder.initHistograms();
 }
 
 void TOFTaskCompressed::startOfActivity(Activity& /*activity*/)
@@ -139,6 +141,7 @@ void TOFTaskCompressed::reset()
   ILOG(Info) << "Resetting the histogram" << ENDM;
   mHits->Reset();
   mTime->Reset();
+  mTimeBC->Reset();
   mTOT->Reset();
   mIndexE->Reset();
   mSlotPartMask->Reset();
@@ -25,25 +25,41 @@
 #include "QualityControl/QcInfoLogger.h"
 #include "TOF/TaskDiagnostics.h"
 
+#include <algorithm>
+#include <future>
+
 namespace o2::quality_control_modules::tof
 {
 
 void TaskDiagnostics::initialize(o2::framework::InitContext& /*ctx*/)
 {
   ILOG(Info) << "initialize TaskDiagnostics" << ENDM;
+  UInt_t threads = 1;
+  if (auto param = mCustomParameters.find("decodingThreads"); param != mCustomParameters.end()) {
+    threads = std::max(1, std::stoi(param->second));
+  }
+  // Each decoder counts in its own shard, the shards are summed at the end of the cycle
+  mShards = CounterShards<Diagnostics::Counters>(threads);
+  mDecoders.clear();
+  for (UInt_t i = 0; i < threads; i++) {
+    mDecoders.push_back(std::make_unique<Diagnostics>(mShards.Shard(i)));
+  }
+  mWorkers.reset(threads > 1 ? new WorkerPool(threads) : nullptr);
+  ILOG(Info) << "Decoding in " << threads << " thread(s)" << ENDM;
+
 #ifdef ENABLE_2D_HISTOGRAMS
   // WARNING X axis is reserved to the counter
   // WARNING! Here the histograms have to be larger than the counter size, otherwise in memory they will be badly handled with undefined behaviour. I.e. put more bins than necessary, they will be trimmed out later.
   mDRMCounterHisto.reset(new TH2F("DRMCounter", ";DRM Word;Crate;Words", 32, 0, 32, 72, 0, 72));
-  mCounter.mDRMCounter[0].MakeHistogram(mDRMCounterHisto.get());
+  mCounters.mDRMCounter[0].MakeHistogram(mDRMCounterHisto.get());
   getObjectsManager()->startPublishing(mDRMCounterHisto.get());
   for (Int_t j = 0; j < Diagnostics::ntrms; j++) {
     mTRMCounterHisto[j].reset(new TH2F(Form("TRMCounterSlot%i", j), ";TRM Word;Crate;Words", 32, 0, 32, 72, 0, 72));
-    mCounter.mTRMCounter[0][j].MakeHistogram(mTRMCounterHisto[j].get());
+    mCounters.mTRMCounter[0][j].MakeHistogram(mTRMCounterHisto[j].get());
     getObjectsManager()->startPublishing(mTRMCounterHisto[j].get());
     for (Int_t k = 0; k < Diagnostics::ntrmschains; k++) {
       mTRMChainCounterHisto[j][k].reset(new TH2F(Form("TRMChainCounterSlot%iChain%i", j, k), ";TRMChain Word;Crate;Words", 32, 0, 32, 72, 0, 72));
-      mCounter.mTRMChainCounter[0][j][k].MakeHistogram(mTRMChainCounterHisto[j][k].get());
+      mCounters.mTRMChainCounter[0][j][k].MakeHistogram(mTRMChainCounterHisto[j][k].get());
       getObjectsManager()->startPublishing(mTRMChainCounterHisto[j][k].get());
     }
   }
@@ -51,15 +67,15 @@ void TaskDiagnostics::initialize(o2::framework::InitContext& /*ctx*/)
   for (Int_t i = 0; i < Diagnostics::ncrates; i++) {
     // WARNING! Here the histograms have to be larger than the counter size, otherwise in memory they will be badly handled with undefined behaviour. I.e. put more bins than necessary, they will be trimmed out later.
     mDRMCounterHisto[i].reset(new TH1F(Form("DRMCounterCrate%i", i), ";DRM Word;Words", 32, 0, 32));
-    mCounter.mDRMCounter[i].MakeHistogram(mDRMCounterHisto[i].get());
+    mCounters.mDRMCounter[i].MakeHistogram(mDRMCounterHisto[i].get());
     getObjectsManager()->startPublishing(mDRMCounterHisto[i].get());
     for (Int_t j = 0; j < Diagnostics::ntrms; j++) {
       mTRMCounterHisto[i][j].reset(new TH1F(Form("TRMCounterCrate%iSlot%i", i, j), ";TRM Word;Words", 32, 0, 32));
-      mCounter.mTRMCounter[i][j].MakeHistogram(mTRMCounterHisto[i][j].get());
+      mCounters.mTRMCounter[i][j].MakeHistogram(mTRMCounterHisto[i][j].get());
       getObjectsManager()->startPublishing(mTRMCounterHisto[i][j].get());
       for (Int_t k = 0; k < Diagnostics::ntrmschains; k++) {
         mTRMChainCounterHisto[i][j][k].reset(new TH1F(Form("TRMChainCounterCrate%iSlot%iChain%i", i, j, k), ";TRMChain Word;Words", 32, 0, 32));
-        mCounter.mTRMChainCounter[i][j][k].MakeHistogram(mTRMChainCounterHisto[i][j][k].get());
+        mCounters.mTRMChainCounter[i][j][k].MakeHistogram(mTRMChainCounterHisto[i][j][k].get());
         getObjectsManager()->startPublishing(mTRMChainCounterHisto[i][j][k].get());
       }
     }
@@ -80,46 +96,73 @@ void TaskDiagnostics::startOfCycle()
 
 void TaskDiagnostics::monitorData(o2::framework::ProcessingContext& ctx)
 {
-  LOG(INFO) << "Monitoring in the TaskDiagnostics";
-
   /** receive input **/
+  std::vector<std::pair<const char*, size_t>> payloads;
   for (auto& input : ctx.inputs()) {
-    /** input **/
     const auto* headerIn = o2::framework::DataRefUtils::getHeader<o2::header::DataHeader*>(input);
-    auto payloadIn = input.payload;
-    auto payloadInSize = headerIn->payloadSize;
-    mCounter.setDecoderBuffer(payloadIn);
-    mCounter.setDecoderBufferSize(payloadInSize);
-    mCounter.decode();
+    payloads.emplace_back(input.payload, headerIn->payloadSize);
+  }
+
+  // The decoder d decodes the payloads d, d + number of decoders, ...
+  auto decodePayloads = [this, &payloads](size_t d) {
+    auto& decoder = *mDecoders[d];
+    for (size_t p = d; p < payloads.size(); p += mDecoders.size()) {
+      decoder.setDecoderBuffer(payloads[p].first);
+      decoder.setDecoderBufferSize(payloads[p].second);
+      decoder.decode();
+    }
+  };
+  if (!mWorkers) {
+    decodePayloads(0);
+    return;
+  }
+  std::vector<std::future<void>> results;
+  for (size_t d = 0; d < mDecoders.size(); d++) {
+    results.push_back(mWorkers->submit([&decodePayloads, d]() { decodePayloads(d); }));
+  }
+  // all the jobs must be finished before their exceptions are thrown
+  for (auto& result : results) {
+    result.wait();
+  }
+  for (auto& result : results) {
+    result.get();
+  }
+}
+
+void TaskDiagnostics::endOfCycle()
+{
+  ILOG(Info) << "endOfCycle" << ENDM;
+
+  const uint64_t outOfRange = mCounters.HowManyOutOfRange();
+  mShards.Collect(mCounters);
+  if (mCounters.HowManyOutOfRange() > outOfRange) {
+    ILOG(Warning) << mCounters.HowManyOutOfRange() - outOfRange
+                  << " diagnostics of unknown bits, crates or slots were not counted during the cycle" << ENDM;
   }
+
 #ifdef ENABLE_2D_HISTOGRAMS
   for (Int_t i = 0; i < Diagnostics::ncrates; i++) {
-    mCounter.mDRMCounter[i].FillHistogram(mDRMCounterHisto.get(), i + 1);
+    mCounters.mDRMCounter[i].FillHistogram(mDRMCounterHisto.get(), i + 1);
     for (Int_t j = 0; j < Diagnostics::ntrms; j++) {
-      mCounter.mTRMCounter[i][j].FillHistogram(mTRMCounterHisto[j].get(), i + 1);
+      mCounters.mTRMCounter[i][j].FillHistogram(mTRMCounterHisto[j].get(), i + 1);
       for (Int_t k = 0; k < Diagnostics::ntrmschains; k++) {
-        mCounter.mTRMChainCounter[i][j][k].FillHistogram(mTRMChainCounterHisto[j][k].get(), i + 1);
+        mCounters.mTRMChainCounter[i][j][k].FillHistogram(mTRMChainCounterHisto[j][k].get(), i + 1);
       }
     }
   }
 #else
   for (Int_t i = 0; i < Diagnostics::ncrates; i++) {
-    mCounter.mDRMCounter[i].FillHistogram(mDRMCounterHisto[i].get());
+    mCounters.mDRMCounter[i].FillHistogram(mDRMCounterHisto[i].get());
     for (Int_t j = 0; j < Diagnostics::ntrms; j++) {
-      mCounter.mTRMCounter[i][j].FillHistogram(mTRMCounterHisto[i][j].get());
+      mCounters.mTRMCounter[i][j].FillHistogram(mTRMCounterHisto[i][j].get());
       for (Int_t k = 0; k < Diagnostics::ntrmschains; k++) {
-        mCounter.mTRMChainCounter[i][j][k].FillHistogram(mTRMChainCounterHisto[i][j][k].get());
+        mCounters.mTRMChainCounter[i][j][k].FillHistogram(mTRMChainCounterHisto[i][j][k].get());
       }
     }
   }
 #endif
 }
 
-void TaskDiagnostics::endOfCycle()
-{
-  ILOG(Info) << "endOfCycle" << ENDM;
-}
-
 void TaskDiagnostics::endOfActivity(Activity& /*activity*/)
 {
   ILOG(Info) << "endOfActivity" << ENDM;
@@ -130,6 +173,8 @@ void TaskDiagnostics::reset()
   // clean all the monitor objects here
 
   ILOG(Info) << "Resetting the histogram" << ENDM;
+  mCounters.Reset();
+  mShards.Reset();
 #ifdef ENABLE_2D_HISTOGRAMS
   mDRMCounterHisto->Reset();
   for (Int_t j = 0; j < Diagnostics::ntrms; j++) {
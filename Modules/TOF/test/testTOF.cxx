@@ -14,6 +14,7 @@
 ///
 
 #include "QualityControl/TaskFactory.h"
+#include "Base/Counter.h"
 
 #define BOOST_TEST_MODULE Publisher test
 #define BOOST_TEST_MAIN
@@ -26,4 +27,51 @@ namespace o2::quality_control_modules::tof
 
 BOOST_AUTO_TEST_CASE(instantiate_task) { BOOST_CHECK(true); }
 
+struct ETestCounter_t {
+  static const UInt_t size = 3;
+  static const TString names[size];
+};
+const TString ETestCounter_t::names[ETestCounter_t::size] = { "first", "", "third" };
+
+BOOST_AUTO_TEST_CASE(counter)
+{
+  Counter<ETestCounter_t> counter;
+  counter.Count(0);
+  counter.Count(2);
+  counter.Count(2);
+  counter.Count(3);
+  counter.Count(100);
+  BOOST_CHECK_EQUAL(counter.HowMany(0), 1);
+  BOOST_CHECK_EQUAL(counter.HowMany(2), 2);
+  BOOST_CHECK_EQUAL(counter.HowManyOutOfRange(), 2);
+
+  Counter<ETestCounter_t> other;
+  other.Count(2);
+  counter.Add(other);
+  BOOST_CHECK_EQUAL(counter.HowMany(2), 3);
+
+  counter.Reset();
+  BOOST_CHECK_EQUAL(counter.HowMany(2), 0);
+  BOOST_CHECK_EQUAL(counter.HowManyOutOfRange(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(counter_shards)
+{
+  CounterShards<Counter<ETestCounter_t>> shards(2);
+  BOOST_CHECK_EQUAL(shards.Size(), 2);
+  shards.Shard(0).Count(1);
+  shards.Shard(1).Count(1);
+  shards.Shard(1).Count(5);
+
+  Counter<ETestCounter_t> total;
+  total.Count(1);
+  shards.Collect(total);
+  BOOST_CHECK_EQUAL(total.HowMany(1), 3);
+  BOOST_CHECK_EQUAL(total.HowManyOutOfRange(), 1);
+  // the shards are reset once collected
+  BOOST_CHECK_EQUAL(shards.Shard(1).HowMany(1), 0);
+  shards.Collect(total);
+  BOOST_CHECK_EQUAL(total.HowMany(1), 3);
+}
+
 } // namespace o2::quality_control_modules::tof